@@ -107,12 +107,14 @@
 #include "synthesiser/GenDb.h"
 #include "synthesiser/Synthesiser.h"
 
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <ctime>
 #include <filesystem>
+#include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <map>
@@ -174,7 +176,7 @@ namespace souffle {
 }
 
 /**
- * Compiles the given source file to a binary file.
+ * Compiles the given source files to a binary file.
  */
 void compileToBinary(
         Global& glb, const std::string& command, std::vector<fs::path>& sourceFilenames, fs::path binary) {
@@ -185,6 +187,9 @@ void compileToBinary(
     if (glb.config().has("swig")) {
         argv.push_back("-s");
         argv.push_back(glb.config().get("swig"));
+    } else if (glb.config().has("compile-cache")) {
+        argv.push_back("--cache");
+        argv.push_back(glb.config().get("compile-cache"));
     }
 
     if (glb.config().has("verbose")) {
@@ -210,6 +215,12 @@ void compileToBinary(
         argv.push_back(srcFile.string());
     }
 
+    // the translation units of --generate-many are compiled concurrently, one per hardware thread
+    if (sourceFilenames.size() > 1) {
+        argv.push_back("-j");
+        argv.push_back(std::to_string(std::max(1u, std::thread::hardware_concurrency())));
+    }
+
     argv.push_back("-o");
     argv.push_back(binary.string());
 
@@ -637,11 +648,15 @@ std::vector<MainOption> getMainOptions() {
     // clang-format off
   std::vector<MainOption> options{
       {"", 0, "", "", false, ""},
+      {"adaptive-join-order", nextOptChar++, "N", "", false,
+          "Re-plan join orders of recursive rules in the interpreter after <N> iterations."},
       {"auto-schedule", 'a', "FILE", "", false,
           "Use profile auto-schedule <FILE> for auto-scheduling."},
       {"compile", 'c', "", "", false,
           "Generate C++ source code, compile to a binary executable, then run this "
           "executable."},
+      {"compile-cache", nextOptChar++, "DIR", "", false,
+          "Reuse the objects compiled from identical C++ sources, which are kept in <DIR>."},
       {"compile-many", 'C', "", "", false,
           "Generate C++ source code in multiple files, compile to a binary executable, then "
           "run this "
@@ -670,8 +685,13 @@ std::vector<MainOption> getMainOptions() {
           "Display this help message."},
       {"include-dir", 'I', "DIR", ".", true,
           "Specify directory for include files."},
+      {"incremental", nextOptChar++, "", "", false,
+          "Generate a subroutine that updates all relations after inserting or erasing input tuples."},
       {"inline-exclude", nextOptChar++, "RELATIONS", "", false,
           "Prevent the given relations from being inlined. Overrides any `inline` qualifiers."},
+      {"insert-buffer", nextOptChar++, "N", "", false,
+          "Buffer up to <N> tuples per thread that parallel queries of the interpreter insert, and "
+          "merge them into their relations in bulk."},
       {"jobs", 'j', "N", "1", false,
           "Run interpreter/compiler in parallel using N threads, N=auto for system "
           "default."},
@@ -691,12 +711,17 @@ std::vector<MainOption> getMainOptions() {
       {"magic-transform-exclude", nextOptChar++, "RELATIONS", "", false,
           "Disable magic set transformation changes on the given relations. Overrides "
           "`magic-transform`. Implies `inline-exclude` for the given relations."},
+      {"memory-budget", nextOptChar++, "MB", "", false,
+          "Keep at most <MB> megabytes of tuples of the main relations in memory, spilling the others "
+          "to disk (interpreter only)."},
       {"no-preprocessor", nextOptChar++, "", "", false,
           "Do not use a C preprocessor."},
       {"no-warn", 'w', "", "", false,
           "Disable warnings."},
       {"output-dir", 'D', "DIR", ".", false,
           "Specify directory for output files. If <DIR> is `-` then stdout is used."},
+      {"parallel-strata", nextOptChar++, "", "", false,
+          "Evaluate independent strata concurrently when running with multiple threads."},
       {"parse-errors", nextOptChar++, "", "", false,
           "Show parsing errors, if any, then exit."},
       {"pragma", 'P', "OPTIONS", "", true,
@@ -725,6 +750,12 @@ std::vector<MainOption> getMainOptions() {
       {"swig", 's', "LANG", "", false,
           "Generate SWIG interface for given language. The values <LANG> accepts is java and "
           "python. "},
+      {"symbol-snapshot", nextOptChar++, "FILE", "", false,
+          "Load the symbols of the interpreter from <FILE> if it exists, and save them to <FILE> after "
+          "evaluation, so that symbols keep their numbers across runs."},
+      {"tiered-compilation", nextOptChar++, "N", "", false,
+          "Translate the expressions and conditions of loop queries in the interpreter to native code "
+          "once executed <N> times."},
       {"verbose", 'v', "", "", false,
           "Verbose output."},
       {"version", nextOptChar++, "", "", false,
@@ -805,6 +836,46 @@ int main(Global& glb, const char* souffle_executable) {
         }
 #endif
 
+        /* the warm-up of adaptive join orders must be a positive number of iterations */
+        if (glb.config().has("adaptive-join-order")) {
+            const std::string& warmup = glb.config().get("adaptive-join-order");
+            if (!isNumber(warmup.c_str()) || std::stoi(warmup) < 1) {
+                throw std::runtime_error(
+                        "--adaptive-join-order may only be set to an integer greater than 0.");
+            }
+        }
+
+        /* the memory budget is a positive number of megabytes */
+        if (glb.config().has("memory-budget")) {
+            const std::string& budget = glb.config().get("memory-budget");
+            if (!isNumber(budget.c_str()) || std::stoi(budget) < 1) {
+                throw std::runtime_error("--memory-budget may only be set to an integer greater than 0.");
+            }
+        }
+
+        /* the insert buffer must hold at least one tuple */
+        if (glb.config().has("insert-buffer")) {
+            const std::string& capacity = glb.config().get("insert-buffer");
+            if (!isNumber(capacity.c_str()) || std::stoi(capacity) < 1) {
+                throw std::runtime_error("--insert-buffer may only be set to an integer greater than 0.");
+            }
+        }
+
+        /* the threshold of tiered compilation must be a positive number of executions */
+        if (glb.config().has("tiered-compilation")) {
+            const std::string& threshold = glb.config().get("tiered-compilation");
+            if (!isNumber(threshold.c_str()) || std::stoi(threshold) < 1) {
+                throw std::runtime_error(
+                        "--tiered-compilation may only be set to an integer greater than 0.");
+            }
+        }
+
+        /* incremental updates rely on the semi-naive translation of positive programs */
+        if (glb.config().has("incremental") &&
+                (glb.config().has("provenance") || glb.config().has("magic-transform"))) {
+            throw std::runtime_error("--incremental cannot be combined with provenance or magic sets.");
+        }
+
         /* if an output directory is given, check it exists */
         if (glb.config().has("output-dir") && !glb.config().has("output-dir", "-") &&
                 !existDir(glb.config().get("output-dir")) &&
@@ -1062,6 +1133,10 @@ int main(Global& glb, const char* souffle_executable) {
     const bool must_execute = execute_mode;
     const bool must_compile = must_execute || compile_mode || glb.config().has("swig");
 
+    if (!must_interpret && glb.config().has("symbol-snapshot") && !glb.config().has("no-warn")) {
+        std::cerr << "\nSymbol snapshots are only supported by the interpreter.\n";
+    }
+
     try {
         if (must_interpret) {
             // ------- interpreter -------------
@@ -1090,12 +1165,20 @@ int main(Global& glb, const char* souffle_executable) {
                 baseFilename = tempFile();
             }
 
+            bool temporaryBase = !compile_mode && !generate_mode && !generate_many_mode;
             if (baseName(baseFilename) == "/" || baseName(baseFilename) == ".") {
                 baseFilename = tempFile();
+                temporaryBase = true;
             }
 
             std::string baseIdentifier = identifier(simpleName(baseFilename));
 
+            // builds in the compile cache must not depend on the names of temporary files
+            const bool useCompileCache = must_compile && glb.config().has("compile-cache") &&
+                                         !glb.config().has("swig");
+            const std::string programIdentifier =
+                    useCompileCache && temporaryBase ? std::string("souffle") : baseIdentifier;
+
             std::string binaryFilename = baseFilename;
 
             bool withSharedLibrary;
@@ -1105,7 +1188,7 @@ int main(Global& glb, const char* souffle_executable) {
                     glb.config().has("generate-many") || glb.config().has("compile-many");
 
             synthesiser::GenDb db;
-            synthesiser->generateCode(db, baseIdentifier, withSharedLibrary);
+            synthesiser->generateCode(db, programIdentifier, withSharedLibrary);
             std::vector<fs::path> srcFiles;
 
             if (emitToStdOut) {
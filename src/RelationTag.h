@@ -35,7 +35,10 @@ enum class RelationTag {
     BRIE,          // use brie data-structure
     BTREE,         // use btree data-structure
     BTREE_DELETE,  // use btree_delete data-structure
+    COMPRESSED,    // use btree data-structure with compressed leaves
+    DISK,          // use data-structure spilling to disk
     EQREL,         // use union data-structure
+    HASHSET,       // use hash-set data-structure
 };
 
 /** Space of qualifiers that a relation can have */
@@ -57,7 +60,10 @@ enum class RelationRepresentation {
     BRIE,          // use brie data-structure
     BTREE,         // use btree data-structure
     BTREE_DELETE,  // use btree_delete data-structure
+    COMPRESSED,    // use btree data-structure with compressed leaves
+    DISK,          // use data-structure spilling to disk
     EQREL,         // use union data-structure
+    HASHSET,       // use hash-set data-structure
     PROVENANCE,    // use custom btree data-structure with provenance extras
     INFO,          // info relation for provenance
 };
@@ -70,7 +76,10 @@ inline bool isRelationRepresentationTag(const RelationTag& tag) {
         case RelationTag::BRIE:
         case RelationTag::BTREE:
         case RelationTag::BTREE_DELETE:
-        case RelationTag::EQREL: return true;
+        case RelationTag::COMPRESSED:
+        case RelationTag::DISK:
+        case RelationTag::EQREL:
+        case RelationTag::HASHSET: return true;
         default: return false;
     }
 }
@@ -119,7 +128,10 @@ inline RelationRepresentation getRelationRepresentationFromTag(const RelationTag
         case RelationTag::BRIE: return RelationRepresentation::BRIE;
         case RelationTag::BTREE: return RelationRepresentation::BTREE;
         case RelationTag::BTREE_DELETE: return RelationRepresentation::BTREE_DELETE;
+        case RelationTag::COMPRESSED: return RelationRepresentation::COMPRESSED;
+        case RelationTag::DISK: return RelationRepresentation::DISK;
         case RelationTag::EQREL: return RelationRepresentation::EQREL;
+        case RelationTag::HASHSET: return RelationRepresentation::HASHSET;
         default: fatal("invalid relation tag");
     }
 
@@ -140,7 +152,10 @@ inline std::ostream& operator<<(std::ostream& os, RelationTag qualifier) {
         case RelationTag::BRIE: return os << "brie";
         case RelationTag::BTREE: return os << "btree";
         case RelationTag::BTREE_DELETE: return os << "btree_delete";
+        case RelationTag::COMPRESSED: return os << "compressed";
+        case RelationTag::DISK: return os << "disk";
         case RelationTag::EQREL: return os << "eqrel";
+        case RelationTag::HASHSET: return os << "hashset";
     }
 
     UNREACHABLE_BAD_CASE_ANALYSIS
@@ -166,8 +181,11 @@ inline std::ostream& operator<<(std::ostream& os, RelationRepresentation represe
     switch (representation) {
         case RelationRepresentation::BTREE: return os << "btree";
         case RelationRepresentation::BTREE_DELETE: return os << "btree_delete";
+        case RelationRepresentation::COMPRESSED: return os << "compressed";
+        case RelationRepresentation::DISK: return os << "disk";
         case RelationRepresentation::BRIE: return os << "brie";
         case RelationRepresentation::EQREL: return os << "eqrel";
+        case RelationRepresentation::HASHSET: return os << "hashset";
         case RelationRepresentation::PROVENANCE: return os << "provenance";
         case RelationRepresentation::INFO: return os << "info";
         case RelationRepresentation::DEFAULT: return os;
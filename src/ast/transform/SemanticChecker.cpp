@@ -130,6 +130,7 @@ private:
     void checkIO();
     void checkWitnessProblem();
     void checkInlining();
+    void checkIncremental();
 };
 
 bool SemanticChecker::transform(TranslationUnit& translationUnit) {
@@ -198,6 +199,9 @@ SemanticCheckerImpl::SemanticCheckerImpl(TranslationUnit& tu) : tu(tu) {
     checkIO();
     checkWitnessProblem();
     checkInlining();
+    if (tu.global().config().has("incremental")) {
+        checkIncremental();
+    }
 
     // Run grounded terms checker
     GroundedTermsChecker().verify(tu);
@@ -1153,4 +1157,55 @@ void SemanticCheckerImpl::checkNamespaces() {
     }
 }
 
+// Check that the program can be updated incrementally, i.e., it is positive
+// and all relations are B-trees from which tuples can be erased.
+void SemanticCheckerImpl::checkIncremental() {
+    for (const auto* rel : program.getRelations()) {
+        const std::string name = toString(rel->getQualifiedName());
+        switch (rel->getRepresentation()) {
+            case RelationRepresentation::DEFAULT:
+            case RelationRepresentation::BTREE:
+            case RelationRepresentation::BTREE_DELETE: break;
+            default:
+                report.addError("Relation " + name + " must be a btree for incremental evaluation",
+                        rel->getSrcLoc());
+        }
+        if (rel->getArity() == 0) {
+            report.addError(
+                    "Nullary relation " + name + " is not supported by incremental evaluation",
+                    rel->getSrcLoc());
+        }
+        if (!rel->getFunctionalDependencies().empty()) {
+            report.addError("Choice domain of relation " + name +
+                                    " is not supported by incremental evaluation",
+                    rel->getSrcLoc());
+        }
+        if (ioTypes.isLimitSize(rel) || rel->getIsDeltaDebug().has_value()) {
+            report.addError("Relation " + name + " cannot be limited or debugged in incremental evaluation",
+                    rel->getSrcLoc());
+        }
+    }
+
+    for (const auto* clause : program.getClauses()) {
+        if (isA<SubsumptiveClause>(clause)) {
+            report.addError("Subsumptive clauses are not supported by incremental evaluation",
+                    clause->getSrcLoc());
+        }
+        visit(*clause, [&](const Negation& negation) {
+            report.addError("Negation is not supported by incremental evaluation", negation.getSrcLoc());
+        });
+        visit(*clause, [&](const Aggregator& aggregator) {
+            report.addError(
+                    "Aggregation is not supported by incremental evaluation", aggregator.getSrcLoc());
+        });
+        visit(*clause, [&](const Counter& counter) {
+            report.addError("Counter is not supported by incremental evaluation", counter.getSrcLoc());
+        });
+        visit(*clause, [&](const IterationCounter& counter) {
+            report.addError(
+                    "Iteration counter is not supported by incremental evaluation", counter.getSrcLoc());
+        });
+    }
+}
+
 }  // namespace souffle::ast::transform
@@ -62,7 +62,31 @@ enum TranslationMode {
     SubsumeDeleteCurrentDelta,
 
     // delete delete-R(x0) :- R(x0), R(x1), x0!=x1, body. (outside fix-point)
-    SubsumeDeleteCurrentCurrent
+    SubsumeDeleteCurrentCurrent,
+
+    // Incremental evaluation
+    //
+    // Changes of the relations are propagated in the style of DRed:
+    // tuples that may lose their derivations are over-deleted into
+    // erase-R, rederived from the remaining tuples, and insertions
+    // are propagated semi-naively via insert-R. Relation R denotes
+    // the current state of a relation, A a relation of a lower
+    // stratum, and B the other body atoms.
+
+    // new-R :- erase-A, B, !erase-R. (over-deletion, outside fix-point)
+    IncrementalEraseLower,
+
+    // new-R :- delta-R, B, !erase-R. (over-deletion, inside fix-point)
+    IncrementalEraseDelta,
+
+    // delta-R :- B. (rederivation, restricted to erase-R)
+    IncrementalRederive,
+
+    // new-R :- insert-A, B, !R. (insertion, outside fix-point)
+    IncrementalInsertLower,
+
+    // new-R :- delta-R, B, !R. (insertion, inside fix-point)
+    IncrementalInsertDelta
 };
 
 /* Abstract Clause Translator */
@@ -461,6 +461,11 @@ Own<ram::Operation> ClauseTranslator::addNegatedDeltaAtom(
         Own<ram::Operation> op, const ast::Atom* atom) const {
     std::size_t arity = atom->getArity();
     std::string name = getDeltaRelationName(atom->getQualifiedName());
+    if (mode == IncrementalEraseLower) {
+        name = getEraseRelationName(atom->getQualifiedName());
+    } else if (mode == IncrementalInsertLower) {
+        name = getInsertRelationName(atom->getQualifiedName());
+    }
 
     if (arity == 0) {
         // for a nullary, negation is a simple emptiness check
@@ -482,6 +487,10 @@ Own<ram::Operation> ClauseTranslator::addNegatedAtom(
         Own<ram::Operation> op, const ast::Clause& /* clause */, const ast::Atom* atom) const {
     std::size_t arity = atom->getArity();
     std::string name = getConcreteRelationName(atom->getQualifiedName());
+    if (mode == IncrementalEraseLower || mode == IncrementalEraseDelta) {
+        // over-deleted tuples are only recorded once
+        name = getEraseRelationName(atom->getQualifiedName());
+    }
 
     if (arity == 0) {
         // for a nullary, negation is a simple emptiness check
@@ -665,8 +674,9 @@ std::vector<ast::Atom*> ClauseTranslator::getAtomOrdering(const ast::Clause& cla
     auto atoms = ast::getBodyLiterals<ast::Atom>(clause);
 
     // stick to the plan if we have one set
+    // (versions of incremental lower-stratum clauses do not correspond to the versions of a plan)
     auto* plan = clause.getExecutionPlan();
-    if (plan != nullptr) {
+    if (plan != nullptr && mode != IncrementalEraseLower && mode != IncrementalInsertLower) {
         auto orders = plan->getOrders();
         if (contains(orders, version)) {
             // get the imposed order, and change it to start at zero
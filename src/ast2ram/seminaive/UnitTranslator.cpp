@@ -60,9 +60,12 @@
 #include "ram/Swap.h"
 #include "ram/TranslationUnit.h"
 #include "ram/TupleElement.h"
+#include "ram/TupleOperation.h"
 #include "ram/UnsignedConstant.h"
 #include "ram/Variable.h"
+#include "ram/utility/NodeMapper.h"
 #include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
 #include "reports/DebugReport.h"
 #include "reports/ErrorReport.h"
 #include "souffle/BinaryConstraintOps.h"
@@ -167,6 +170,15 @@ Own<ram::Statement> UnitTranslator::generateStratum(std::size_t scc) const {
         appendStmt(current, generateLoadRelation(relation));
     }
 
+    // Keep the input facts apart from the tuples derived by the rules of the same relation
+    for (const auto& relation : context->getInputRelationsInSCC(scc)) {
+        if (keepsInputFacts(relation)) {
+            appendStmt(current,
+                    generateMergeRelations(relation, getInputFactRelationName(relation->getQualifiedName()),
+                            getConcreteRelationName(relation->getQualifiedName())));
+        }
+    }
+
     // Compute the current stratum
     const auto& sccRelations = context->getRelationsInSCC(scc);
     if (context->isRecursiveSCC(scc)) {
@@ -288,6 +300,21 @@ Own<ram::Statement> UnitTranslator::generateDebugRelation(const ast::Relation* r
     return stmt;
 }
 
+Own<ram::Statement> UnitTranslator::generateIntersectRelations(const ast::Relation* rel,
+        const std::string& destRelation, const std::string& srcRelation,
+        const std::string& filterRelation) const {
+    VecOwn<ram::Expression> values;
+    VecOwn<ram::Expression> values2;
+    for (std::size_t i = 0; i < rel->getArity(); i++) {
+        values.push_back(mk<ram::TupleElement>(0, i));
+        values2.push_back(mk<ram::TupleElement>(0, i));
+    }
+    auto insertion = mk<ram::Insert>(destRelation, std::move(values));
+    auto filtered = mk<ram::Filter>(
+            mk<ram::ExistenceCheck>(filterRelation, std::move(values2)), std::move(insertion));
+    return mk<ram::Query>(mk<ram::Scan>(srcRelation, 0, std::move(filtered)));
+}
+
 Own<ram::Statement> UnitTranslator::translateRecursiveClauses(
         const ast::RelationSet& scc, const ast::Relation* rel) const {
     assert(contains(scc, rel) && "relation should belong to scc");
@@ -685,6 +712,268 @@ Own<ram::Statement> UnitTranslator::generateStoreRelation(const ast::Relation* r
     return mk<ram::Sequence>(std::move(storeStmts));
 }
 
+Own<ram::Statement> UnitTranslator::generateIncrementalClauseVersions(
+        const ast::RelationSet& scc, const ast::Relation* rel, TranslationMode mode) const {
+    VecOwn<ram::Statement> code;
+    const bool fromLower = (mode == IncrementalEraseLower || mode == IncrementalInsertLower);
+    for (auto&& clause : context->getProgram()->getClauses(*rel)) {
+        // The changes are read from the relations of lower strata, or from the stratum itself
+        ast::RelationSet changed;
+        if (fromLower) {
+            for (const auto* atom : ast::getBodyLiterals<ast::Atom>(*clause)) {
+                const auto* bodyRel = context->getProgram()->getRelation(*atom);
+                if (!contains(scc, bodyRel)) {
+                    changed.insert(bodyRel);
+                }
+            }
+        } else {
+            changed = scc;
+        }
+
+        // One version per atom that may read a change
+        std::size_t numVersions = getSccAtoms(clause, changed).size();
+        for (std::size_t version = 0; version < numVersions; version++) {
+            appendStmt(code, context->translateRecursiveClause(*clause, changed, version, mode));
+        }
+    }
+    return mk<ram::Sequence>(std::move(code));
+}
+
+/**
+ * Input facts of relations with rules are kept in a store of their own, since
+ * an over-deleted input fact is rederived from that store rather than by a rule.
+ */
+bool UnitTranslator::keepsInputFacts(const ast::Relation* rel) const {
+    return glb->config().has("incremental") && !context->getLoadDirectives(rel->getQualifiedName()).empty() &&
+           !context->getProgram()->getClauses(*rel).empty();
+}
+
+Own<ram::Statement> UnitTranslator::generateRederiveClause(
+        const ast::Relation* rel, const ast::Clause& clause) const {
+    auto rule = context->translateNonRecursiveClause(clause, IncrementalRederive);
+    auto* query = as<ram::Query>(rule);
+    assert(query != nullptr && "clause should be translated to a query");
+
+    // Make room for the outermost scan over the over-deleted tuples
+    visit(*query, [](ram::TupleOperation& search) { search.setTupleId(search.getTupleId() + 1); });
+    query->apply(nodeMapper<ram::Node>([&](auto&& go, Own<ram::Node> node) -> Own<ram::Node> {
+        if (auto* element = as<ram::TupleElement>(node)) {
+            return mk<ram::TupleElement>(element->getTupleId() + 1, element->getElement());
+        }
+        node->apply(go);
+        return node;
+    }));
+
+    // Only derive the over-deleted tuples
+    query->apply(nodeMapper<ram::Node>([&](auto&& go, Own<ram::Node> node) -> Own<ram::Node> {
+        if (auto* insert = as<ram::Insert>(node)) {
+            VecOwn<ram::Condition> conditions;
+            const auto values = insert->getValues();
+            for (std::size_t i = 0; i < values.size(); i++) {
+                conditions.push_back(mk<ram::Constraint>(
+                        BinaryConstraintOp::EQ, mk<ram::TupleElement>(0, i), clone(values[i])));
+            }
+            return mk<ram::Filter>(ram::toCondition(conditions), clone(insert));
+        }
+        node->apply(go);
+        return node;
+    }));
+
+    std::string eraseRelation = getEraseRelationName(rel->getQualifiedName());
+    Own<ram::Statement> result =
+            mk<ram::Query>(mk<ram::Scan>(eraseRelation, 0, clone(query->getOperation())));
+
+    // Add debug info
+    std::ostringstream ds;
+    ds << toString(clause) << "\nin file ";
+    ds << clause.getSrcLoc();
+    return mk<ram::DebugInfo>(std::move(result), ds.str());
+}
+
+Own<ram::Statement> UnitTranslator::generateOverDeletion(std::size_t scc) const {
+    VecOwn<ram::Statement> code;
+    const auto& sccRelations = context->getRelationsInSCC(scc);
+
+    // Staged erasures of input relations are restricted to existing tuples
+    for (const ast::Relation* rel : context->getInputRelationsInSCC(scc)) {
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string eraseRelation = getEraseRelationName(rel->getQualifiedName());
+        appendStmt(code, generateIntersectRelations(rel, deltaRelation, eraseRelation, mainRelation));
+        appendStmt(code, mk<ram::Clear>(eraseRelation));
+        appendStmt(code, generateMergeRelations(rel, eraseRelation, deltaRelation));
+        if (keepsInputFacts(rel)) {
+            std::string inputRelation = getInputFactRelationName(rel->getQualifiedName());
+            appendStmt(code, generateEraseTuples(rel, inputRelation, eraseRelation));
+        }
+    }
+
+    // Over-delete all tuples with a derivation using an erased tuple of a lower stratum
+    for (const ast::Relation* rel : sccRelations) {
+        appendStmt(code, generateIncrementalClauseVersions(sccRelations, rel, IncrementalEraseLower));
+    }
+    for (const ast::Relation* rel : sccRelations) {
+        std::string newRelation = getNewRelationName(rel->getQualifiedName());
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string eraseRelation = getEraseRelationName(rel->getQualifiedName());
+        appendStmt(code, generateMergeRelations(rel, eraseRelation, newRelation));
+        appendStmt(code, generateMergeRelations(rel, deltaRelation, newRelation));
+        appendStmt(code, mk<ram::Clear>(newRelation));
+    }
+
+    // Propagate the over-deletions through the stratum
+    if (context->isRecursiveSCC(scc)) {
+        VecOwn<ram::Statement> loopBody;
+        VecOwn<ram::Condition> emptinessChecks;
+        VecOwn<ram::Statement> updateTable;
+        for (const ast::Relation* rel : sccRelations) {
+            std::string newRelation = getNewRelationName(rel->getQualifiedName());
+            std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+            std::string eraseRelation = getEraseRelationName(rel->getQualifiedName());
+            appendStmt(loopBody, generateIncrementalClauseVersions(sccRelations, rel, IncrementalEraseDelta));
+            emptinessChecks.push_back(mk<ram::EmptinessCheck>(newRelation));
+            appendStmt(updateTable, mk<ram::Sequence>(generateMergeRelations(rel, eraseRelation, newRelation),
+                                            mk<ram::Swap>(deltaRelation, newRelation),
+                                            mk<ram::Clear>(newRelation)));
+        }
+        appendStmt(code, mk<ram::Loop>(mk<ram::Sequence>(mk<ram::Sequence>(std::move(loopBody)),
+                                 mk<ram::Exit>(ram::toCondition(emptinessChecks)),
+                                 mk<ram::Sequence>(std::move(updateTable)))));
+    }
+
+    for (const ast::Relation* rel : sccRelations) {
+        appendStmt(code, mk<ram::Clear>(getDeltaRelationName(rel->getQualifiedName())));
+        appendStmt(code, mk<ram::Clear>(getNewRelationName(rel->getQualifiedName())));
+    }
+    return mk<ram::Sequence>(std::move(code));
+}
+
+Own<ram::Statement> UnitTranslator::generateRederivation(std::size_t scc) const {
+    VecOwn<ram::Statement> code;
+    const auto& sccRelations = context->getRelationsInSCC(scc);
+
+    // Rederive the over-deleted tuples that still have a derivation
+    for (const ast::Relation* rel : sccRelations) {
+        for (auto&& clause : context->getProgram()->getClauses(*rel)) {
+            appendStmt(code, generateRederiveClause(rel, *clause));
+        }
+    }
+
+    // Rederive the over-deleted tuples that are still input facts
+    for (const ast::Relation* rel : sccRelations) {
+        if (keepsInputFacts(rel)) {
+            appendStmt(code, generateIntersectRelations(rel, getDeltaRelationName(rel->getQualifiedName()),
+                                     getEraseRelationName(rel->getQualifiedName()),
+                                     getInputFactRelationName(rel->getQualifiedName())));
+        }
+    }
+
+    // Staged insertions of input relations are restricted to new tuples
+    for (const ast::Relation* rel : context->getInputRelationsInSCC(scc)) {
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string insertRelation = getInsertRelationName(rel->getQualifiedName());
+        if (keepsInputFacts(rel)) {
+            // an inserted fact remains an input fact, even if the rules derive it already
+            appendStmt(code, generateMergeRelations(
+                                     rel, getInputFactRelationName(rel->getQualifiedName()), insertRelation));
+        }
+        appendStmt(code, generateMergeRelationsWithFilter(rel, deltaRelation, insertRelation, mainRelation));
+        appendStmt(code, mk<ram::Clear>(insertRelation));
+    }
+
+    for (const ast::Relation* rel : sccRelations) {
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string insertRelation = getInsertRelationName(rel->getQualifiedName());
+        appendStmt(code, generateMergeRelations(rel, mainRelation, deltaRelation));
+        appendStmt(code, generateMergeRelations(rel, insertRelation, deltaRelation));
+    }
+
+    // Derive the tuples using an inserted tuple of a lower stratum
+    for (const ast::Relation* rel : sccRelations) {
+        appendStmt(code, generateIncrementalClauseVersions(sccRelations, rel, IncrementalInsertLower));
+    }
+    for (const ast::Relation* rel : sccRelations) {
+        std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+        std::string newRelation = getNewRelationName(rel->getQualifiedName());
+        std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+        std::string insertRelation = getInsertRelationName(rel->getQualifiedName());
+        appendStmt(code, generateMergeRelations(rel, mainRelation, newRelation));
+        appendStmt(code, generateMergeRelations(rel, insertRelation, newRelation));
+        appendStmt(code, generateMergeRelations(rel, deltaRelation, newRelation));
+        appendStmt(code, mk<ram::Clear>(newRelation));
+    }
+
+    // Propagate the insertions through the stratum
+    if (context->isRecursiveSCC(scc)) {
+        VecOwn<ram::Statement> loopBody;
+        VecOwn<ram::Condition> emptinessChecks;
+        VecOwn<ram::Statement> updateTable;
+        for (const ast::Relation* rel : sccRelations) {
+            std::string mainRelation = getConcreteRelationName(rel->getQualifiedName());
+            std::string newRelation = getNewRelationName(rel->getQualifiedName());
+            std::string deltaRelation = getDeltaRelationName(rel->getQualifiedName());
+            std::string insertRelation = getInsertRelationName(rel->getQualifiedName());
+            appendStmt(
+                    loopBody, generateIncrementalClauseVersions(sccRelations, rel, IncrementalInsertDelta));
+            emptinessChecks.push_back(mk<ram::EmptinessCheck>(newRelation));
+            appendStmt(updateTable, mk<ram::Sequence>(generateMergeRelations(rel, mainRelation, newRelation),
+                                            generateMergeRelations(rel, insertRelation, newRelation),
+                                            mk<ram::Swap>(deltaRelation, newRelation),
+                                            mk<ram::Clear>(newRelation)));
+        }
+        appendStmt(code, mk<ram::Loop>(mk<ram::Sequence>(mk<ram::Sequence>(std::move(loopBody)),
+                                 mk<ram::Exit>(ram::toCondition(emptinessChecks)),
+                                 mk<ram::Sequence>(std::move(updateTable)))));
+    }
+
+    for (const ast::Relation* rel : sccRelations) {
+        appendStmt(code, mk<ram::Clear>(getDeltaRelationName(rel->getQualifiedName())));
+        appendStmt(code, mk<ram::Clear>(getNewRelationName(rel->getQualifiedName())));
+    }
+    return mk<ram::Sequence>(std::move(code));
+}
+
+/**
+ * Generate the RAM code that propagates the staged insertions and erasures
+ * of the input relations in the style of DRed: all tuples that may lose a
+ * derivation are over-deleted stratum by stratum, removed at once, and then
+ * rederived together with the insertions stratum by stratum.
+ */
+Own<ram::Statement> UnitTranslator::generateIncrementalUpdate(
+        const std::vector<std::size_t>& sccOrdering) const {
+    VecOwn<ram::Statement> code;
+
+    // (1) compute the over-deleted tuples on the previous state
+    for (std::size_t scc : sccOrdering) {
+        appendStmt(code, generateOverDeletion(scc));
+    }
+
+    // (2) remove the over-deleted tuples
+    for (std::size_t scc : sccOrdering) {
+        for (const ast::Relation* rel : context->getRelationsInSCC(scc)) {
+            appendStmt(code, generateEraseTuples(rel, getConcreteRelationName(rel->getQualifiedName()),
+                                     getEraseRelationName(rel->getQualifiedName())));
+        }
+    }
+
+    // (3) rederive the over-deleted tuples and propagate the insertions
+    for (std::size_t scc : sccOrdering) {
+        appendStmt(code, generateRederivation(scc));
+    }
+
+    // (4) drop the changes
+    for (std::size_t scc : sccOrdering) {
+        for (const ast::Relation* rel : context->getRelationsInSCC(scc)) {
+            appendStmt(code, mk<ram::Clear>(getEraseRelationName(rel->getQualifiedName())));
+            appendStmt(code, mk<ram::Clear>(getInsertRelationName(rel->getQualifiedName())));
+        }
+    }
+
+    return mk<ram::Sequence>(std::move(code));
+}
+
 Own<ram::Relation> UnitTranslator::createRamRelation(
         const ast::Relation* baseRelation, std::string ramRelationName) const {
     auto arity = baseRelation->getArity();
@@ -693,6 +982,18 @@ Own<ram::Relation> UnitTranslator::createRamRelation(
         representation = RelationRepresentation::DEFAULT;
     }
 
+    // Incremental updates erase tuples from the main relations and the stores of input facts
+    if (glb->config().has("incremental") &&
+            (ramRelationName[0] != '@' || ramRelationName.rfind("@input_", 0) == 0)) {
+        representation = RelationRepresentation::BTREE_DELETE;
+    }
+
+    // Under a memory budget, the main relations spill to disk, while the temporary ones stay in memory
+    if (glb->config().has("memory-budget") && representation == RelationRepresentation::DEFAULT &&
+            ramRelationName[0] != '@' && arity > 0) {
+        representation = RelationRepresentation::DISK;
+    }
+
     std::vector<std::string> attributeNames;
     std::vector<std::string> attributeTypeQualifiers;
     for (const auto& attribute : baseRelation->getAttributes()) {
@@ -706,6 +1007,7 @@ Own<ram::Relation> UnitTranslator::createRamRelation(
 
 VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::size_t>& sccOrdering) const {
     VecOwn<ram::Relation> ramRelations;
+    const bool isIncremental = glb->config().has("incremental");
     for (const auto& scc : sccOrdering) {
         bool isRecursive = context->isRecursiveSCC(scc);
         for (const auto& rel : context->getRelationsInSCC(scc)) {
@@ -713,8 +1015,9 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
             std::string mainName = getConcreteRelationName(rel->getQualifiedName());
             ramRelations.push_back(createRamRelation(rel, mainName));
 
-            // Recursive relations also require @delta and @new variants, with the same signature
-            if (isRecursive) {
+            // Recursive relations (and all relations of incremental programs) also require @delta and @new
+            // variants, with the same signature
+            if (isRecursive || isIncremental) {
                 // Add delta relation
                 std::string deltaName = getDeltaRelationName(rel->getQualifiedName());
                 ramRelations.push_back(createRamRelation(rel, deltaName));
@@ -738,6 +1041,20 @@ VecOwn<ram::Relation> UnitTranslator::createRamRelations(const std::vector<std::
                 std::string toEraseName = getDeleteRelationName(rel->getQualifiedName());
                 ramRelations.push_back(createRamRelation(rel, toEraseName));
             }
+
+            // Incremental updates collect the inserted and erased tuples of each relation
+            if (isIncremental) {
+                std::string insertName = getInsertRelationName(rel->getQualifiedName());
+                ramRelations.push_back(createRamRelation(rel, insertName));
+
+                std::string eraseName = getEraseRelationName(rel->getQualifiedName());
+                ramRelations.push_back(createRamRelation(rel, eraseName));
+
+                if (keepsInputFacts(rel)) {
+                    std::string inputName = getInputFactRelationName(rel->getQualifiedName());
+                    ramRelations.push_back(createRamRelation(rel, inputName));
+                }
+            }
         }
     }
     return ramRelations;
@@ -757,9 +1074,11 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         // Generate the main stratum code
         auto stratum = generateStratum(sccOrdering.at(i));
 
-        // Clear expired relations
-        const auto& expiredRelations = context->getExpiredRelations(i);
-        stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
+        // Clear expired relations (incremental updates need all relations)
+        if (!glb->config().has("incremental")) {
+            const auto& expiredRelations = context->getExpiredRelations(i);
+            stratum = mk<ram::Sequence>(std::move(stratum), generateClearExpiredRelations(expiredRelations));
+        }
 
         // Add the subroutine
         const ast::Relation* rel = *context->getRelationsInSCC(sccOrdering.at(i)).begin();
@@ -771,6 +1090,11 @@ Own<ram::Sequence> UnitTranslator::generateProgram(const ast::TranslationUnit& t
         appendStmt(res, mk<ram::Call>("stratum_" + stratumID));
     }
 
+    // Add the subroutine for incremental updates; '@' avoids clashes with relation names
+    if (glb->config().has("incremental")) {
+        addRamSubroutine("@update", generateIncrementalUpdate(sccOrdering));
+    }
+
     // Add main timer if profiling
     if (!res.empty() && glb->config().has("profile")) {
         auto newStmt = mk<ram::LogTimer>(mk<ram::Sequence>(std::move(res)), LogStatement::runtime());
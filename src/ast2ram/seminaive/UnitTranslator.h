@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "ast2ram/ClauseTranslator.h"
 #include "ast2ram/UnitTranslator.h"
 #include "ram/Expression.h"
 #include "souffle/utility/ContainerUtil.h"
@@ -100,6 +101,18 @@ protected:
     virtual Own<ram::Statement> generateDebugRelation(const ast::Relation* rel,
             const std::string& destRelation, const std::string& srcRelation,
             Own<ram::Expression> iteration) const;
+    Own<ram::Statement> generateIntersectRelations(const ast::Relation* rel,
+            const std::string& destRelation, const std::string& srcRelation,
+            const std::string& filterRelation) const;
+
+    /** Incremental update translation */
+    Own<ram::Statement> generateIncrementalUpdate(const std::vector<std::size_t>& sccOrdering) const;
+    Own<ram::Statement> generateOverDeletion(std::size_t scc) const;
+    Own<ram::Statement> generateRederivation(std::size_t scc) const;
+    Own<ram::Statement> generateRederiveClause(const ast::Relation* rel, const ast::Clause& clause) const;
+    Own<ram::Statement> generateIncrementalClauseVersions(
+            const ast::RelationSet& scc, const ast::Relation* rel, TranslationMode mode) const;
+    bool keepsInputFacts(const ast::Relation* rel) const;
 
 private:
     std::map<std::string, Own<ram::Statement>> ramSubroutines;
@@ -522,7 +522,8 @@ std::vector<double> DeltaMaxBoundSips::evaluateCosts(const std::vector<Atom*> at
         if (arity == numBound) {
             // Always better than anything else
             cost.push_back(0.0);
-        } else if (isPrefix("@delta_", atomNames[i])) {
+        } else if (isPrefix("@delta_", atomNames[i]) || isPrefix("@erase_", atomNames[i]) ||
+                   isPrefix("@insert_", atomNames[i])) {
             // Better than any other atom that is not fully bounded
             cost.push_back(1.0);
         } else if (numBound == 0) {
@@ -76,6 +76,13 @@ std::string getAtomName(const ast::Clause& clause, const ast::Atom* atom,
         return getConcreteRelationName(atom->getQualifiedName());
     }
 
+    if (mode == IncrementalRederive) {
+        if (clause.getHead() == atom) {
+            return getDeltaRelationName(atom->getQualifiedName());
+        }
+        return getConcreteRelationName(atom->getQualifiedName());
+    }
+
     if (!isRecursive) {
         return getConcreteRelationName(atom->getQualifiedName());
     }
@@ -83,7 +90,11 @@ std::string getAtomName(const ast::Clause& clause, const ast::Atom* atom,
         return getNewRelationName(atom->getQualifiedName());
     }
     if (sccAtoms.at(version) == atom) {
-        return getDeltaRelationName(atom->getQualifiedName());
+        switch (mode) {
+            case IncrementalEraseLower: return getEraseRelationName(atom->getQualifiedName());
+            case IncrementalInsertLower: return getInsertRelationName(atom->getQualifiedName());
+            default: return getDeltaRelationName(atom->getQualifiedName());
+        }
     }
     return getConcreteRelationName(atom->getQualifiedName());
 }
@@ -108,6 +119,18 @@ std::string getDeleteRelationName(const ast::QualifiedName& name) {
     return getConcreteRelationName(name, "@delete_");
 }
 
+std::string getInsertRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@insert_");
+}
+
+std::string getEraseRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@erase_");
+}
+
+std::string getInputFactRelationName(const ast::QualifiedName& name) {
+    return getConcreteRelationName(name, "@input_");
+}
+
 std::string getRelationName(const ast::QualifiedName& name) {
     return toString(join(name.getQualifiers(), "."));
 }
@@ -60,6 +60,15 @@ std::string getRejectRelationName(const ast::QualifiedName& name);
 /** Get the corresponding RAM 'delete' relation name for the relation */
 std::string getDeleteRelationName(const ast::QualifiedName& name);
 
+/** Get the corresponding RAM 'insert' relation name for the relation */
+std::string getInsertRelationName(const ast::QualifiedName& name);
+
+/** Get the corresponding RAM 'erase' relation name for the relation */
+std::string getEraseRelationName(const ast::QualifiedName& name);
+
+/** Get the corresponding RAM 'input' relation name, storing the input facts of the relation */
+std::string getInputFactRelationName(const ast::QualifiedName& name);
+
 /** Get base relation name, strip off any possible prefix */
 std::string getBaseRelationName(const ast::QualifiedName& name);
 
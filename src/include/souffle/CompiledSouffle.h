@@ -33,6 +33,7 @@
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/WriteStream.h"
 #include "souffle/utility/EvaluatorUtil.h"
+#include "souffle/utility/RegexUtil.h"
 
 #if defined(_OPENMP)
 #include <omp.h>
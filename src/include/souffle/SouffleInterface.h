@@ -930,6 +930,39 @@ public:
         fatal("unknown subroutine");
     }
 
+    /**
+     * Update all relations after changing input relations (requires a program generated with --incremental)
+     *
+     * The tuples staged in the relations returned by getInsertions() and getErasures()
+     * are inserted into resp. erased from their input relations, and the changes are
+     * propagated to all derived relations. The staging relations are empty afterwards.
+     */
+    void update() {
+        std::vector<RamDomain> args;
+        std::vector<RamDomain> ret;
+        executeSubroutine("@update", args, ret);
+    }
+
+    /**
+     * Get the relation staging insertions into an input relation for the next update().
+     *
+     * @param name The name of the input relation (const std::string)
+     * @return The staging relation, or null pointer if the program is not incremental (Relation*)
+     */
+    Relation* getInsertions(const std::string& name) const {
+        return getRelation("@insert_" + name);
+    }
+
+    /**
+     * Get the relation staging erasures from an input relation for the next update().
+     *
+     * @param name The name of the input relation (const std::string)
+     * @return The staging relation, or null pointer if the program is not incremental (Relation*)
+     */
+    Relation* getErasures(const std::string& name) const {
+        return getRelation("@erase_" + name);
+    }
+
     /**
      * Get the symbol table of the program.
      */
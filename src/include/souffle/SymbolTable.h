@@ -17,9 +17,12 @@
 #pragma once
 
 #include "souffle/RamTypes.h"
+#include "souffle/utility/span.h"
 
+#include <cassert>
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace souffle {
 
@@ -111,6 +114,18 @@ public:
     /** @brief Decode a symbol index to a symbol. */
     virtual const std::string& decode(const RamDomain index) const = 0;
 
+    /**
+     * @brief Encode a batch of symbols, such as the symbols of an input file.
+     *
+     * The index of symbols[i] is stored in indices[i].
+     */
+    virtual void encode(span<const std::string_view> symbols, span<RamDomain> indices) {
+        assert(symbols.size() == indices.size());
+        for (std::size_t i = 0; i < symbols.size(); ++i) {
+            indices[i] = encode(std::string(symbols[i]));
+        }
+    }
+
     /** @brief Encode a symbol to a symbol index; aliases encode. */
     virtual RamDomain unsafeEncode(const std::string& symbol) = 0;
 
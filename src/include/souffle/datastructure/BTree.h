@@ -1903,8 +1903,8 @@ public:
             return R();
         }
 
-        // resolve tree recursively
-        auto root = buildSubTree(a, b - 1);
+        // build tree bottom-up
+        auto root = buildTree(a, static_cast<size_type>(b - a));
 
         // find leftmost node
         node* leftmost = root;
@@ -1916,6 +1916,40 @@ public:
         return R(b - a, root, static_cast<leaf_node*>(leftmost));
     }
 
+    /**
+     * Inserts a batch of keys in arbitrary order, e.g. the tuples of a loaded
+     * relation. The batch is sorted (and, for sets, deduplicated) in place. An
+     * empty tree is built from the batch with full nodes in linear time;
+     * otherwise the keys are inserted in order into the existing nodes, so
+     * iterators and operation hints on this tree remain as valid as after a
+     * sequence of single insertions.
+     *
+     * Must not be executed concurrently with any other operation on this tree.
+     */
+    void bulkInsert(std::vector<Key>& keys) {
+        std::sort(keys.begin(), keys.end(), [&](const Key& a, const Key& b) { return less(a, b); });
+        if (isSet) {
+            auto keyEqual = [&](const Key& a, const Key& b) { return equal(a, b); };
+            keys.erase(std::unique(keys.begin(), keys.end(), keyEqual), keys.end());
+        }
+
+        if (keys.empty()) {
+            return;
+        }
+
+        if (!empty()) {
+            insert(keys.begin(), keys.end());
+            return;
+        }
+
+        root = buildTree(keys.begin(), keys.size());
+        node* newLeftmost = root;
+        while (!newLeftmost->isLeaf()) {
+            newLeftmost = newLeftmost->getChild(0);
+        }
+        leftmost = static_cast<leaf_node*>(newLeftmost);
+    }
+
 protected:
     /**
      * Determines whether the range covered by the given node is also
@@ -1955,60 +1989,83 @@ private:
         return !node->isEmpty() && !less(k, node->keys[0]) && less(k, node->keys[node->numElements - 1]);
     }
 
-    // Utility function for the load operation above.
-    template <typename Iter>
-    static node* buildSubTree(const Iter& a, const Iter& b) {
-        const int N = node::maxKeys;
+    /**
+     * Determines the maximal number of keys of a sub-tree of the given height.
+     */
+    static size_type capacity(size_type height) {
+        size_type res = node::maxKeys;
+        for (size_type i = 1; i < height; ++i) {
+            res = node::maxKeys + (node::maxKeys + 1) * res;
+        }
+        return res;
+    }
 
-        // divide range in N+1 sub-ranges
-        int64_t length = (b - a) + 1;
+    // Utility function for the bulk-load operations above.
+    template <typename Iter>
+    static node* buildTree(const Iter& a, size_type length) {
+        // use the least height covering all keys
+        size_type height = 1;
+        while (capacity(height) < length) {
+            ++height;
+        }
+        return buildSubTree(a, length, height);
+    }
 
-        // terminal case: length is less then maxKeys
-        if (length <= N) {
-            // create a leaf node
+    /**
+     * Builds a sub-tree of the given height from the given ordered range.
+     *
+     * All children of a node but the last two are completely filled, and the
+     * last two share the remaining keys. Hence, apart from the right-most path,
+     * all nodes are full and all nodes are at least half-full.
+     */
+    template <typename Iter>
+    static node* buildSubTree(const Iter& a, size_type length, size_type height) {
+        // terminal case: create a leaf node
+        if (height == 1) {
+            assert(length <= node::maxKeys);
             node* res = new leaf_node();
             res->numElements = length;
-
-            for (int i = 0; i < length; ++i) {
+            for (size_type i = 0; i < length; ++i) {
                 res->keys[i] = a[i];
             }
-
             return res;
         }
 
-        // recursive case - compute step size
-        int numKeys = N;
-        int64_t step = ((length - numKeys) / (numKeys + 1));
+        // the least number of children covering the range
+        const size_type childCapacity = capacity(height - 1);
+        const size_type numChildren = (length + childCapacity + 1) / (childCapacity + 1);
+        assert(2 <= numChildren && numChildren <= node::maxKeys + 1);
 
-        while (numKeys > 1 && (step < N / 2)) {
-            numKeys--;
-            step = ((length - numKeys) / (numKeys + 1));
-        }
+        // the keys for the last two children
+        const size_type rest = length - (numChildren - 1) - (numChildren - 2) * childCapacity;
 
         // create inner node
         node* res = new inner_node();
-        res->numElements = numKeys;
+        res->numElements = numChildren - 1;
 
         Iter c = a;
-        for (int i = 0; i < numKeys; i++) {
-            // get dividing key
-            res->keys[i] = c[step];
+        for (size_type i = 0; i < numChildren; ++i) {
+            size_type childLength = childCapacity;
+            if (i == numChildren - 2) {
+                childLength = rest - rest / 2;
+            } else if (i == numChildren - 1) {
+                childLength = rest / 2;
+            }
 
             // get sub-tree
-            auto child = buildSubTree(c, c + (step - 1));
+            auto child = buildSubTree(c, childLength, height - 1);
             child->parent = res;
-            child->position = i;
+            child->position = static_cast<field_index_type>(i);
             res->getChildren()[i] = child;
+            c = c + childLength;
 
-            c = c + (step + 1);
+            // get dividing key
+            if (i + 1 < numChildren) {
+                res->keys[i] = *c;
+                c = c + 1;
+            }
         }
 
-        // and the remaining part
-        auto child = buildSubTree(c, b);
-        child->parent = res;
-        child->position = numKeys;
-        res->getChildren()[numKeys] = child;
-
         // done
         return res;
     }
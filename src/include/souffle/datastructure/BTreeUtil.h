@@ -16,7 +16,18 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <tuple>
+#include <type_traits>
+#include <utility>
+
+// the vector instructions are compiled for x86-64 hosts and selected at runtime
+#if defined(__x86_64__) && defined(__GNUC__)
+#define SOUFFLE_SIMD_SEARCH_X86
+#include <immintrin.h>
+#endif
 
 namespace souffle {
 
@@ -46,6 +57,14 @@ struct comparator {
     }
 };
 
+/**
+ * The column by which a comparator orders array keys first, comparing the
+ * values of the column by their less-than, or -1 if not known. Comparators
+ * specialize it to enable searches over the leading column of many keys at once.
+ */
+template <typename Comp>
+struct leading_column : std::integral_constant<int, -1> {};
+
 // ---------- search strategies --------------
 
 /**
@@ -188,6 +207,171 @@ struct binary_search : public search_strategy {
     }
 };
 
+/**
+ * Tests whether the host supports AVX2, by which many keys are compared at
+ * once. It is probed once per program; a search during static initialisation,
+ * before the host is probed, compares the keys one at a time.
+ */
+inline bool probe_avx2() {
+#ifdef SOUFFLE_SIMD_SEARCH_X86
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+inline const bool host_avx2 = probe_avx2();
+
+#ifdef SOUFFLE_SIMD_SEARCH_X86
+/**
+ * Counts the values of a column of the given keys of N columns which are
+ * less and greater than x, 8 keys at a time, and returns the number of keys
+ * counted.
+ */
+__attribute__((target("avx2"))) inline std::size_t count_column_avx2(const std::int32_t* column,
+        std::size_t n, std::size_t N, std::int32_t x, std::size_t& less, std::size_t& greater) {
+    const __m256i stride = _mm256_mullo_epi32(
+            _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32(static_cast<int>(N)));
+    const __m256i value = _mm256_set1_epi32(x);
+    // comparisons yield -1 for each key that satisfies them
+    __m256i lessCount = _mm256_setzero_si256();
+    __m256i greaterCount = _mm256_setzero_si256();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256i keys = _mm256_i32gather_epi32(column + i * N, stride, 4);
+        lessCount = _mm256_sub_epi32(lessCount, _mm256_cmpgt_epi32(value, keys));
+        greaterCount = _mm256_sub_epi32(greaterCount, _mm256_cmpgt_epi32(keys, value));
+    }
+    alignas(32) std::int32_t lanes[16];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), lessCount);
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes + 8), greaterCount);
+    for (std::size_t j = 0; j < 8; ++j) {
+        less += lanes[j];
+        greater += lanes[j + 8];
+    }
+    return i;
+}
+#endif
+
+/**
+ * Counts the values of a column of the given keys of N columns which are
+ * less and greater than x, with AVX2 if requested and one key at a time
+ * otherwise. AVX2 must only be requested if the host supports it.
+ */
+inline void count_column(bool avx2, const std::int32_t* column, std::size_t n, std::size_t N,
+        std::int32_t x, std::size_t& less, std::size_t& greater) {
+    std::size_t i = 0;
+#ifdef SOUFFLE_SIMD_SEARCH_X86
+    if (avx2) {
+        i = count_column_avx2(column, n, N, x, less, greater);
+    }
+#else
+    (void)avx2;
+#endif
+    for (; i < n; ++i) {
+        const std::int32_t key = column[i * N];
+        less += key < x;
+        greater += key > x;
+    }
+}
+
+/**
+ * A search strategy for keys that are arrays of 32-bit signed integers,
+ * ordered by a comparator with a known leading column. It narrows the range
+ * down to the keys whose leading column equals the one of the searched key,
+ * comparing the leading columns of 8 keys at once with AVX2 where the host
+ * supports it, and searches the rest by binary search. All other keys are
+ * searched by binary search.
+ */
+struct simd_search : public search_strategy {
+    /**
+     * Required user-defined default constructor.
+     */
+    simd_search() = default;
+
+    /**
+     * Obtains an iterator pointing to some element within the given
+     * range that is equal to the given key, if available. If no such
+     * element is present, a reference to the first element not less than
+     * the given key will be returned.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter operator()(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (applicable<Key, Iter, Comp>()) {
+            return lower_bound(k, a, b, comp);
+        } else {
+            return binary_search()(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * is not less than the given key.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter lower_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (applicable<Key, Iter, Comp>()) {
+            const auto [lo, hi] = narrow<leading_column<std::remove_cv_t<Comp>>::value>(k, a, b);
+            return binary_search().lower_bound(k, lo, hi, comp);
+        } else {
+            return binary_search().lower_bound(k, a, b, comp);
+        }
+    }
+
+    /**
+     * Obtains a reference to the first element in the given range that
+     * such that the given key is less than the referenced element.
+     */
+    template <typename Key, typename Iter, typename Comp>
+    Iter upper_bound(const Key& k, Iter a, Iter b, Comp& comp) const {
+        if constexpr (applicable<Key, Iter, Comp>()) {
+            const auto [lo, hi] = narrow<leading_column<std::remove_cv_t<Comp>>::value>(k, a, b);
+            return binary_search().upper_bound(k, lo, hi, comp);
+        } else {
+            return binary_search().upper_bound(k, a, b, comp);
+        }
+    }
+
+private:
+    template <typename Key>
+    struct int32_array : std::false_type {};
+
+    template <std::size_t N>
+    struct int32_array<std::array<std::int32_t, N>> : std::true_type {};
+
+    /** Tests whether keys are searched by their leading column */
+    template <typename Key, typename Iter, typename Comp>
+    static constexpr bool applicable() {
+        if constexpr (std::is_pointer_v<Iter>) {
+            return leading_column<std::remove_cv_t<Comp>>::value >= 0 && int32_array<Key>::value &&
+                   std::is_same_v<std::remove_cv_t<std::remove_pointer_t<Iter>>, Key>;
+        } else {
+            return false;
+        }
+    }
+
+    /**
+     * Obtains the range of keys whose column C equals the one of the given key.
+     * Since the keys are ordered by column C first, the keys before the range
+     * are less than the given key, and the keys after it are greater.
+     */
+    template <int C, typename Key, typename Iter>
+    static std::pair<Iter, Iter> narrow(const Key& k, Iter a, Iter b) {
+        constexpr std::size_t N = std::tuple_size<Key>::value;
+        static_assert(sizeof(Key) == N * sizeof(std::int32_t), "keys must be stored without padding");
+        const std::int32_t* column = reinterpret_cast<const std::int32_t*>(a) + C;
+        const std::size_t n = b - a;
+        const std::int32_t x = k[C];
+
+        // a key may be modified by a concurrent writer, but no key is both less and greater
+        std::size_t less = 0;
+        std::size_t greater = 0;
+        count_column(host_avx2, column, n, N, x, less, greater);
+        return {a + less, b - greater};
+    }
+};
+
 // ---------- search strategies selection --------------
 
 /**
@@ -201,6 +385,7 @@ struct strategy_selection {
 
 struct linear : public strategy_selection<linear_search> {};
 struct binary : public strategy_selection<binary_search> {};
+struct simd : public strategy_selection<simd_search> {};
 
 // by default every key utilizes binary search
 template <typename Key>
@@ -212,6 +397,12 @@ struct default_strategy<int> : public linear {};
 template <typename... Ts>
 struct default_strategy<std::tuple<Ts...>> : public linear {};
 
+#ifdef USE_SIMD_SEARCH
+// arrays of integers are searched by their leading column, if their comparator declares it
+template <std::size_t N>
+struct default_strategy<std::array<std::int32_t, N>> : public simd {};
+#endif
+
 /**
  * The default non-updater
  */
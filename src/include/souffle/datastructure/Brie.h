@@ -207,7 +207,7 @@ struct SparseArrayIter {
         int level = 1;
 
         // get current index on this level
-        x = SparseArray::getIndex(brie_element_type(value.first), level);
+        x = SparseArray::getIndex(value.first, level);
         x++;
 
         while (level > 0 && node) {
@@ -233,7 +233,7 @@ struct SparseArrayIter {
                 level++;
 
                 // get current index on this level
-                x = SparseArray::getIndex(brie_element_type(value.first), level);
+                x = SparseArray::getIndex(value.first, level);
                 x++;  // go one step further
             }
         }
@@ -838,7 +838,7 @@ private:
         unsigned level = info.levels;
         while (level != 0) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(i), level);
+            auto x = getIndex(i, level);
 
             // decrease level counter
             --level;
@@ -955,7 +955,7 @@ public:
         unsigned level = unsynced.levels;
         while (level != 0) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(i), level);
+            auto x = getIndex(i, level);
 
             // decrease level counter
             --level;
@@ -1046,7 +1046,7 @@ public:
         Node** node = &unsynced.root;
         while (level > other.unsynced.levels) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(other.unsynced.offset), level);
+            auto x = getIndex(other.unsynced.offset, level);
 
             // decrease level counter
             --level;
@@ -1201,7 +1201,7 @@ public:
         unsigned level = unsynced.levels;
         while (true) {
             // get X coordinate
-            auto x = getIndex(brie_element_type(i), level);
+            auto x = getIndex(i, level);
 
             // check next node
             Node* next = node->cell[x].ptr;
@@ -1408,7 +1408,7 @@ private:
         node->parent = nullptr;
 
         // insert existing root as child
-        auto x = getIndex(brie_element_type(unsynced.offset), unsynced.levels + 1);
+        auto x = getIndex(unsynced.offset, unsynced.levels + 1);
         node->cell[x].ptr = unsynced.root;
 
         // swap the root
@@ -1435,7 +1435,7 @@ private:
         newRoot->parent = nullptr;
 
         // insert existing root as child
-        auto x = getIndex(brie_element_type(info.offset), info.levels + 1);
+        auto x = getIndex(info.offset, info.levels + 1);
         newRoot->cell[x].ptr = info.root;
 
         // exchange the root in the info struct
@@ -1479,7 +1479,7 @@ private:
      * Obtains the index within the arrays of cells of a given index on a given
      * level of the internally maintained tree.
      */
-    static index_type getIndex(brie_element_type a, unsigned level) {
+    static index_type getIndex(index_type a, unsigned level) {
         return (a & (INDEX_MASK << (level * BIT_PER_STEP))) >> (level * BIT_PER_STEP);
     }
 
@@ -2046,6 +2046,23 @@ public:
         store.addAll(other.store);
     }
 
+    /**
+     * Inserts a batch of tuples in arbitrary order, e.g. the tuples of a loaded
+     * relation. The batch is sorted and deduplicated in place, such that the
+     * insertions proceed along the order of the trie and the paths cached in
+     * the operation context are reused by consecutive tuples.
+     *
+     * @param entries the tuples to be inserted into this trie
+     */
+    void bulkInsert(std::vector<entry_type>& entries) {
+        std::sort(entries.begin(), entries.end());
+        entries.erase(std::unique(entries.begin(), entries.end()), entries.end());
+        op_context ctxt;
+        for (const auto& entry : entries) {
+            impl().insert(const_entry_span_type(entry), ctxt);
+        }
+    }
+
     /**
      * Provides protected access to the internally maintained store.
      */
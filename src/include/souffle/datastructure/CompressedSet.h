@@ -0,0 +1,533 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file CompressedSet.h
+ *
+ * A set of integer tuples whose sorted content is stored in compressed
+ * leaves. Within a leaf, each tuple is encoded relative to its predecessor:
+ * the length of the prefix they share, the difference of the first column
+ * that differs, and the remaining columns as variable-length integers.
+ * Tuples are decoded on the fly while iterating.
+ *
+ * Insertions go to an uncompressed B-tree first, which is merged into the
+ * leaves once it holds an eighth of the compressed tuples. Only the leaves
+ * that receive new tuples are re-encoded.
+ *
+ * Multiple insert operations can be conducted concurrently, and so can
+ * lookups. Merging into the leaves happens during insertions, unless it is
+ * disabled for a set that is read while it is modified.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/BTree.h"
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A set of tuples of signed integers, ordered lexicographically.
+ *
+ * @tparam Key .. an array of signed integers
+ */
+template <typename Key>
+class CompressedSet {
+    using element_type = typename Key::value_type;
+    using unsigned_type = std::make_unsigned_t<element_type>;
+    using fresh_type = btree_set<Key, detail::comparator<Key>>;
+
+    static constexpr std::size_t Arity = std::tuple_size<Key>::value;
+    static_assert(Arity > 0, "nullary tuples are not compressed");
+    static_assert(std::is_integral_v<element_type> && std::is_signed_v<element_type>,
+            "only tuples of signed integers are compressed");
+
+public:
+    /** The maximal number of tuples in a leaf */
+    static constexpr std::size_t LeafSize = 128;
+
+    /** The number of uncompressed tuples that is always tolerated */
+    static constexpr std::size_t MinUncompressed = std::size_t(1) << 16;
+
+    /** Hints of a thread, which remember its last accesses of the uncompressed tuples */
+    struct operation_hints {
+        typename fresh_type::operation_hints fresh;
+        std::size_t epoch = 0;
+    };
+
+private:
+    /** A leaf, storing its first tuple as it is and the others encoded */
+    struct Leaf {
+        Key first;
+        std::size_t count;
+        std::vector<std::uint8_t> bytes;
+    };
+
+    /** A position within the leaves */
+    struct Cursor {
+        std::size_t leaf = 0;
+        std::size_t index = 0;
+        std::size_t offset = 0;
+        Key key{};
+    };
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+
+        iterator(const CompressedSet* set, Cursor cursor, typename fresh_type::iterator fresh,
+                typename fresh_type::iterator freshEnd)
+                : set(set), cursor(std::move(cursor)), fresh(std::move(fresh)),
+                  freshEnd(std::move(freshEnd)) {
+            select();
+        }
+
+        const Key& operator*() const {
+            return inLeaves ? cursor.key : *fresh;
+        }
+
+        const Key* operator->() const {
+            return &**this;
+        }
+
+        iterator& operator++() {
+            if (inLeaves) {
+                set->advance(cursor);
+            } else {
+                ++fresh;
+            }
+            select();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto res = *this;
+            ++(*this);
+            return res;
+        }
+
+        bool operator==(const iterator& other) const {
+            return cursor.leaf == other.cursor.leaf && cursor.index == other.cursor.index &&
+                   fresh == other.fresh;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        /** Determines whether the next tuple is the one of the leaves or the uncompressed one */
+        void select() {
+            const bool leafValid = cursor.leaf < set->leaves.size();
+            inLeaves = leafValid && (fresh == freshEnd || cursor.key < *fresh);
+        }
+
+        const CompressedSet* set = nullptr;
+        Cursor cursor;
+        typename fresh_type::iterator fresh;
+        typename fresh_type::iterator freshEnd;
+        bool inLeaves = false;
+    };
+
+    using const_iterator = iterator;
+    using chunk = range<iterator>;
+
+    CompressedSet() : pending(std::make_unique<LaneCount[]>(lanes.lanes())) {}
+    CompressedSet(const CompressedSet&) = delete;
+    CompressedSet& operator=(const CompressedSet&) = delete;
+
+    /**
+     * Enables or disables merging uncompressed tuples into the leaves during
+     * insertions. It must be disabled while the set is read and modified at the
+     * same time, since merging moves tuples under the feet of the readers.
+     */
+    void setCompaction(bool enable) {
+        compaction = enable;
+    }
+
+    bool insert(const Key& k) {
+        operation_hints hints;
+        return insert(k, hints);
+    }
+
+    bool insert(const Key& k, operation_hints& hints) {
+        const auto lane = lanes.threadLane();
+        auto guard = lanes.guard();
+        if (containsCompressed(k) || !fresh.insert(k, freshHints(hints))) {
+            return false;
+        }
+        // the counts of the lanes are published in batches, to keep the shared counter cold;
+        // a lane's count is only written by its owner, but read by size() at any time
+        auto& count = pending[lane].count;
+        const std::size_t local = count.load(std::memory_order_relaxed) + 1;
+        if (local < PublishBatch) {
+            count.store(local, std::memory_order_relaxed);
+            return true;
+        }
+        const std::size_t total = freshCount.fetch_add(local, std::memory_order_relaxed) + local;
+        count.store(0, std::memory_order_relaxed);
+        if (compaction && total >= compactionThreshold()) {
+            tryCompact();
+        }
+        return true;
+    }
+
+    /**
+     * Inserts a batch of tuples, merging them into the leaves right away.
+     * This operation is not thread-safe.
+     */
+    void bulkInsert(std::vector<Key>& keys) {
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+        compact();
+        merge(keys);
+    }
+
+    /**
+     * Merges all uncompressed tuples into the leaves.
+     * This operation is not thread-safe.
+     */
+    void compact() {
+        if (!fresh.empty()) {
+            std::vector<Key> keys(fresh.begin(), fresh.end());
+            fresh.clear();
+            merge(keys);
+        }
+        freshCount.store(0, std::memory_order_relaxed);
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            pending[lane].count.store(0, std::memory_order_relaxed);
+        }
+        // hints of other threads may still refer to the nodes of the cleared B-tree
+        ++epoch;
+    }
+
+    bool contains(const Key& k) const {
+        return containsCompressed(k) || fresh.contains(k);
+    }
+
+    bool contains(const Key& k, operation_hints& hints) const {
+        return containsCompressed(k) || fresh.contains(k, freshHints(hints));
+    }
+
+    iterator begin() const {
+        return iterator(this, cursorAt(0), fresh.begin(), fresh.end());
+    }
+
+    iterator end() const {
+        return iterator(this, cursorAt(leaves.size()), fresh.end(), fresh.end());
+    }
+
+    iterator lower_bound(const Key& k) const {
+        return iterator(this, seek(k, false), fresh.lower_bound(k), fresh.end());
+    }
+
+    iterator lower_bound(const Key& k, operation_hints& hints) const {
+        return iterator(this, seek(k, false), fresh.lower_bound(k, freshHints(hints)), fresh.end());
+    }
+
+    iterator upper_bound(const Key& k) const {
+        return iterator(this, seek(k, true), fresh.upper_bound(k), fresh.end());
+    }
+
+    iterator upper_bound(const Key& k, operation_hints& hints) const {
+        return iterator(this, seek(k, true), fresh.upper_bound(k, freshHints(hints)), fresh.end());
+    }
+
+    /**
+     * Splits the set into roughly the given number of ranges, at the first
+     * tuples of leaves, or of B-tree chunks while there are no leaves.
+     */
+    std::vector<chunk> partition(std::size_t num) const {
+        std::vector<Key> bounds;
+        if (leaves.size() > 1) {
+            std::size_t last = 0;
+            for (std::size_t p = 1; p < num; ++p) {
+                const std::size_t leaf = p * leaves.size() / num;
+                if (leaf != last) {
+                    bounds.push_back(leaves[leaf].first);
+                    last = leaf;
+                }
+            }
+        } else {
+            for (const auto& cur : fresh.partition(num)) {
+                if (cur.begin() != fresh.begin() && cur.begin() != fresh.end()) {
+                    bounds.push_back(*cur.begin());
+                }
+            }
+        }
+
+        std::vector<chunk> res;
+        iterator cur = begin();
+        for (const auto& bound : bounds) {
+            iterator next = lower_bound(bound);
+            res.push_back({cur, next});
+            cur = next;
+        }
+        res.push_back({cur, end()});
+        return res;
+    }
+
+    bool empty() const {
+        return leaves.empty() && fresh.empty();
+    }
+
+    std::size_t size() const {
+        std::size_t res = compressedCount + freshCount.load(std::memory_order_relaxed);
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            res += pending[lane].count.load(std::memory_order_relaxed);
+        }
+        return res;
+    }
+
+    void clear() {
+        std::vector<Leaf>().swap(leaves);
+        compressedCount = 0;
+        fresh.clear();
+        compact();
+    }
+
+    /** The number of bytes of the encoded tuples */
+    std::size_t getCompressedBytes() const {
+        std::size_t res = 0;
+        for (const auto& leaf : leaves) {
+            res += sizeof(Leaf) + leaf.bytes.size();
+        }
+        return res;
+    }
+
+private:
+    /** The number of insertions of a lane that are published at once */
+    static constexpr std::size_t PublishBatch = 256;
+
+    struct LaneCount {
+        alignas(hardware_destructive_interference_size) std::atomic<std::size_t> count{0};
+    };
+
+    // -- encoding --
+
+    static void writeVarint(std::vector<std::uint8_t>& out, unsigned_type value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value) | 0x80);
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+    static const std::uint8_t* readVarint(const std::uint8_t* in, unsigned_type& value) {
+        value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            const std::uint8_t byte = *in++;
+            value |= static_cast<unsigned_type>(byte & 0x7f) << shift;
+            if (byte < 0x80) {
+                return in;
+            }
+        }
+    }
+
+    static unsigned_type zigzag(element_type value) {
+        return (static_cast<unsigned_type>(value) << 1) ^
+               static_cast<unsigned_type>(value >> (sizeof(element_type) * 8 - 1));
+    }
+
+    static element_type unzigzag(unsigned_type value) {
+        return static_cast<element_type>((value >> 1) ^ (~(value & 1) + 1));
+    }
+
+    /** Appends the encoding of a tuple relative to its predecessor */
+    static void encode(const Key& prev, const Key& cur, std::vector<std::uint8_t>& out) {
+        std::size_t column = 0;
+        while (column + 1 < Arity && prev[column] == cur[column]) {
+            ++column;
+        }
+        out.push_back(static_cast<std::uint8_t>(column));
+        // the first differing column grows, the difference is thus a small positive number
+        writeVarint(out, static_cast<unsigned_type>(cur[column]) - static_cast<unsigned_type>(prev[column]));
+        for (std::size_t i = column + 1; i < Arity; ++i) {
+            writeVarint(out, zigzag(cur[i]));
+        }
+    }
+
+    /** Decodes the successor of the given tuple in place */
+    static const std::uint8_t* decode(const std::uint8_t* in, Key& cur) {
+        const std::size_t column = *in++;
+        unsigned_type value;
+        in = readVarint(in, value);
+        cur[column] = static_cast<element_type>(static_cast<unsigned_type>(cur[column]) + value);
+        for (std::size_t i = column + 1; i < Arity; ++i) {
+            in = readVarint(in, value);
+            cur[i] = unzigzag(value);
+        }
+        return in;
+    }
+
+    static Leaf encodeLeaf(const Key* first, const Key* last) {
+        std::vector<std::uint8_t> bytes;
+        for (const Key* cur = first + 1; cur != last; ++cur) {
+            encode(*(cur - 1), *cur, bytes);
+        }
+        return {*first, static_cast<std::size_t>(last - first), {bytes.begin(), bytes.end()}};
+    }
+
+    static void decodeLeaf(const Leaf& leaf, std::vector<Key>& out) {
+        Key cur = leaf.first;
+        out.push_back(cur);
+        const std::uint8_t* in = leaf.bytes.data();
+        for (std::size_t i = 1; i < leaf.count; ++i) {
+            in = decode(in, cur);
+            out.push_back(cur);
+        }
+    }
+
+    /** Appends leaves of evenly distributed tuples */
+    static void appendLeaves(std::vector<Leaf>& out, const std::vector<Key>& keys) {
+        const std::size_t n = keys.size();
+        const std::size_t count = (n + LeafSize - 1) / LeafSize;
+        for (std::size_t i = 0; i < count; ++i) {
+            out.push_back(encodeLeaf(keys.data() + i * n / count, keys.data() + (i + 1) * n / count));
+        }
+    }
+
+    /** Merges sorted and unique tuples into the leaves */
+    void merge(const std::vector<Key>& keys) {
+        if (keys.empty()) {
+            return;
+        }
+        if (leaves.empty()) {
+            appendLeaves(leaves, keys);
+            compressedCount = keys.size();
+            return;
+        }
+
+        std::vector<Leaf> res;
+        res.reserve(leaves.size() + keys.size() / LeafSize + 1);
+        std::vector<Key> content;
+        std::vector<Key> merged;
+        auto next = keys.begin();
+        for (std::size_t i = 0; i < leaves.size(); ++i) {
+            // the first leaf also takes the smaller tuples, and the last one the larger tuples
+            auto last = (i + 1 < leaves.size()) ? std::lower_bound(next, keys.end(), leaves[i + 1].first)
+                                                : keys.end();
+            if (next == last) {
+                res.push_back(std::move(leaves[i]));
+                continue;
+            }
+            content.clear();
+            merged.clear();
+            decodeLeaf(leaves[i], content);
+            std::set_union(content.begin(), content.end(), next, last, std::back_inserter(merged));
+            compressedCount += merged.size() - content.size();
+            appendLeaves(res, merged);
+            next = last;
+        }
+        leaves.swap(res);
+    }
+
+    // -- navigation --
+
+    Cursor cursorAt(std::size_t leaf) const {
+        Cursor res;
+        res.leaf = leaf;
+        if (leaf < leaves.size()) {
+            res.key = leaves[leaf].first;
+        }
+        return res;
+    }
+
+    void advance(Cursor& cursor) const {
+        const Leaf& leaf = leaves[cursor.leaf];
+        if (++cursor.index == leaf.count) {
+            cursor = cursorAt(cursor.leaf + 1);
+            return;
+        }
+        cursor.offset = decode(leaf.bytes.data() + cursor.offset, cursor.key) - leaf.bytes.data();
+    }
+
+    /** Obtains the first position whose tuple is not less, or greater if strict, than the given one */
+    Cursor seek(const Key& k, bool strict) const {
+        // the last leaf starting with a tuple not greater than the given one
+        auto pos = std::upper_bound(
+                leaves.begin(), leaves.end(), k, [](const Key& a, const Leaf& b) { return a < b.first; });
+        if (pos == leaves.begin()) {
+            return cursorAt(0);
+        }
+        Cursor cursor = cursorAt(pos - leaves.begin() - 1);
+        const std::size_t leaf = cursor.leaf;
+        while (cursor.leaf == leaf && (strict ? !(k < cursor.key) : cursor.key < k)) {
+            advance(cursor);
+        }
+        return cursor;
+    }
+
+    bool containsCompressed(const Key& k) const {
+        if (leaves.empty()) {
+            return false;
+        }
+        Cursor cursor = seek(k, false);
+        return cursor.leaf < leaves.size() && cursor.key == k;
+    }
+
+    // -- uncompressed tuples --
+
+    typename fresh_type::operation_hints& freshHints(operation_hints& hints) const {
+        if (hints.epoch != epoch) {
+            hints.fresh.clear();
+            hints.epoch = epoch;
+        }
+        return hints.fresh;
+    }
+
+    std::size_t compactionThreshold() const {
+        return std::max(MinUncompressed, compressedCount / 8);
+    }
+
+    /** Merges the uncompressed tuples into the leaves, excluding all other lanes meanwhile */
+    void tryCompact() {
+        lanes.beforeLockAllBut();
+        if (freshCount.load(std::memory_order_relaxed) < compactionThreshold()) {
+            // merged by another lane meanwhile
+            lanes.beforeUnlockAllBut();
+            return;
+        }
+        lanes.lockAllBut();
+        compact();
+        lanes.unlockAllBut();
+        lanes.beforeUnlockAllBut();
+    }
+
+    std::vector<Leaf> leaves;
+    std::size_t compressedCount = 0;
+
+    fresh_type fresh;
+    std::atomic<std::size_t> freshCount{0};
+    std::size_t epoch = 1;
+    bool compaction = true;
+
+    mutable ConcurrentLanes lanes{static_cast<std::size_t>(MAX_THREADS)};
+    std::unique_ptr<LaneCount[]> pending;
+};
+
+}  // namespace souffle
@@ -8,7 +8,10 @@
 #pragma once
 
 #include "ConcurrentInsertOnlyHashMap.h"
+#include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstring>
 
@@ -27,6 +30,11 @@ namespace souffle {
  * single lane perform the growing operation. The global lock is amortized
  * thanks to an exponential growth strategy.
  *
+ * Fetching the value of an index is wait-free: the slots are stored in
+ * segments of doubling size that never move once allocated. Finding the index
+ * of a key that is already mapped does not enter a lane either, unless the map
+ * grows concurrently.
+ *
  */
 template <class LanesPolicy, class Key, class Hash = std::hash<Key>, class KeyEqual = std::equal_to<Key>,
         class KeyFactory = details::Factory<Key>>
@@ -136,13 +144,11 @@ public:
         }
 
         reference operator*() const {
-            const auto Guard = This->Lanes.guard(Lane);
-            return *This->Slots[index(Slot)];
+            return *This->slotAt(index(Slot));
         }
 
         pointer operator->() const {
-            const auto Guard = This->Lanes.guard(Lane);
-            return This->Slots[index(Slot)];
+            return This->slotAt(index(Slot));
         }
 
         Iterator& operator++() {
@@ -227,10 +233,15 @@ public:
             const KeyFactory& key_factory = KeyFactory())
             : Lanes(LaneCount), HandleCount(LaneCount),
               Mapping(LaneCount, InitialCapacity, hash, key_equal, key_factory) {
-        Slots = std::make_unique<const value_type*[]>(InitialCapacity);
+        FirstSegmentBits = 3;
+        while ((std::size_t(1) << FirstSegmentBits) < InitialCapacity) {
+            ++FirstSegmentBits;
+        }
+        Segments[0].store(new const value_type*[std::size_t(1) << FirstSegmentBits]());
+        SegmentCount = 1;
         Handles = std::make_unique<Handle[]>(HandleCount);
         NextSlot = (ReserveFirst ? 1 : 0);
-        SlotCount = InitialCapacity;
+        SlotCount = std::size_t(1) << FirstSegmentBits;
     }
 
     /// Initialize the datastructure with a capacity of 8 elements.
@@ -250,6 +261,9 @@ public:
                 delete Handles[I].NextNode;
             }
         }
+        for (std::size_t I = 0; I < SegmentCount; ++I) {
+            delete[] Segments[I].load(std::memory_order_relaxed);
+        }
     }
 
     /**
@@ -283,12 +297,11 @@ public:
         return Mapping.weakContains(H, X);
     }
 
-    /// Return the value associated with the given index.
+    /// Return the value associated with the given index, without entering a lane.
     /// Assumption: the index is mapped in the datastructure.
-    const Key& fetch(const lane_id H, const index_type Idx) const {
-        const auto Lane = Lanes.guard(H);
+    const Key& fetch(const lane_id, const index_type Idx) const {
         assert(Idx < SlotCount.load(std::memory_order_relaxed));
-        return Slots[Idx]->first;
+        return slotAt(Idx)->first;
     }
 
     /// Return the pair of the index for the given value and a boolean
@@ -297,6 +310,11 @@ public:
     /// yet indexed.
     template <class... Args>
     std::pair<index_type, bool> findOrInsert(const lane_id H, Args&&... Xs) {
+        // most keys are already mapped, look them up without entering a lane first
+        if (const value_type* Found = Mapping.find(Xs...)) {
+            return std::make_pair(Found->second, false);
+        }
+
         const auto Lane = Lanes.guard(H);
         node_type Node;
 
@@ -337,7 +355,7 @@ public:
         Node = Handles[H].NextNode;
 
         // Insert key in the index in advance.
-        Slots[Slot] = &Node->value();
+        slotAt(Slot) = &Node->value();
 
         auto Res = Mapping.get(H, Node, std::forward<Args>(Xs)...);
         if (Res.second) {
@@ -352,7 +370,7 @@ public:
             // The reserved slot and node remains in the lane state so that
             // they can be consumed by the next insertion operation on this
             // lane.
-            Slots[Slot] = nullptr;
+            slotAt(Slot) = nullptr;
             return std::make_pair(Res.first->second, false);
         }
     }
@@ -382,8 +400,18 @@ private:
     // Handle for each concurrent lane.
     std::unique_ptr<Handle[]> Handles;
 
-    // Slots[I] points to the value associated with index I.
-    std::unique_ptr<const value_type*[]> Slots;
+    /// Number of segments of slots, enough for any index.
+    static constexpr std::size_t MaxSegments = 64;
+
+    // Segment K holds (1 << (FirstSegmentBits + K)) slots, the slot of index I is
+    // found from the highest bit of I + (1 << FirstSegmentBits).
+    std::array<std::atomic<const value_type**>, MaxSegments> Segments = {};
+
+    // Base-2 logarithm of the size of the first segment.
+    std::size_t FirstSegmentBits;
+
+    // Number of allocated segments.
+    std::size_t SegmentCount;
 
     // The map from keys to index.
     map_type Mapping;
@@ -394,6 +422,13 @@ private:
     // Number of slots.
     std::atomic<slot_type> SlotCount;
 
+    /// Return the slot of index I, it points to the value associated with I.
+    const value_type*& slotAt(const index_type I) const {
+        const std::size_t N = I + (std::size_t(1) << FirstSegmentBits);
+        const std::size_t Bit = 63 - __builtin_clzll(N);
+        return Segments[Bit - FirstSegmentBits].load(std::memory_order_acquire)[N - (std::size_t(1) << Bit)];
+    }
+
     /// Grow the datastructure if needed.
     bool tryGrow(const lane_id H) {
         // This call may release and re-acquire the lane to
@@ -414,14 +449,15 @@ private:
         Lanes.lockAllBut(H);
 
         {  // safe section
-            const std::size_t CurrentSize = SlotCount;
-            std::size_t NewSize = (CurrentSize << 1);  // double size policy
-            while (NewSize < NextSlot) {
-                NewSize <<= 1;  // double size
+            // add segments of double size until the reserved slots are available,
+            // the existing segments stay in place for concurrent fetches
+            std::size_t NewSize = SlotCount;
+            while (NewSize <= NextSlot) {
+                const std::size_t SegmentSize = std::size_t(1) << (FirstSegmentBits + SegmentCount);
+                Segments[SegmentCount].store(new const value_type*[SegmentSize](), std::memory_order_release);
+                ++SegmentCount;
+                NewSize += SegmentSize;
             }
-            std::unique_ptr<const value_type*[]> NewSlots = std::make_unique<const value_type*[]>(NewSize);
-            std::memcpy(NewSlots.get(), Slots.get(), sizeof(const value_type*) * CurrentSize);
-            Slots = std::move(NewSlots);
             SlotCount = NewSize;
         }
 
@@ -462,7 +498,8 @@ public:
     }
 
     const Key& fetch(const index_type Idx) const {
-        return Base::fetch(Base::Lanes.threadLane(), Idx);
+        // fetching does not enter a lane
+        return Base::fetch(0, Idx);
     }
 
     template <class... Args>
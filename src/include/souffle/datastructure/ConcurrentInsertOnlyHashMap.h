@@ -124,7 +124,7 @@ private:
         value_type Value;
 
         // Points to next element of the map that falls into the same bucket.
-        BucketList* Next;
+        std::atomic<BucketList*> Next;
     };
 
 public:
@@ -145,6 +145,8 @@ public:
         }
         LoadFactor = 1.0;
         Buckets = std::make_unique<std::atomic<BucketList*>[]>(BucketCount);
+        SharedBuckets = Buckets.get();
+        SharedBucketCount = BucketCount;
         MaxSizeBeforeGrow = static_cast<std::size_t>(std::ceil(LoadFactor * (double)BucketCount));
     }
 
@@ -157,7 +159,7 @@ public:
             BucketList* L = Buckets[Bucket].load(std::memory_order_relaxed);
             while (L != nullptr) {
                 BucketList* BL = L;
-                L = L->Next;
+                L = L->Next.load(std::memory_order_relaxed);
                 delete (BL);
             }
         }
@@ -196,7 +198,45 @@ public:
                 // found the key
                 return &L->Value;
             }
-            L = L->Next;
+            L = L->Next.load(std::memory_order_relaxed);
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Lookup a value associated with a key, without entering a lane.
+     *
+     * The search is wait-free. It gives up and returns a nullpointer when the
+     * map grows concurrently, so a nullpointer only means that the key may not
+     * be mapped, and the caller must fall back to a lookup through a lane.
+     */
+    template <class... Args>
+    const value_type* find(const Args&... Xs) const {
+        const std::size_t HashValue = Hasher(Xs...);
+
+        // the generation is odd while the buckets are rehashed, and changes when a rehash starts
+        const std::size_t Start = Generation.load(std::memory_order_acquire);
+        if (Start % 2 != 0) {
+            return nullptr;
+        }
+        std::atomic<BucketList*>* const Array = SharedBuckets.load(std::memory_order_relaxed);
+        const std::size_t Count = SharedBucketCount.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (Generation.load(std::memory_order_relaxed) != Start) {
+            return nullptr;
+        }
+
+        BucketList* L = Array[HashValue % Count].load(std::memory_order_acquire);
+        while (L != nullptr) {
+            if (EqualTo(L->Value.first, Xs...)) {
+                return &L->Value;
+            }
+            L = L->Next.load(std::memory_order_relaxed);
+            // a rehash relinks the nodes, stop before following a link it changed
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (Generation.load(std::memory_order_relaxed) != Start) {
+                return nullptr;
+            }
         }
         return nullptr;
     }
@@ -334,16 +374,16 @@ public:
                     // Although it's not strictly necessary, clear the node
                     // chaining to avoid leaving a dangling pointer there.
                     Value = &(L->Value);
-                    Node->Next = nullptr;
+                    Node->Next.store(nullptr, std::memory_order_relaxed);
                     goto Done;
                 }
-                L = L->Next;
+                L = L->Next.load(std::memory_order_relaxed);
             }
             SearchedFrom = LastKnownHead;
 
             // 7)
             // Not found in bucket, prepare node chaining.
-            Node->Next = LastKnownHead;
+            Node->Next.store(LastKnownHead, std::memory_order_relaxed);
             // The factory step could be done only once, but assuming bucket collisions are
             // rare this whole loop is not executed more than once.
             Factory.replace(const_cast<key_type&>(Node->Value.first), std::forward<Args>(Xs)...);
@@ -391,6 +431,16 @@ private:
     /// Atomic pointer to head bucket linked-list head.
     std::unique_ptr<std::atomic<BucketList*>[]> Buckets;
 
+    /// Buckets and their number, as seen by the lookups that do not enter a lane.
+    std::atomic<std::atomic<BucketList*>*> SharedBuckets;
+    std::atomic<std::size_t> SharedBucketCount;
+
+    /// Number of rehash starts and ends, odd while the buckets are rehashed.
+    std::atomic<std::size_t> Generation{0};
+
+    /// Buckets replaced by a rehash, kept until destruction for concurrent lookups.
+    std::vector<std::unique_ptr<std::atomic<BucketList*>[]>> RetiredBuckets;
+
     /// The Equal-to function.
     KeyEqual EqualTo;
 
@@ -420,6 +470,10 @@ private:
 
         {  // safe section
 
+            // Lookups without a lane give up from here, before any node is relinked.
+            Generation.store(Generation.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
             // Compute the new number of buckets:
             // Chose a prime number of buckets that ensures the desired load factor
             // given the current number of elements in the map.
@@ -453,20 +507,26 @@ private:
                 BucketList* L = Buckets[B].load(std::memory_order_relaxed);
                 while (L) {
                     BucketList* const Elem = L;
-                    L = L->Next;
+                    L = L->Next.load(std::memory_order_relaxed);
 
                     const auto& Value = Elem->Value;
                     std::size_t NewHash = Hasher(Value.first);
                     const std::size_t NewBucket = NewHash % NewBucketCount;
-                    Elem->Next = NewBuckets[NewBucket].load(std::memory_order_relaxed);
+                    Elem->Next.store(NewBuckets[NewBucket].load(std::memory_order_relaxed),
+                            std::memory_order_relaxed);
                     NewBuckets[NewBucket].store(Elem, std::memory_order_relaxed);
                 }
             }
 
+            RetiredBuckets.push_back(std::move(Buckets));
             Buckets = std::move(NewBuckets);
             BucketCount = NewBucketCount;
             MaxSizeBeforeGrow =
                     static_cast<std::size_t>(std::ceil(static_cast<double>(NewBucketCount) * LoadFactor));
+
+            SharedBuckets.store(Buckets.get(), std::memory_order_relaxed);
+            SharedBucketCount.store(BucketCount, std::memory_order_relaxed);
+            Generation.store(Generation.load(std::memory_order_relaxed) + 1, std::memory_order_release);
         }
 
         Lanes.beforeUnlockAllBut(H);
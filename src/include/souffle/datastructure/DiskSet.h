@@ -0,0 +1,489 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file DiskSet.h
+ *
+ * A set of tuples keeping most of its content on disk. Insertions go to an
+ * in-memory B-tree, which is written to a sorted run in a file once it
+ * exceeds its memory budget. Runs are memory-mapped read-only, such that
+ * their pages are held by the page cache of the operating system, which
+ * evicts them under memory pressure instead of killing the process. On
+ * Windows, runs are read into the heap instead, so spilling saves no memory.
+ *
+ * Runs of similar sizes are merged, so there are logarithmically many runs
+ * in the number of spilled tuples. Files are removed as soon as they are
+ * mapped and thus vanish with the process.
+ *
+ * Multiple insert operations can be conducted concurrently, and so can
+ * lookups. Spilling happens during insertions, unless it is disabled for a
+ * set that is read while it is modified.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/BTree.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * A set of tuples ordered lexicographically, spilling to disk.
+ *
+ * @tparam Key .. an array of trivially copyable elements
+ */
+template <typename Key>
+class DiskSet {
+    using fresh_type = btree_set<Key, detail::comparator<Key>>;
+
+    static_assert(std::is_trivially_copyable_v<Key>, "spilled tuples are copied byte-wise");
+
+public:
+    /** The maximal number of runs, which are merged otherwise */
+    static constexpr std::size_t MaxRuns = 32;
+
+    /** The default number of bytes of tuples kept in memory */
+    static constexpr std::size_t DefaultMemoryBudget = std::size_t(64) << 20;
+
+    /** Hints of a thread, which remember its last accesses of the in-memory tuples */
+    struct operation_hints {
+        typename fresh_type::operation_hints fresh;
+        std::size_t epoch = 0;
+    };
+
+private:
+    /** A sorted run of tuples in a memory-mapped file */
+    struct Run {
+        std::unique_ptr<MappedFile> file;
+        std::size_t count;
+
+        const Key* begin() const {
+            return reinterpret_cast<const Key*>(file->data());
+        }
+
+        const Key* end() const {
+            return begin() + count;
+        }
+    };
+
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Key;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Key*;
+        using reference = const Key&;
+
+        iterator() = default;
+
+        iterator(const DiskSet* set, const std::array<const Key*, MaxRuns>& cursors,
+                typename fresh_type::iterator fresh, typename fresh_type::iterator freshEnd)
+                : set(set), cursors(cursors), fresh(std::move(fresh)), freshEnd(std::move(freshEnd)) {
+            select();
+        }
+
+        const Key& operator*() const {
+            return *current;
+        }
+
+        const Key* operator->() const {
+            return current;
+        }
+
+        iterator& operator++() {
+            if (source == MaxRuns) {
+                ++fresh;
+            } else {
+                ++cursors[source];
+            }
+            select();
+            return *this;
+        }
+
+        iterator operator++(int) {
+            auto res = *this;
+            ++(*this);
+            return res;
+        }
+
+        bool operator==(const iterator& other) const {
+            return cursors == other.cursors && fresh == other.fresh;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+    private:
+        /** Determines the source of the smallest remaining tuple */
+        void select() {
+            current = nullptr;
+            source = MaxRuns;
+            if (fresh != freshEnd) {
+                current = &*fresh;
+            }
+            for (std::size_t i = 0; i < set->runs.size(); ++i) {
+                if (cursors[i] != set->runs[i].end() && (current == nullptr || *cursors[i] < *current)) {
+                    current = cursors[i];
+                    source = i;
+                }
+            }
+        }
+
+        const DiskSet* set = nullptr;
+        std::array<const Key*, MaxRuns> cursors{};
+        typename fresh_type::iterator fresh;
+        typename fresh_type::iterator freshEnd;
+        const Key* current = nullptr;
+        std::size_t source = MaxRuns;
+    };
+
+    using const_iterator = iterator;
+    using chunk = range<iterator>;
+
+    DiskSet() : pending(std::make_unique<LaneCount[]>(lanes.lanes())) {}
+    DiskSet(const DiskSet&) = delete;
+    DiskSet& operator=(const DiskSet&) = delete;
+
+    /**
+     * Enables or disables spilling during insertions. It must be disabled
+     * while the set is read and modified at the same time, since spilling
+     * moves tuples under the feet of the readers.
+     */
+    void setCompaction(bool enable) {
+        spilling = enable;
+    }
+
+    /**
+     * Sets the number of bytes of tuples kept in memory before they are spilled,
+     * including the estimated overhead of the nodes of the in-memory B-tree.
+     */
+    void setMemoryBudget(std::size_t bytes) {
+        memoryBudget = std::max(bytes, sizeof(Key) * PublishBatch);
+    }
+
+    bool insert(const Key& k) {
+        operation_hints hints;
+        return insert(k, hints);
+    }
+
+    bool insert(const Key& k, operation_hints& hints) {
+        const auto lane = lanes.threadLane();
+        auto guard = lanes.guard();
+        if (containsSpilled(k) || !fresh.insert(k, freshHints(hints))) {
+            return false;
+        }
+        // the counts of the lanes are published in batches, to keep the shared counter cold;
+        // a lane's count is only written by its owner, but read by size() at any time
+        auto& count = pending[lane].count;
+        const std::size_t local = count.load(std::memory_order_relaxed) + 1;
+        if (local < PublishBatch) {
+            count.store(local, std::memory_order_relaxed);
+            return true;
+        }
+        const std::size_t total = freshCount.fetch_add(local, std::memory_order_relaxed) + local;
+        count.store(0, std::memory_order_relaxed);
+        if (spilling && overBudget(total)) {
+            trySpill();
+        }
+        return true;
+    }
+
+    /**
+     * Writes the in-memory tuples to a run on disk.
+     * This operation is not thread-safe.
+     */
+    void spill() {
+        if (!fresh.empty()) {
+            RunWriter writer;
+            for (const auto& key : fresh) {
+                writer.push(key);
+            }
+            runs.push_back(writer.finish());
+            // the free slots and inner nodes of the B-tree grow with its tuples
+            tupleBytes.store(std::max(sizeof(Key), fresh.getMemoryUsage() / runs.back().count),
+                    std::memory_order_relaxed);
+            fresh.clear();
+            mergeRuns();
+        }
+        freshCount.store(0, std::memory_order_relaxed);
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            pending[lane].count.store(0, std::memory_order_relaxed);
+        }
+        // hints of other threads may still refer to the nodes of the cleared B-tree
+        ++epoch;
+    }
+
+    bool contains(const Key& k) const {
+        return containsSpilled(k) || fresh.contains(k);
+    }
+
+    bool contains(const Key& k, operation_hints& hints) const {
+        return containsSpilled(k) || fresh.contains(k, freshHints(hints));
+    }
+
+    iterator begin() const {
+        std::array<const Key*, MaxRuns> cursors{};
+        for (std::size_t i = 0; i < runs.size(); ++i) {
+            cursors[i] = runs[i].begin();
+        }
+        return iterator(this, cursors, fresh.begin(), fresh.end());
+    }
+
+    iterator end() const {
+        std::array<const Key*, MaxRuns> cursors{};
+        for (std::size_t i = 0; i < runs.size(); ++i) {
+            cursors[i] = runs[i].end();
+        }
+        return iterator(this, cursors, fresh.end(), fresh.end());
+    }
+
+    iterator lower_bound(const Key& k) const {
+        return iterator(this, seek(k, false), fresh.lower_bound(k), fresh.end());
+    }
+
+    iterator lower_bound(const Key& k, operation_hints& hints) const {
+        return iterator(this, seek(k, false), fresh.lower_bound(k, freshHints(hints)), fresh.end());
+    }
+
+    iterator upper_bound(const Key& k) const {
+        return iterator(this, seek(k, true), fresh.upper_bound(k), fresh.end());
+    }
+
+    iterator upper_bound(const Key& k, operation_hints& hints) const {
+        return iterator(this, seek(k, true), fresh.upper_bound(k, freshHints(hints)), fresh.end());
+    }
+
+    /**
+     * Splits the set into roughly the given number of ranges, at evenly
+     * spaced tuples of the largest run, or of the B-tree while nothing is spilled.
+     */
+    std::vector<chunk> partition(std::size_t num) const {
+        std::vector<Key> bounds;
+        if (!runs.empty()) {
+            const Run& largest = runs.front();
+            for (std::size_t p = 1; p < num; ++p) {
+                const std::size_t pos = p * largest.count / num;
+                if (pos > 0 && (bounds.empty() || bounds.back() < largest.begin()[pos])) {
+                    bounds.push_back(largest.begin()[pos]);
+                }
+            }
+        } else {
+            for (const auto& cur : fresh.partition(num)) {
+                if (cur.begin() != fresh.begin() && cur.begin() != fresh.end()) {
+                    bounds.push_back(*cur.begin());
+                }
+            }
+        }
+
+        std::vector<chunk> res;
+        iterator cur = begin();
+        for (const auto& bound : bounds) {
+            iterator next = lower_bound(bound);
+            res.push_back({cur, next});
+            cur = next;
+        }
+        res.push_back({cur, end()});
+        return res;
+    }
+
+    bool empty() const {
+        return runs.empty() && fresh.empty();
+    }
+
+    std::size_t size() const {
+        std::size_t res = freshCount.load(std::memory_order_relaxed);
+        for (const auto& run : runs) {
+            res += run.count;
+        }
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            res += pending[lane].count.load(std::memory_order_relaxed);
+        }
+        return res;
+    }
+
+    void clear() {
+        runs.clear();
+        fresh.clear();
+        spill();
+    }
+
+    /** The number of runs on disk */
+    std::size_t getRunCount() const {
+        return runs.size();
+    }
+
+private:
+    /** The number of insertions of a lane that are published at once */
+    static constexpr std::size_t PublishBatch = 256;
+
+    struct LaneCount {
+        alignas(hardware_destructive_interference_size) std::atomic<std::size_t> count{0};
+    };
+
+    /** Writes tuples in ascending order to a new run */
+    class RunWriter {
+    public:
+        RunWriter() : fileName(newFileName()), file(fileName, std::ios::out | std::ios::binary) {
+            if (!file.is_open()) {
+                throw std::runtime_error("Cannot create spill file " + fileName);
+            }
+            buffer.reserve(BufferSize);
+        }
+
+        void push(const Key& key) {
+            buffer.push_back(key);
+            if (buffer.size() == BufferSize) {
+                flush();
+            }
+            ++count;
+        }
+
+        Run finish() {
+            flush();
+            file.close();
+            if (!file) {
+                std::filesystem::remove(fileName);
+                throw std::runtime_error("Cannot write spill file " + fileName);
+            }
+            // runs are binary-searched, read-ahead would only fetch pages that are not needed
+            auto mapped = std::make_unique<MappedFile>(fileName, MappedFile::Access::Random);
+            // the mapping outlives the name of the file
+            std::filesystem::remove(fileName);
+            if (!mapped->isOpen() || mapped->size() != count * sizeof(Key)) {
+                throw std::runtime_error("Cannot map spill file " + fileName);
+            }
+            return {std::move(mapped), count};
+        }
+
+    private:
+        static constexpr std::size_t BufferSize = (std::size_t(1) << 20) / sizeof(Key) + 1;
+
+        static std::string newFileName() {
+            static std::atomic<std::size_t> counter{0};
+            static const auto token = std::random_device()();
+            return (std::filesystem::temp_directory_path() /
+                    ("souffle-spill-" + std::to_string(token) + "-" + std::to_string(counter++)))
+                    .string();
+        }
+
+        void flush() {
+            file.write(reinterpret_cast<const char*>(buffer.data()), buffer.size() * sizeof(Key));
+            buffer.clear();
+        }
+
+        std::string fileName;
+        std::ofstream file;
+        std::vector<Key> buffer;
+        std::size_t count = 0;
+    };
+
+    /** Merges the youngest runs while they are not much smaller than their predecessors */
+    void mergeRuns() {
+        while (runs.size() > 1 && (runs.size() > MaxRuns ||
+                                          runs[runs.size() - 2].count <= 2 * runs[runs.size() - 1].count)) {
+            const Run& a = runs[runs.size() - 2];
+            const Run& b = runs[runs.size() - 1];
+            RunWriter writer;
+            const Key* i = a.begin();
+            const Key* j = b.begin();
+            while (i != a.end() && j != b.end()) {
+                writer.push(*j < *i ? *j++ : *i++);
+            }
+            for (; i != a.end(); ++i) {
+                writer.push(*i);
+            }
+            for (; j != b.end(); ++j) {
+                writer.push(*j);
+            }
+            Run merged = writer.finish();
+            runs.pop_back();
+            runs.back() = std::move(merged);
+        }
+    }
+
+    /** Obtains the positions of the first tuples not less, or greater if strict, than the given one */
+    std::array<const Key*, MaxRuns> seek(const Key& k, bool strict) const {
+        std::array<const Key*, MaxRuns> res{};
+        for (std::size_t i = 0; i < runs.size(); ++i) {
+            res[i] = strict ? std::upper_bound(runs[i].begin(), runs[i].end(), k)
+                            : std::lower_bound(runs[i].begin(), runs[i].end(), k);
+        }
+        return res;
+    }
+
+    bool containsSpilled(const Key& k) const {
+        for (const auto& run : runs) {
+            if (std::binary_search(run.begin(), run.end(), k)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    typename fresh_type::operation_hints& freshHints(operation_hints& hints) const {
+        if (hints.epoch != epoch) {
+            hints.fresh.clear();
+            hints.epoch = epoch;
+        }
+        return hints.fresh;
+    }
+
+    /** Whether the given number of in-memory tuples exceeds the memory budget */
+    bool overBudget(std::size_t tuples) const {
+        return tuples * tupleBytes.load(std::memory_order_relaxed) >= memoryBudget;
+    }
+
+    /** Spills the in-memory tuples, excluding all other lanes meanwhile */
+    void trySpill() {
+        lanes.beforeLockAllBut();
+        if (!overBudget(freshCount.load(std::memory_order_relaxed))) {
+            // spilled by another lane meanwhile
+            lanes.beforeUnlockAllBut();
+            return;
+        }
+        lanes.lockAllBut();
+        spill();
+        lanes.unlockAllBut();
+        lanes.beforeUnlockAllBut();
+    }
+
+    std::vector<Run> runs;
+
+    fresh_type fresh;
+    std::atomic<std::size_t> freshCount{0};
+    std::size_t epoch = 1;
+    std::size_t memoryBudget = DefaultMemoryBudget;
+
+    // the estimated bytes of a tuple in the in-memory B-tree, measured at each spill
+    std::atomic<std::size_t> tupleBytes{2 * sizeof(Key)};
+    bool spilling = true;
+
+    mutable ConcurrentLanes lanes{static_cast<std::size_t>(MAX_THREADS)};
+    std::unique_ptr<LaneCount[]> pending;
+};
+
+}  // namespace souffle
@@ -0,0 +1,333 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file HashIndex.h
+ *
+ * An index over tuples that is keyed by a subset of their columns and
+ * implemented by a concurrent hash map. It answers equality lookups in
+ * expected constant time, but cannot answer range queries.
+ *
+ * Multiple insert operations can be conducted concurrently, and so can
+ * lookups. Iterating over all tuples and inserting may not be conducted
+ * at the same time.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/datastructure/ConcurrentInsertOnlyHashMap.h"
+#include "souffle/utility/Iteration.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ostream>
+#include <type_traits>
+#include <vector>
+
+namespace souffle {
+
+namespace detail {
+
+/** Hashes a tuple by the given columns */
+template <typename Tuple, std::size_t... Columns>
+struct TupleColumnHash {
+    std::size_t operator()(const Tuple& tuple) const {
+        using value_type = std::decay_t<decltype(tuple[0])>;
+        std::size_t seed = 0;
+        ((seed ^= std::hash<value_type>()(tuple[Columns]) + 0x9e3779b9 + (seed << 6) + (seed >> 2)), ...);
+        return seed;
+    }
+};
+
+/** Compares two tuples by the given columns */
+template <typename Tuple, std::size_t... Columns>
+struct TupleColumnEqual {
+    bool operator()(const Tuple& a, const Tuple& b) const {
+        return ((a[Columns] == b[Columns]) && ...);
+    }
+};
+
+}  // namespace detail
+
+/**
+ * A hash index grouping tuples by the values of the given key columns.
+ *
+ * If isSet is true, the key columns must cover the whole tuple, and an
+ * insertion of a tuple that is already present has no effect. Otherwise,
+ * tuples sharing a key are chained, and the caller is in charge of not
+ * inserting a tuple twice.
+ */
+template <typename Tuple, bool isSet, std::size_t... Columns>
+class HashIndex {
+    /** A stored tuple, chained to the next tuple with the same key */
+    struct Entry {
+        Entry(const Tuple& tuple) : tuple(tuple) {}
+        Tuple tuple;
+        const Entry* next = nullptr;
+    };
+
+    /** The head of the chain of tuples with the same key */
+    struct Group {
+        std::atomic<const Entry*> head{nullptr};
+    };
+
+    using hash_map = ConcurrentInsertOnlyHashMap<ConcurrentLanes, Tuple, Group*,
+            detail::TupleColumnHash<Tuple, Columns...>, detail::TupleColumnEqual<Tuple, Columns...>>;
+
+    /** The storage of a lane, which owns the entries and groups allocated by it */
+    struct Lane {
+        std::deque<Entry> entries;
+        std::deque<Group> groups;
+        // a node prepared for the next insertion of a new key
+        typename hash_map::node_type spare = nullptr;
+    };
+
+public:
+    using element_type = Tuple;
+
+    /** An iterator over the tuples with the same key */
+    class chain_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Tuple;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Tuple*;
+        using reference = const Tuple&;
+
+        chain_iterator(const Entry* cur = nullptr) : cur(cur) {}
+
+        bool operator==(const chain_iterator& other) const {
+            return cur == other.cur;
+        }
+
+        bool operator!=(const chain_iterator& other) const {
+            return cur != other.cur;
+        }
+
+        const Tuple& operator*() const {
+            return cur->tuple;
+        }
+
+        const Tuple* operator->() const {
+            return &cur->tuple;
+        }
+
+        chain_iterator& operator++() {
+            cur = cur->next;
+            return *this;
+        }
+
+    private:
+        const Entry* cur;
+    };
+
+    /** An iterator over all tuples, lane by lane */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Tuple;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Tuple*;
+        using reference = const Tuple&;
+
+        iterator() = default;
+
+        iterator(const Lane* lanes, std::size_t numLanes, std::size_t lane, std::size_t pos)
+                : lanes(lanes), numLanes(numLanes), lane(lane), pos(pos) {
+            skipEmpty();
+        }
+
+        bool operator==(const iterator& other) const {
+            return lane == other.lane && pos == other.pos;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return !(*this == other);
+        }
+
+        const Tuple& operator*() const {
+            return lanes[lane].entries[pos].tuple;
+        }
+
+        const Tuple* operator->() const {
+            return &lanes[lane].entries[pos].tuple;
+        }
+
+        iterator& operator++() {
+            ++pos;
+            skipEmpty();
+            return *this;
+        }
+
+    private:
+        // move on to the next lane once the entries of a lane are exhausted
+        void skipEmpty() {
+            while (lane < numLanes && pos >= lanes[lane].entries.size()) {
+                ++lane;
+                pos = 0;
+            }
+        }
+
+        const Lane* lanes = nullptr;
+        std::size_t numLanes = 0;
+        std::size_t lane = 0;
+        std::size_t pos = 0;
+    };
+
+    /** Lookups and insertions do not need any context */
+    struct operation_hints {};
+
+    HashIndex() : lanes(MAX_THREADS), storage(std::make_unique<Lane[]>(lanes.lanes())), map(makeMap()) {}
+
+    HashIndex(const HashIndex&) = delete;
+    HashIndex& operator=(const HashIndex&) = delete;
+
+    ~HashIndex() {
+        releaseSpares();
+    }
+
+    /**
+     * Inserts a tuple. Returns false if this is a set that already
+     * contains the tuple, true otherwise.
+     */
+    bool insert(const Tuple& tuple) {
+        const auto lane = lanes.threadLane();
+        auto guard = lanes.guard(lane);
+        Lane& local = storage[lane];
+        if (local.spare == nullptr) {
+            local.groups.emplace_back();
+            local.spare = map->node(&local.groups.back());
+        }
+
+        auto [value, inserted] = map->get(lane, local.spare, tuple);
+        if (inserted) {
+            local.spare = nullptr;
+        } else if (isSet) {
+            return false;
+        }
+
+        // chain the tuple in front of the tuples with the same key
+        Group* group = value->second;
+        Entry* entry = &local.entries.emplace_back(tuple);
+        const Entry* head = group->head.load(std::memory_order_relaxed);
+        do {
+            entry->next = head;
+        } while (!group->head.compare_exchange_weak(
+                head, entry, std::memory_order_release, std::memory_order_relaxed));
+        return true;
+    }
+
+    bool insert(const Tuple& tuple, operation_hints&) {
+        return insert(tuple);
+    }
+
+    /** Tests whether a tuple with the key of the given tuple is present */
+    bool contains(const Tuple& key) const {
+        return find(key) != chain_iterator();
+    }
+
+    bool contains(const Tuple& key, operation_hints&) const {
+        return contains(key);
+    }
+
+    /** Obtains the first of the tuples with the key of the given tuple */
+    chain_iterator find(const Tuple& key) const {
+        const auto* value = map->weakFind(lanes.threadLane(), key);
+        if (value == nullptr) {
+            return {};
+        }
+        return chain_iterator(value->second->head.load(std::memory_order_acquire));
+    }
+
+    /** Obtains the tuples with the key of the given tuple */
+    range<chain_iterator> equalRange(const Tuple& key) const {
+        return make_range(find(key), chain_iterator());
+    }
+
+    range<chain_iterator> equalRange(const Tuple& key, operation_hints&) const {
+        return equalRange(key);
+    }
+
+    std::size_t size() const {
+        std::size_t res = 0;
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            res += storage[lane].entries.size();
+        }
+        return res;
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+
+    iterator begin() const {
+        return iterator(storage.get(), lanes.lanes(), 0, 0);
+    }
+
+    iterator end() const {
+        return iterator(storage.get(), lanes.lanes(), lanes.lanes(), 0);
+    }
+
+    /**
+     * Splits the tuples into ranges of roughly equal size, for processing
+     * them in parallel.
+     */
+    std::vector<range<iterator>> partition(std::size_t chunks) const {
+        const std::size_t chunkSize = std::max<std::size_t>(1, size() / std::max<std::size_t>(1, chunks));
+        std::vector<range<iterator>> res;
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            const std::size_t count = storage[lane].entries.size();
+            for (std::size_t pos = 0; pos < count; pos += chunkSize) {
+                res.push_back(make_range(iterator(storage.get(), lanes.lanes(), lane, pos),
+                        iterator(storage.get(), lanes.lanes(), lane, std::min(pos + chunkSize, count))));
+            }
+        }
+        return res;
+    }
+
+    /** Removes all tuples */
+    void clear() {
+        releaseSpares();
+        map = makeMap();
+        storage = std::make_unique<Lane[]>(lanes.lanes());
+    }
+
+    void printStats(std::ostream& o) const {
+        o << "---------------------------------\n";
+        o << "  Hash index\n";
+        o << "  Number of lanes:  " << lanes.lanes() << "\n";
+        o << "  Number of tuples: " << size() << "\n";
+        o << "---------------------------------\n";
+    }
+
+private:
+    std::unique_ptr<hash_map> makeMap() const {
+        return std::make_unique<hash_map>(lanes.lanes(), 8);
+    }
+
+    // the spare nodes are owned by this index until they are inserted into the map
+    void releaseSpares() {
+        for (std::size_t lane = 0; lane < lanes.lanes(); ++lane) {
+            delete storage[lane].spare;
+            storage[lane].spare = nullptr;
+        }
+    }
+
+    mutable ConcurrentLanes lanes;
+    std::unique_ptr<Lane[]> storage;
+    std::unique_ptr<hash_map> map;
+};
+
+}  // namespace souffle
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include <array>
 #include <atomic>
@@ -8,19 +9,6 @@
 #include <iostream>
 #include <iterator>
 
-#ifdef _WIN32
-#include <intrin.h>
-/**
- * Some versions of MSVC do not provide a builtin for counting leading zeroes
- * like gcc, so we have to implement it ourselves.
- */
-#if defined(_MSC_VER)
-int __inline __builtin_clzll(unsigned long long value) {
-    return static_cast<int>(__lzcnt64(value));
-}
-#endif  // _MSC_VER
-#endif  // _WIN32
-
 using std::size_t;
 namespace souffle {
 
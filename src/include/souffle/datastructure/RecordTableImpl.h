@@ -17,12 +17,16 @@
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/datastructure/ConcurrentFlyweight.h"
+#include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/span.h"
 
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -481,27 +485,32 @@ public:
     }
 };
 
-/** A concurrent Record Table with some specialized record maps. */
+/**
+ * A concurrent Record Table with some specialized record maps.
+ *
+ * The record maps are found by arity without entering a lane, so that
+ * unpacking a record is wait-free. Concurrent packing proceeds in the lanes
+ * of the record map of the arity, only the creation of a map is serialised.
+ */
 template <std::size_t... SpecializedArities>
 class SpecializedRecordTable : public RecordTable {
 private:
-    // The current size of the Maps vector.
-    std::size_t Size;
+    /// Number of segments of maps, enough for any arity.
+    static constexpr std::size_t MaxSegments = 64;
+
+    // The record maps, indexed by arity. Segment K holds the maps of arities
+    // [2^K - 1, 2^(K+1) - 1), segments never move once allocated.
+    std::array<std::atomic<std::atomic<RecordMap*>*>, MaxSegments> Segments = {};
 
-    // The record maps, indexed by arity.
-    std::vector<RecordMap*> Maps;
+    // The number of concurrent access lanes of the record maps.
+    std::size_t LaneCount;
 
-    // The concurrency manager.
-    mutable ConcurrentLanes Lanes;
+    // Serialises the creation of record maps.
+    std::mutex CreateMutex;
 
     template <std::size_t Arity, std::size_t... Arities>
     void CreateSpecializedMaps() {
-        if (Arity >= Size) {
-            Size = Arity + 1;
-            Maps.reserve(Size);
-            Maps.resize(Size);
-        }
-        Maps[Arity] = new SpecializedRecordMap<Arity>(Lanes.lanes());
+        allocSlot(Arity).store(new SpecializedRecordMap<Arity>(LaneCount), std::memory_order_release);
         if constexpr (sizeof...(Arities) > 0) {
             CreateSpecializedMaps<Arities...>();
         }
@@ -509,15 +518,22 @@ private:
 
 public:
     /** @brief Construct a record table with the number of concurrent access lanes. */
-    SpecializedRecordTable(const std::size_t LaneCount) : Size(0), Lanes(LaneCount) {
+    SpecializedRecordTable(const std::size_t LaneCount) : LaneCount(LaneCount) {
         CreateSpecializedMaps<SpecializedArities...>();
     }
 
     SpecializedRecordTable() : SpecializedRecordTable(1) {}
 
     virtual ~SpecializedRecordTable() {
-        for (auto Map : Maps) {
-            delete Map;
+        for (std::size_t K = 0; K < MaxSegments; ++K) {
+            std::atomic<RecordMap*>* Segment = Segments[K].load(std::memory_order_relaxed);
+            if (Segment == nullptr) {
+                continue;
+            }
+            for (std::size_t I = 0; I < (std::size_t(1) << K); ++I) {
+                delete Segment[I].load(std::memory_order_relaxed);
+            }
+            delete[] Segment;
         }
     }
 
@@ -526,73 +542,85 @@ public:
      * Not thread-safe, use only when the datastructure is not being used.
      */
     virtual void setNumLanes(const std::size_t NumLanes) override {
-        Lanes.setNumLanes(NumLanes);
-        for (auto& Map : Maps) {
-            if (Map) {
-                Map->setNumLanes(NumLanes);
+        LaneCount = NumLanes;
+        for (std::size_t K = 0; K < MaxSegments; ++K) {
+            std::atomic<RecordMap*>* Segment = Segments[K].load(std::memory_order_relaxed);
+            if (Segment == nullptr) {
+                continue;
+            }
+            for (std::size_t I = 0; I < (std::size_t(1) << K); ++I) {
+                if (RecordMap* Map = Segment[I].load(std::memory_order_relaxed)) {
+                    Map->setNumLanes(NumLanes);
+                }
             }
         }
     }
 
     /** @brief convert tuple to record reference */
     virtual RamDomain pack(const RamDomain* Tuple, const std::size_t Arity) override {
-        auto Guard = Lanes.guard();
         return lookupMap(Arity).pack(Tuple);
     }
 
     /** @brief convert tuple to record reference */
     virtual RamDomain pack(const std::initializer_list<RamDomain>& List) override {
-        auto Guard = Lanes.guard();
         return lookupMap(List.size()).pack(std::data(List));
     }
 
     /** @brief convert record reference to a record */
     virtual const RamDomain* unpack(const RamDomain Ref, const std::size_t Arity) const override {
-        auto Guard = Lanes.guard();
         return lookupMap(Arity).unpack(Ref);
     }
 
 private:
+    /** @brief slot of the RecordMap for a given arity, or nullptr if its segment does not exist. */
+    std::atomic<RecordMap*>* findSlot(const std::size_t Arity) const {
+        const std::size_t N = Arity + 1;
+        const std::size_t Bit = 63 - __builtin_clzll(N);
+        std::atomic<RecordMap*>* Segment = Segments[Bit].load(std::memory_order_acquire);
+        return Segment == nullptr ? nullptr : &Segment[N - (std::size_t(1) << Bit)];
+    }
+
+    /** @brief slot of the RecordMap for a given arity, allocating its segment if needed. */
+    std::atomic<RecordMap*>& allocSlot(const std::size_t Arity) {
+        const std::size_t N = Arity + 1;
+        const std::size_t Bit = 63 - __builtin_clzll(N);
+        std::atomic<RecordMap*>* Segment = Segments[Bit].load(std::memory_order_acquire);
+        if (Segment == nullptr) {
+            Segment = new std::atomic<RecordMap*>[std::size_t(1) << Bit]();
+            Segments[Bit].store(Segment, std::memory_order_release);
+        }
+        return Segment[N - (std::size_t(1) << Bit)];
+    }
+
     /** @brief lookup RecordMap for a given arity; the map for that arity must exist. */
     RecordMap& lookupMap(const std::size_t Arity) const {
-        assert(Arity < Size && "Lookup for an arity while there is no record for that arity.");
-        auto* Map = Maps[Arity];
+        auto* Slot = findSlot(Arity);
+        assert(Slot != nullptr && "Lookup for an arity while there is no record for that arity.");
+        auto* Map = Slot->load(std::memory_order_acquire);
         assert(Map != nullptr && "Lookup for an arity while there is no record for that arity.");
         return *Map;
     }
 
     /** @brief lookup RecordMap for a given arity; if it does not exist, create new RecordMap */
     RecordMap& lookupMap(const std::size_t Arity) {
-        if (Arity < Size) {
-            auto* Map = Maps[Arity];
-            if (Map) {
+        if (auto* Slot = findSlot(Arity)) {
+            if (auto* Map = Slot->load(std::memory_order_acquire)) {
                 return *Map;
             }
         }
-
-        createMap(Arity);
-        return *Maps[Arity];
+        return createMap(Arity);
     }
 
-    /** @brief create the RecordMap for the given arity. */
-    void createMap(const std::size_t Arity) {
-        Lanes.beforeLockAllBut();
-        if (Arity < Size && Maps[Arity] != nullptr) {
-            // Map of required arity has been created concurrently
-            Lanes.beforeUnlockAllBut();
-            return;
+    /** @brief create the RecordMap for the given arity, unless it has been created concurrently. */
+    RecordMap& createMap(const std::size_t Arity) {
+        std::lock_guard<std::mutex> Lock(CreateMutex);
+        std::atomic<RecordMap*>& Slot = allocSlot(Arity);
+        RecordMap* Map = Slot.load(std::memory_order_relaxed);
+        if (Map == nullptr) {
+            Map = new GenericRecordMap(LaneCount, Arity);
+            Slot.store(Map, std::memory_order_release);
         }
-        Lanes.lockAllBut();
-
-        if (Arity >= Size) {
-            Size = Arity + 1;
-            Maps.reserve(Size);
-            Maps.resize(Size);
-        }
-        Maps[Arity] = new GenericRecordMap(Lanes.lanes(), Arity);
-
-        Lanes.beforeUnlockAllBut();
-        Lanes.unlockAllBut();
+        return *Map;
     }
 };
 
@@ -21,26 +21,50 @@
 #include "souffle/utility/StreamUtil.h"
 
 #include <algorithm>
+#include <cassert>
 #include <cstdlib>
 #include <deque>
 #include <initializer_list>
 #include <iostream>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace souffle {
 
+namespace details {
+
+/** Hash of a symbol, equal for a string and its view so that lookups do not build a string. */
+struct SymbolHash {
+    std::size_t operator()(std::string_view symbol) const {
+        return std::hash<std::string_view>{}(symbol);
+    }
+};
+
+/** Equality of symbols given as strings or views. */
+struct SymbolEqual {
+    bool operator()(std::string_view lhs, std::string_view rhs) const {
+        return lhs == rhs;
+    }
+};
+
+}  // namespace details
+
 /**
  * @class SymbolTableImpl
  *
  * Implementation of the symbol table.
+ *
+ * Decoding is wait-free. Symbols can be encoded from string views, in which
+ * case a string is only built when the symbol is new.
  */
-class SymbolTableImpl : public SymbolTable, protected FlyweightImpl<std::string> {
+class SymbolTableImpl : public SymbolTable,
+                        protected FlyweightImpl<std::string, details::SymbolHash, details::SymbolEqual> {
 private:
-    using Base = FlyweightImpl<std::string>;
+    using Base = FlyweightImpl<std::string, details::SymbolHash, details::SymbolEqual>;
 
 public:
     class IteratorImpl : public SymbolTableIteratorInterface, private Base::iterator {
@@ -116,6 +140,13 @@ public:
         return Base::fetch(index);
     }
 
+    void encode(span<const std::string_view> symbols, span<RamDomain> indices) override {
+        assert(symbols.size() == indices.size());
+        for (std::size_t i = 0; i < symbols.size(); ++i) {
+            indices[i] = static_cast<RamDomain>(Base::findOrInsert(symbols[i]).first);
+        }
+    }
+
     RamDomain unsafeEncode(const std::string& symbol) override {
         return encode(symbol);
     }
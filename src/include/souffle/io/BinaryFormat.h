@@ -0,0 +1,158 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file BinaryFormat.h
+ *
+ * Layout of the columnar binary fact format (IO=binary).
+ *
+ * A relation is stored in a relation file and a symbol dictionary file
+ * (the relation file name followed by ".symbols"). All integers are
+ * 64 bit and, like the tuple elements, stored in native byte order.
+ *
+ * Relation file:
+ *   magic            8 bytes, BinaryFormat::relationMagic
+ *   domain size      size of a RamDomain in bytes
+ *   arity            number of columns
+ *   rows             number of tuples
+ *   types            one type attribute character per column, padded to 8 bytes
+ *   columns          arity arrays of rows RamDomain values, one per column
+ *
+ * Symbol dictionary file:
+ *   magic            8 bytes, BinaryFormat::symbolMagic
+ *   count            number of symbols
+ *   offsets          count + 1 offsets of the symbols into the text
+ *   text             the concatenated symbols
+ *
+ * Symbol columns hold indices into the dictionary of the relation, so
+ * that only the distinct symbols are encoded when a relation is loaded.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#include <iterator>
+#endif
+
+namespace souffle {
+
+struct BinaryFormat {
+    static constexpr char relationMagic[8] = {'S', 'O', 'U', 'F', 'R', 'E', 'L', '1'};
+    static constexpr char symbolMagic[8] = {'S', 'O', 'U', 'F', 'S', 'Y', 'M', '1'};
+
+    /** Size of the fixed part of a header */
+    static constexpr std::size_t headerSize = 4 * sizeof(uint64_t);
+
+    /** Size of the type section for the given arity */
+    static std::size_t typesSize(std::size_t arity) {
+        return (arity + 7) & ~std::size_t(7);
+    }
+};
+
+/**
+ * A read-only view of a whole file, memory-mapped where supported. On Windows
+ * the file is read into a heap buffer instead, so its content counts towards
+ * the memory of the process.
+ */
+class MappedFile {
+public:
+    /** The expected pattern of accesses, which guides the read-ahead of the mapping */
+    enum class Access { Sequential, Random };
+
+    explicit MappedFile(const std::string& fileName, Access access = Access::Sequential) {
+#ifndef _WIN32
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+        struct stat info;
+        if (::fstat(fd, &info) == 0) {
+            length = static_cast<std::size_t>(info.st_size);
+            opened = true;
+            if (length > 0) {
+                void* address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (address == MAP_FAILED) {
+                    ::close(fd);
+                    throw std::runtime_error("Cannot map file " + fileName);
+                }
+                ::madvise(address, length, access == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+                start = static_cast<const char*>(address);
+            }
+        }
+        ::close(fd);
+#else
+        static_cast<void>(access);
+        std::ifstream file(fileName, std::ios::in | std::ios::binary);
+        if (!file.is_open()) {
+            return;
+        }
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        start = buffer.data();
+        length = buffer.size();
+        opened = true;
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() {
+#ifndef _WIN32
+        if (start != nullptr) {
+            ::munmap(const_cast<char*>(start), length);
+        }
+#endif
+    }
+
+    bool isOpen() const {
+        return opened;
+    }
+
+    const char* data() const {
+        return start;
+    }
+
+    std::size_t size() const {
+        return length;
+    }
+
+    /** Read the 64 bit integer at the given offset */
+    uint64_t word(std::size_t offset) const {
+        if (offset + sizeof(uint64_t) > length) {
+            throw std::invalid_argument("Unexpected end of binary file");
+        }
+        uint64_t value;
+        std::memcpy(&value, start + offset, sizeof(value));
+        return value;
+    }
+
+private:
+    const char* start = nullptr;
+    std::size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    std::vector<char> buffer;
+#endif
+};
+
+}  // namespace souffle
@@ -29,6 +29,8 @@
 #include <ostream>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace souffle {
@@ -39,9 +41,41 @@ protected:
             const std::map<std::string, std::string>& rwOperation, SymbolTable& symTab, RecordTable& recTab)
             : SerialisationStream(symTab, recTab, rwOperation) {}
 
+    /** Determines whether a relation accepts batches of consecutively stored tuples */
+    template <typename T, typename = void>
+    struct supportsBatch : std::false_type {};
+
+    template <typename T>
+    struct supportsBatch<T, std::void_t<decltype(std::declval<T&>().insertBatch(
+                                    std::declval<const RamDomain*>(), std::declval<std::size_t>()))>>
+            : std::true_type {};
+
 public:
     template <typename T>
     void readAll(T& relation) {
+        // streams of pre-encoded tuples provide them in blocks
+        const std::size_t width = typeAttributes.size();
+        std::vector<RamDomain> block;
+        if constexpr (supportsBatch<T>::value) {
+            // the blocks are handed over at once, so that empty indexes are built bottom-up from them
+            std::vector<RamDomain> all;
+            while (width > 0 && readNextBlock(block)) {
+                if (all.empty()) {
+                    all.swap(block);
+                } else {
+                    all.insert(all.end(), block.begin(), block.end());
+                }
+            }
+            if (!all.empty()) {
+                relation.insertBatch(all.data(), all.size() / width);
+            }
+        } else {
+            while (width > 0 && readNextBlock(block)) {
+                for (std::size_t i = 0; i < block.size(); i += width) {
+                    relation.insert(block.data() + i);
+                }
+            }
+        }
         while (const auto next = readNextTuple()) {
             const RamDomain* ramDomain = next.get();
             relation.insert(ramDomain);
@@ -381,6 +415,15 @@ protected:
     }
 
     virtual Own<RamDomain[]> readNextTuple() = 0;
+
+    /**
+     * Read the next block of tuples, stored consecutively.
+     *
+     * Returns false if no tuple was readable or the stream does not read blocks.
+     */
+    virtual bool readNextBlock(std::vector<RamDomain>& /* block */) {
+        return false;
+    }
 };
 
 class ReadStreamFactory {
@@ -0,0 +1,237 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file ReadStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/io/ReadStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include "souffle/utility/StringUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Reads a relation from the columnar binary format, see BinaryFormat.h.
+ *
+ * The files are memory-mapped, the symbols of the dictionary are encoded
+ * once, and the tuples are decoded in blocks straight from the columns.
+ */
+class ReadStreamBinary : public ReadStream {
+public:
+    /** Number of tuples decoded per block */
+    static constexpr std::size_t blockSize = 4096;
+
+    ReadStreamBinary(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable)
+            : ReadStream(rwOperation, symbolTable, recordTable), fileName(getFileName(rwOperation)),
+              relationFile(fileName), symbolFile(fileName + ".symbols") {
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (typeAttributes[i][0] == 'r' || typeAttributes[i][0] == '+') {
+                throw std::invalid_argument("Binary fact files do not support records and ADTs");
+            }
+        }
+        if (!relationFile.isOpen()) {
+            // suppress error message in case file cannot be open when flag -w is set
+            if (getOr(rwOperation, "no-warn", "false") != "true") {
+                throw std::invalid_argument("Cannot open fact file " + baseName(fileName) + "\n");
+            }
+            return;
+        }
+        try {
+            readHeader();
+            readSymbols();
+        } catch (std::exception& e) {
+            std::stringstream errorMessage;
+            errorMessage << e.what() << "\ncannot parse fact file " << baseName(fileName) << "!\n";
+            throw std::invalid_argument(errorMessage.str());
+        }
+    }
+
+    ~ReadStreamBinary() override = default;
+
+protected:
+    /**
+     * Read and return the next tuple.
+     *
+     * Returns nullptr if no tuple was readable.
+     * @return
+     */
+    Own<RamDomain[]> readNextTuple() override {
+        if (row >= rows) {
+            return nullptr;
+        }
+        Own<RamDomain[]> tuple = mk<RamDomain[]>(typeAttributes.size());
+        for (std::size_t column = 0; column < arity; ++column) {
+            tuple[column] = decode(column, columns[column][row]);
+        }
+        ++row;
+        return tuple;
+    }
+
+    bool readNextBlock(std::vector<RamDomain>& block) override {
+        if (row >= rows || arity == 0) {
+            return false;
+        }
+        const std::size_t width = typeAttributes.size();
+        const std::size_t count = std::min(blockSize, rows - row);
+        block.assign(count * width, 0);
+        for (std::size_t column = 0; column < arity; ++column) {
+            const RamDomain* values = columns[column] + row;
+            RamDomain* target = block.data() + column;
+            if (typeAttributes[column][0] == 's') {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i * width] = decode(column, values[i]);
+                }
+            } else {
+                for (std::size_t i = 0; i < count; ++i) {
+                    target[i * width] = values[i];
+                }
+            }
+        }
+        row += count;
+        return true;
+    }
+
+    /** Translate a stored value of a column into a value of this program */
+    RamDomain decode(std::size_t column, RamDomain value) const {
+        if (typeAttributes[column][0] != 's') {
+            return value;
+        }
+        const auto index = static_cast<std::size_t>(ramBitCast<RamUnsigned>(value));
+        if (index >= symbols.size()) {
+            throw std::invalid_argument("Symbol index out of range in fact file " + baseName(fileName));
+        }
+        return symbols[index];
+    }
+
+    void readHeader() {
+        if (relationFile.size() < BinaryFormat::headerSize ||
+                std::memcmp(relationFile.data(), BinaryFormat::relationMagic, 8) != 0) {
+            throw std::invalid_argument("Not a binary fact file");
+        }
+        if (relationFile.word(8) != sizeof(RamDomain)) {
+            throw std::invalid_argument("Binary fact file was written with a different RamDomain size");
+        }
+        if (relationFile.word(16) != arity) {
+            throw std::invalid_argument("Binary fact file has arity " +
+                                        std::to_string(relationFile.word(16)) + ", expected " +
+                                        std::to_string(arity));
+        }
+        rows = relationFile.word(24);
+
+        const char* types = relationFile.data() + BinaryFormat::headerSize;
+        const std::size_t start = BinaryFormat::headerSize + BinaryFormat::typesSize(arity);
+        if (relationFile.size() < start ||
+                (arity > 0 && (relationFile.size() - start) / sizeof(RamDomain) / arity < rows)) {
+            throw std::invalid_argument("Unexpected end of binary file");
+        }
+        for (std::size_t column = 0; column < arity; ++column) {
+            if (types[column] != typeAttributes[column][0]) {
+                throw std::invalid_argument("Type of column " + std::to_string(column) +
+                                            " does not match the relation declaration");
+            }
+            columns.push_back(reinterpret_cast<const RamDomain*>(
+                    relationFile.data() + start + column * rows * sizeof(RamDomain)));
+        }
+    }
+
+    void readSymbols() {
+        const bool hasSymbols = std::any_of(typeAttributes.begin(), typeAttributes.begin() + arity,
+                [](const std::string& type) { return type[0] == 's'; });
+        if (!hasSymbols || rows == 0) {
+            return;
+        }
+        if (!symbolFile.isOpen()) {
+            throw std::invalid_argument("Cannot open symbol file " + baseName(fileName) + ".symbols");
+        }
+        if (symbolFile.size() < 2 * sizeof(uint64_t) ||
+                std::memcmp(symbolFile.data(), BinaryFormat::symbolMagic, 8) != 0) {
+            throw std::invalid_argument("Not a binary symbol file");
+        }
+        const std::size_t count = symbolFile.word(8);
+        const std::size_t text = 2 * sizeof(uint64_t) + (count + 1) * sizeof(uint64_t);
+        if (symbolFile.size() < text) {
+            throw std::invalid_argument("Unexpected end of binary symbol file");
+        }
+
+        // encode each distinct symbol once, straight from the mapped file
+        std::vector<std::string_view> views;
+        views.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            const std::size_t begin = symbolFile.word(2 * sizeof(uint64_t) + i * sizeof(uint64_t));
+            const std::size_t end = symbolFile.word(2 * sizeof(uint64_t) + (i + 1) * sizeof(uint64_t));
+            if (begin > end || text + end > symbolFile.size()) {
+                throw std::invalid_argument("Unexpected end of binary symbol file");
+            }
+            views.emplace_back(symbolFile.data() + text + begin, end - begin);
+        }
+        symbols.resize(count);
+        symbolTable.encode(views, symbols);
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return input filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".bin");
+        if (!isAbsolute(name)) {
+            name = getOr(rwOperation, "fact-dir", ".") + pathSeparator + name;
+        }
+        return name;
+    }
+
+    const std::string fileName;
+    MappedFile relationFile;
+    MappedFile symbolFile;
+    std::vector<const RamDomain*> columns;
+    std::vector<RamDomain> symbols;
+    std::size_t rows = 0;
+    std::size_t row = 0;
+};
+
+class ReadFileBinaryFactory : public ReadStreamFactory {
+public:
+    Own<ReadStream> getReader(const std::map<std::string, std::string>& rwOperation, SymbolTable& symbolTable,
+            RecordTable& recordTable) override {
+        return mk<ReadStreamBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+
+    ~ReadFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
@@ -20,6 +20,7 @@
 #include "souffle/io/ReadStream.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
 
 #ifdef USE_LIBZ
@@ -32,11 +33,13 @@
 #include <cassert>
 #include <cstddef>
 #include <cstdint>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
 #include <sstream>
 #include <stdexcept>
+#include <streambuf>
 #include <string>
 #include <vector>
 
@@ -44,12 +47,19 @@ namespace souffle {
 
 class ReadStreamCSV : public ReadStream {
 public:
+    /** Minimal number of characters of the input parsed by one thread */
+    static constexpr std::size_t minChunkSize = 1 << 20;
+
+    /** Number of chunks per thread read from the input at a time */
+    static constexpr std::size_t chunksPerThread = 4;
+
     ReadStreamCSV(std::istream& file, const std::map<std::string, std::string>& rwOperation,
             SymbolTable& symbolTable, RecordTable& recordTable)
             : ReadStream(rwOperation, symbolTable, recordTable),
               rfc4180(getOr(rwOperation, "rfc4180", "false") == std::string("true")),
               delimiter(getOr(rwOperation, "delimiter", (rfc4180 ? "," : "\t"))), file(file), lineNumber(0),
-              inputMap(getInputColumnMap(rwOperation, static_cast<unsigned int>(arity))) {
+              inputMap(getInputColumnMap(rwOperation, static_cast<unsigned int>(arity))),
+              options(rwOperation) {
         if (rfc4180 && delimiter.find('"') != std::string::npos) {
             std::stringstream errorMessage;
             errorMessage << "CSV delimiter cannot contain '\"' character when rfc4180 is enabled.";
@@ -63,6 +73,104 @@ public:
     }
 
 protected:
+    /** A read-only stream buffer over a range of characters */
+    class CharRangeBuffer : public std::streambuf {
+    public:
+        CharRangeBuffer(char* begin, char* end) {
+            setg(begin, begin, end);
+        }
+    };
+
+    /**
+     * Read the input in windows of a few chunks of whole lines each, and parse
+     * the chunks of a window on all threads; each call returns the tuples of
+     * the next chunk. Only one window is held in memory at a time.
+     *
+     * Quoted fields of RFC 4180 may span several lines, hence such input is
+     * read tuple by tuple.
+     */
+    bool readNextBlock(std::vector<RamDomain>& block) override {
+        if (rfc4180) {
+            return false;
+        }
+        if (nextChunk == chunks.size() && !readChunks()) {
+            return false;
+        }
+        block.clear();
+        block.swap(chunks[nextChunk++]);
+        return true;
+    }
+
+    /**
+     * Read the next window of chunks and parse it in parallel.
+     *
+     * Returns false if the input is exhausted.
+     */
+    bool readChunks() {
+        std::size_t threads = 1;
+#ifdef _OPENMP
+        threads = static_cast<std::size_t>(omp_get_max_threads());
+#endif
+        // read the window, completed up to the end of its last line
+        std::string text(chunksPerThread * threads * minChunkSize, '\0');
+        file.read(text.data(), static_cast<std::streamsize>(text.size()));
+        text.resize(static_cast<std::size_t>(file.gcount()));
+        if (file && text.back() != '\n') {
+            std::string rest;
+            if (getline(file, rest)) {
+                text += rest;
+                text += file.eof() ? "" : "\n";
+            }
+        }
+        chunks.clear();
+        nextChunk = 0;
+        if (text.empty()) {
+            return false;
+        }
+
+        // split at line boundaries and determine the line number preceding each chunk
+        std::vector<std::size_t> bounds = {0};
+        std::vector<std::size_t> lines = {lineNumber};
+        while (bounds.back() < text.size()) {
+            std::size_t end = std::min(bounds.back() + minChunkSize, text.size());
+            if (end < text.size()) {
+                end = std::min(text.find('\n', end), text.size() - 1) + 1;
+            }
+            const auto newlines = std::count(text.begin() + bounds.back(), text.begin() + end, '\n');
+            lines.push_back(lines.back() + static_cast<std::size_t>(newlines));
+            bounds.push_back(end);
+        }
+
+        const std::size_t width = typeAttributes.size();
+        const std::size_t count = bounds.size() - 1;
+        chunks.resize(count);
+        std::vector<std::exception_ptr> errors(count);
+        PARALLEL_START
+            pfor(std::size_t i = 0; i < count; ++i) {
+                try {
+                    CharRangeBuffer range(text.data() + bounds[i], text.data() + bounds[i + 1]);
+                    std::istream input(&range);
+                    ReadStreamCSV reader(input, options, symbolTable, recordTable);
+                    reader.lineNumber = lines[i];
+                    while (const auto tuple = reader.readNextTuple()) {
+                        chunks[i].insert(chunks[i].end(), tuple.get(), tuple.get() + width);
+                    }
+                } catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        PARALLEL_END
+
+        // report the error of the first erroneous line
+        for (const auto& error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        lineNumber = lines.back();
+        return true;
+    }
+
     bool readNextLine(std::string& line, bool& isCRLF) {
         if (!getline(file, line)) {
             return false;
@@ -324,6 +432,9 @@ protected:
     std::istream& file;
     std::size_t lineNumber;
     std::map<int, int> inputMap;
+    const std::map<std::string, std::string> options;
+    std::vector<std::vector<RamDomain>> chunks;
+    std::size_t nextChunk = 0;
 };
 
 class ReadFileCSV : public ReadStreamCSV {
@@ -363,6 +474,17 @@ public:
         }
     }
 
+    bool readNextBlock(std::vector<RamDomain>& block) override {
+        try {
+            return ReadStreamCSV::readNextBlock(block);
+        } catch (std::exception& e) {
+            std::stringstream errorMessage;
+            errorMessage << e.what();
+            errorMessage << "cannot parse fact file " << baseName << "!\n";
+            throw std::invalid_argument(errorMessage.str());
+        }
+    }
+
     ~ReadFileCSV() override = default;
 
 protected:
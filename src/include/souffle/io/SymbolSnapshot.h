@@ -0,0 +1,170 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file SymbolSnapshot.h
+ *
+ * Saves a symbol table to a file and restores it in a later run, so that
+ * the numbers of the symbols stay the same across runs.
+ *
+ * A snapshot is a symbol dictionary in the binary fact format (see
+ * BinaryFormat.h) whose i-th symbol is the symbol numbered i. Loading maps
+ * the file read-only and encodes its symbols, which copies them into the
+ * symbol table; the mapping is released once they are encoded. A snapshot is
+ * replaced as a whole when the extended table is saved.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <unordered_set>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Encode the symbols of a snapshot in order. The symbol table must be empty,
+ * or start with the same symbols as the snapshot.
+ */
+inline void loadSymbolSnapshot(SymbolTable& symbolTable, const std::string& fileName) {
+    MappedFile file(fileName);
+    if (!file.isOpen()) {
+        throw std::invalid_argument("Cannot open symbol snapshot " + fileName);
+    }
+    if (file.size() < 2 * sizeof(uint64_t) ||
+            std::memcmp(file.data(), BinaryFormat::symbolMagic, sizeof(BinaryFormat::symbolMagic)) != 0) {
+        throw std::invalid_argument("Not a symbol snapshot: " + fileName);
+    }
+    const std::size_t count = file.word(8);
+    const std::size_t text = 2 * sizeof(uint64_t) + (count + 1) * sizeof(uint64_t);
+    if (file.size() < text) {
+        throw std::invalid_argument("Unexpected end of symbol snapshot " + fileName);
+    }
+
+    std::vector<std::string_view> symbols;
+    symbols.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const std::size_t begin = file.word(2 * sizeof(uint64_t) + i * sizeof(uint64_t));
+        const std::size_t end = file.word(2 * sizeof(uint64_t) + (i + 1) * sizeof(uint64_t));
+        if (begin > end || text + end > file.size()) {
+            throw std::invalid_argument("Unexpected end of symbol snapshot " + fileName);
+        }
+        symbols.emplace_back(file.data() + text + begin, end - begin);
+    }
+
+    std::vector<RamDomain> indices(count);
+    symbolTable.encode(symbols, indices);
+    for (std::size_t i = 0; i < count; ++i) {
+        if (indices[i] != static_cast<RamDomain>(i)) {
+            throw std::invalid_argument(
+                    "Symbol snapshot " + fileName + " does not match the symbols encoded before it");
+        }
+    }
+}
+
+/**
+ * Create a new file next to the given one, under a name no other file has, and
+ * return its name.
+ */
+inline std::string createSiblingFile(const std::string& fileName) {
+    std::random_device random;
+    while (true) {
+        const std::string candidate = fileName + "." + std::to_string(random()) + ".tmp";
+        if (std::FILE* f = std::fopen(candidate.c_str(), "wbx")) {
+            std::fclose(f);
+            return candidate;
+        }
+        if (errno != EEXIST) {
+            throw std::invalid_argument("Cannot write symbol snapshot " + fileName);
+        }
+    }
+}
+
+/**
+ * Write all symbols of the table to a snapshot. The file is replaced at once, so
+ * that a concurrent reader sees either the old or the new snapshot. Concurrent
+ * writers each write their own temporary file, the last rename wins.
+ */
+inline void saveSymbolSnapshot(const SymbolTable& symbolTable, const std::string& fileName) {
+    std::vector<const std::string*> symbols;
+    std::unordered_set<std::string_view> present;
+    for (const auto& [symbol, index] : symbolTable) {
+        if (index >= symbols.size()) {
+            symbols.resize(index + 1, nullptr);
+        }
+        symbols[index] = &symbol;
+        present.insert(symbol);
+    }
+
+    // Numbers reserved by concurrent insertions may be left unused. They are
+    // filled with fresh symbols, so that loading the snapshot keeps the numbers.
+    std::vector<std::string> fillers;
+    fillers.reserve(symbols.size());
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        if (symbols[i] == nullptr) {
+            std::string filler = "<unused symbol " + std::to_string(i) + ">";
+            while (present.count(filler) > 0) {
+                filler += "'";
+            }
+            fillers.push_back(filler);
+            symbols[i] = &fillers.back();
+        }
+    }
+
+    const std::string temporary = createSiblingFile(fileName);
+    {
+        std::ofstream file(temporary, std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            std::filesystem::remove(temporary);
+            throw std::invalid_argument("Cannot write symbol snapshot " + fileName);
+        }
+        auto writeWord = [&](uint64_t value) {
+            file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        };
+        file.write(BinaryFormat::symbolMagic, sizeof(BinaryFormat::symbolMagic));
+        writeWord(symbols.size());
+        uint64_t offset = 0;
+        writeWord(offset);
+        for (const std::string* symbol : symbols) {
+            offset += symbol->size();
+            writeWord(offset);
+        }
+        for (const std::string* symbol : symbols) {
+            file.write(symbol->data(), symbol->size());
+        }
+        file.close();
+        if (!file) {
+            std::filesystem::remove(temporary);
+            throw std::invalid_argument("Cannot write symbol snapshot " + fileName);
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, fileName, error);
+    if (error) {
+        std::filesystem::remove(temporary, error);
+        throw std::invalid_argument("Cannot write symbol snapshot " + fileName);
+    }
+}
+
+}  // namespace souffle
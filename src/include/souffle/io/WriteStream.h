@@ -42,17 +42,17 @@ public:
     template <typename T>
     void writeAll(const T& relation) {
         if (summary) {
-            return writeSize(relation.size());
-        }
-        if (arity == 0) {
+            writeSize(relation.size());
+        } else if (arity == 0) {
             if (relation.begin() != relation.end()) {
                 writeNullary();
             }
-            return;
-        }
-        for (const auto& current : relation) {
-            writeNext(current);
+        } else {
+            for (const auto& current : relation) {
+                writeNext(current);
+            }
         }
+        finish();
     }
 
     template <typename T>
@@ -69,6 +69,9 @@ protected:
         fatal("attempting to print size of a write operation");
     }
 
+    /** Completes the output once all tuples are written, throwing if it cannot be stored */
+    virtual void finish() {}
+
     template <typename Tuple>
     void writeNext(const Tuple tuple) {
         using tcb::make_span;
@@ -0,0 +1,182 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file WriteStreamBinary.h
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/RecordTable.h"
+#include "souffle/SymbolTable.h"
+#include "souffle/io/BinaryFormat.h"
+#include "souffle/io/WriteStream.h"
+#include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/FileUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace souffle {
+
+/**
+ * Writes a relation in the columnar binary format, see BinaryFormat.h.
+ *
+ * The columns are collected in memory and written once the relation is
+ * complete, together with the dictionary of the symbols they contain.
+ */
+class WriteFileBinary : public WriteStream {
+public:
+    WriteFileBinary(const std::map<std::string, std::string>& rwOperation, const SymbolTable& symbolTable,
+            const RecordTable& recordTable)
+            : WriteStream(rwOperation, symbolTable, recordTable), fileName(getFileName(rwOperation)),
+              columns(arity) {
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (typeAttributes[i][0] == 'r' || typeAttributes[i][0] == '+') {
+                throw std::invalid_argument("Binary fact files do not support records and ADTs");
+            }
+        }
+    }
+
+    ~WriteFileBinary() override = default;
+
+protected:
+    void finish() override {
+        writeRelation();
+        writeSymbols();
+    }
+
+    void writeNullary() override {
+        ++rows;
+    }
+
+    void writeNextTuple(const RamDomain* tuple) override {
+        for (std::size_t column = 0; column < arity; ++column) {
+            RamDomain value = tuple[column];
+            if (typeAttributes[column][0] == 's') {
+                value = getSymbolIndex(value);
+            }
+            columns[column].push_back(value);
+        }
+        ++rows;
+    }
+
+    /** Get the index of a symbol in the dictionary of the relation */
+    RamDomain getSymbolIndex(RamDomain symbol) {
+        auto [pos, inserted] = symbolIndex.emplace(symbol, static_cast<RamDomain>(symbols.size()));
+        if (inserted) {
+            symbols.push_back(symbol);
+        }
+        return pos->second;
+    }
+
+    static void writeWord(std::ofstream& file, uint64_t value) {
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+
+    static std::ofstream openFile(const std::string& name) {
+        std::ofstream file(name, std::ios::out | std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open binary fact file " + name);
+        }
+        return file;
+    }
+
+    static void closeFile(std::ofstream& file, const std::string& name) {
+        file.close();
+        if (!file) {
+            throw std::runtime_error("Cannot write binary fact file " + name);
+        }
+    }
+
+    void writeRelation() {
+        std::ofstream file = openFile(fileName);
+        file.write(BinaryFormat::relationMagic, sizeof(BinaryFormat::relationMagic));
+        writeWord(file, sizeof(RamDomain));
+        writeWord(file, arity);
+        writeWord(file, rows);
+
+        std::vector<char> types(BinaryFormat::typesSize(arity), '\0');
+        for (std::size_t column = 0; column < arity; ++column) {
+            types[column] = typeAttributes[column][0];
+        }
+        file.write(types.data(), types.size());
+
+        for (const auto& column : columns) {
+            file.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(RamDomain));
+        }
+        closeFile(file, fileName);
+    }
+
+    void writeSymbols() {
+        const std::string symbolsName = fileName + ".symbols";
+        std::ofstream file = openFile(symbolsName);
+        file.write(BinaryFormat::symbolMagic, sizeof(BinaryFormat::symbolMagic));
+        writeWord(file, symbols.size());
+
+        std::vector<std::string> text;
+        text.reserve(symbols.size());
+        uint64_t offset = 0;
+        writeWord(file, offset);
+        for (RamDomain symbol : symbols) {
+            text.push_back(symbolTable.decode(symbol));
+            offset += text.back().size();
+            writeWord(file, offset);
+        }
+        for (const auto& symbol : text) {
+            file.write(symbol.data(), symbol.size());
+        }
+        closeFile(file, symbolsName);
+    }
+
+    /**
+     * Return given filename or construct from relation name.
+     * Default name is [configured path]/[relation name].bin
+     *
+     * @param rwOperation map of IO configuration options
+     * @return output filename
+     */
+    static std::string getFileName(const std::map<std::string, std::string>& rwOperation) {
+        auto name = getOr(rwOperation, "filename", rwOperation.at("name") + ".bin");
+        if (!isAbsolute(name)) {
+            name = getOr(rwOperation, "output-dir", ".") + pathSeparator + name;
+        }
+        return name;
+    }
+
+    const std::string fileName;
+    std::vector<std::vector<RamDomain>> columns;
+    std::size_t rows = 0;
+    std::unordered_map<RamDomain, RamDomain> symbolIndex;
+    std::vector<RamDomain> symbols;
+};
+
+class WriteFileBinaryFactory : public WriteStreamFactory {
+public:
+    Own<WriteStream> getWriter(const std::map<std::string, std::string>& rwOperation,
+            const SymbolTable& symbolTable, const RecordTable& recordTable) override {
+        return mk<WriteFileBinary>(rwOperation, symbolTable, recordTable);
+    }
+
+    const std::string& getName() const override {
+        static const std::string name = "binary";
+        return name;
+    }
+
+    ~WriteFileBinaryFactory() override = default;
+};
+
+} /* namespace souffle */
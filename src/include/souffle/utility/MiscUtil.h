@@ -33,6 +33,7 @@
 #define NOMINMAX
 #define NOGDI
 #include <fcntl.h>
+#include <intrin.h>
 #include <io.h>
 #include <stdlib.h>
 #include <windows.h>
@@ -45,10 +46,17 @@
  * For ctz and ctzll, BitScanForward and BitScanForward64 are the respective
  * windows equivalents.  However ctz is used in a constexpr context, and we can't
  * use BitScanForward, so we implement it ourselves.
+ *
+ * For clzll, __lzcnt64 is the windows equivalent.
  */
 #define __builtin_popcountll __popcnt64
 
 #if defined(_MSC_VER)
+// return the number of leading zeroes in value.
+inline int __builtin_clzll(unsigned long long value) {
+    return static_cast<int>(__lzcnt64(value));
+}
+
 // return the number of trailing zeroes in value, or 32 if value is zero.
 inline constexpr unsigned long __builtin_ctz(unsigned long value) {
     unsigned long trailing_zeroes = 0;
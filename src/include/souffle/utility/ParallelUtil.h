@@ -17,11 +17,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <new>
+#include <vector>
 
 // https://bugs.llvm.org/show_bug.cgi?id=41423
 #if defined(__cpp_lib_hardware_interference_size) && (__cpp_lib_hardware_interference_size != 201703L)
@@ -829,6 +832,7 @@ struct ConcurrentLanes : protected SeqConcurrentLanes {
     using lane_id = SeqConcurrentLanes::lane_id;
     using unique_lock_type = SeqConcurrentLanes::unique_lock_type;
 
+    using Base::guard;
     using Base::lanes;
     using Base::setNumLanes;
 
@@ -881,4 +885,78 @@ inline Lock& getOutputLock() {
     return outputLock;
 }
 
+/**
+ * Runs a DAG of tasks, where task i may only start once all tasks listed in
+ * predecessors[i] have completed. Tasks that become ready at the same time are
+ * executed concurrently.
+ *
+ * The predecessors of a task must have smaller indices than the task itself,
+ * i.e., the index order is a valid sequential schedule.
+ *
+ * Tasks may open parallel regions on their own. The threads of the enclosing
+ * team are divided among the tasks running when a task starts.
+ */
+template <typename Task>
+void runTaskGraph(const std::vector<std::vector<std::size_t>>& predecessors, Task&& task) {
+    const std::size_t numTasks = predecessors.size();
+#if defined(_OPENMP) && _OPENMP >= 200805
+    const int numThreads = omp_get_max_threads();
+    if (numThreads <= 1 || numTasks <= 1) {
+        for (std::size_t i = 0; i < numTasks; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::vector<std::vector<std::size_t>> successors(numTasks);
+    auto pending = std::make_unique<std::atomic<std::size_t>[]>(numTasks);
+    for (std::size_t i = 0; i < numTasks; ++i) {
+        pending[i].store(predecessors[i].size(), std::memory_order_relaxed);
+        for (std::size_t pred : predecessors[i]) {
+            assert(pred < i && "predecessors must precede their successors");
+            successors[pred].push_back(i);
+        }
+    }
+
+    // nested parallel regions inside of tasks need an additional active level
+    const int maxActiveLevels = omp_get_max_active_levels();
+    omp_set_max_active_levels(std::max(maxActiveLevels, omp_get_level() + 2));
+
+    std::atomic<int> running{0};
+    std::function<void(std::size_t)> spawn = [&](std::size_t i) {
+#pragma omp task default(shared) firstprivate(i)
+        {
+            const int active = ++running;
+            omp_set_num_threads(std::max(1, numThreads / active));
+            task(i);
+            --running;
+            for (std::size_t succ : successors[i]) {
+                if (--pending[succ] == 0) {
+                    spawn(succ);
+                }
+            }
+        }
+    };
+
+#pragma omp parallel
+    {
+#pragma omp single
+        {
+            for (std::size_t i = 0; i < numTasks; ++i) {
+                if (predecessors[i].empty()) {
+                    spawn(i);
+                }
+            }
+        }
+    }
+
+    omp_set_max_active_levels(maxActiveLevels);
+#else
+    // sequential execution in index order
+    for (std::size_t i = 0; i < numTasks; ++i) {
+        task(i);
+    }
+#endif
+}
+
 }  // namespace souffle
@@ -0,0 +1,757 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file RegexUtil.h
+ *
+ * Linear-time regular expression matching for the match functor.
+ *
+ * Patterns are parsed with the ECMAScript grammar of std::regex. The regular
+ * fragment of the grammar is compiled into a Thompson automaton that is
+ * simulated in time linear in the length of the text. Patterns outside of
+ * this fragment (e.g. back-references or look-aheads) fall back to std::regex,
+ * which also reports malformed patterns by throwing a std::regex_error.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/SymbolTable.h"
+#include <atomic>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <regex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle {
+
+namespace details {
+
+/**
+ * Parser for the regular fragment of the ECMAScript grammar.
+ *
+ * The parser produces an abstract syntax tree that is compiled into a program
+ * for a Pike-style virtual machine without captures. Parsing fails for any
+ * construct outside of the supported fragment or whose meaning differs
+ * between standard library implementations; the caller then falls back to
+ * std::regex.
+ */
+class RegexCompiler {
+public:
+    /** Set of bytes matched by a single transition */
+    using ByteSet = std::bitset<256>;
+
+    /** Zero-width assertions */
+    enum class Assertion { Begin, End, WordBoundary, NotWordBoundary };
+
+    /** Opcodes of the automaton */
+    enum class Opcode { Set, Assert, Split, Jump, Match };
+
+    /** An instruction of the automaton */
+    struct Instruction {
+        Opcode op;
+        std::size_t x;  // < byte set, assertion, or first target
+        std::size_t y;  // < second target of a split
+    };
+
+    /** Maximal number of instructions of a compiled pattern */
+    static constexpr std::size_t maxProgramSize = 1 << 16;
+
+    /** Maximal bound of a counted repetition */
+    static constexpr std::size_t maxRepetition = 1000;
+
+    /** Maximal nesting depth of groups */
+    static constexpr std::size_t maxDepth = 256;
+
+    explicit RegexCompiler(const std::string& pattern) : pattern(pattern) {}
+
+    /**
+     * Compile the pattern into a program and the byte sets it refers to.
+     *
+     * @return false if the pattern is not in the supported fragment
+     */
+    bool compile(std::vector<Instruction>& program, std::vector<ByteSet>& sets) {
+        Ast ast;
+        if (!parseAlternation(ast, 0) || pos != pattern.size()) {
+            return false;
+        }
+        program.clear();
+        sets = std::move(byteSets);
+        if (!emit(ast, program)) {
+            return false;
+        }
+        program.push_back({Opcode::Match, 0, 0});
+        return true;
+    }
+
+    /** Whether a byte is a word character in the sense of \w */
+    static bool isWord(unsigned char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+    }
+
+private:
+    enum class Kind { Empty, Set, Assert, Concat, Alternation, Repeat };
+
+    static constexpr std::size_t unbounded = static_cast<std::size_t>(-1);
+
+    struct Ast {
+        Kind kind = Kind::Empty;
+        std::size_t value = 0;  // < byte set or assertion
+        std::size_t min = 0;
+        std::size_t max = 0;
+        std::vector<Ast> children;
+    };
+
+    bool atEnd() const {
+        return pos >= pattern.size();
+    }
+
+    char peek() const {
+        return pattern[pos];
+    }
+
+    std::size_t addSet(const ByteSet& set) {
+        byteSets.push_back(set);
+        return byteSets.size() - 1;
+    }
+
+    static ByteSet single(unsigned char c) {
+        ByteSet set;
+        set.set(c);
+        return set;
+    }
+
+    /** Byte set of the class escapes \d, \w, \s and their complements */
+    static std::optional<ByteSet> classEscape(char c) {
+        ByteSet set;
+        switch (c) {
+            case 'd':
+            case 'D':
+                for (unsigned char b = '0'; b <= '9'; ++b) {
+                    set.set(b);
+                }
+                break;
+            case 'w':
+            case 'W':
+                for (std::size_t b = 0; b < 256; ++b) {
+                    set[b] = isWord(static_cast<unsigned char>(b));
+                }
+                break;
+            case 's':
+            case 'S':
+                for (unsigned char b : {' ', '\t', '\n', '\v', '\f', '\r'}) {
+                    set.set(b);
+                }
+                break;
+            default: return std::nullopt;
+        }
+        if (c == 'D' || c == 'W' || c == 'S') {
+            set.flip();
+        }
+        return set;
+    }
+
+    /** Character denoted by an escape, if it denotes a single character */
+    static std::optional<unsigned char> charEscape(char c, bool inBracket) {
+        switch (c) {
+            case 'n': return '\n';
+            case 't': return '\t';
+            case 'r': return '\r';
+            case 'f': return '\f';
+            case 'v': return '\v';
+            case '0': return '\0';
+            case 'b': return inBracket ? std::optional<unsigned char>('\b') : std::nullopt;
+            default: break;
+        }
+        // identity escapes of syntax characters
+        const std::string syntax = "^$\\.*+?()[]{}|/-";
+        if (syntax.find(c) != std::string::npos) {
+            return static_cast<unsigned char>(c);
+        }
+        return std::nullopt;
+    }
+
+    bool parseAlternation(Ast& ast, std::size_t depth) {
+        if (depth > maxDepth) {
+            return false;
+        }
+        Ast alternative;
+        if (!parseConcat(alternative, depth)) {
+            return false;
+        }
+        if (atEnd() || peek() != '|') {
+            ast = std::move(alternative);
+            return true;
+        }
+        ast.kind = Kind::Alternation;
+        ast.children.push_back(std::move(alternative));
+        while (!atEnd() && peek() == '|') {
+            ++pos;
+            Ast next;
+            if (!parseConcat(next, depth)) {
+                return false;
+            }
+            ast.children.push_back(std::move(next));
+        }
+        return true;
+    }
+
+    bool parseConcat(Ast& ast, std::size_t depth) {
+        ast.kind = Kind::Concat;
+        while (!atEnd() && peek() != '|') {
+            if (peek() == ')') {
+                // closing parenthesis is handled by the enclosing group
+                return depth > 0;
+            }
+            Ast atom;
+            if (!parseAtom(atom, depth) || !parseQuantifier(atom)) {
+                return false;
+            }
+            ast.children.push_back(std::move(atom));
+        }
+        return true;
+    }
+
+    bool parseAtom(Ast& ast, std::size_t depth) {
+        const char c = pattern[pos++];
+        switch (c) {
+            case '(': {
+                if (!atEnd() && peek() == '?') {
+                    // only non-capturing groups are regular
+                    if (pos + 1 >= pattern.size() || pattern[pos + 1] != ':') {
+                        return false;
+                    }
+                    pos += 2;
+                }
+                if (!parseAlternation(ast, depth + 1) || atEnd() || peek() != ')') {
+                    return false;
+                }
+                ++pos;
+                return true;
+            }
+            case '^':
+            case '$':
+                ast.kind = Kind::Assert;
+                ast.value = static_cast<std::size_t>(c == '^' ? Assertion::Begin : Assertion::End);
+                return true;
+            case '.': {
+                ByteSet set;
+                set.set();
+                set.reset('\n');
+                set.reset('\r');
+                ast.kind = Kind::Set;
+                ast.value = addSet(set);
+                return true;
+            }
+            case '[': return parseBracket(ast);
+            case '\\': {
+                if (atEnd()) {
+                    return false;
+                }
+                const char e = pattern[pos++];
+                if (e == 'b' || e == 'B') {
+                    ast.kind = Kind::Assert;
+                    ast.value = static_cast<std::size_t>(
+                            e == 'b' ? Assertion::WordBoundary : Assertion::NotWordBoundary);
+                    return true;
+                }
+                if (auto set = classEscape(e)) {
+                    ast.kind = Kind::Set;
+                    ast.value = addSet(*set);
+                    return true;
+                }
+                if (auto ch = charEscape(e, false)) {
+                    ast.kind = Kind::Set;
+                    ast.value = addSet(single(*ch));
+                    return true;
+                }
+                return false;
+            }
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+            case '}':
+            case ']': return false;
+            default:
+                ast.kind = Kind::Set;
+                ast.value = addSet(single(static_cast<unsigned char>(c)));
+                return true;
+        }
+    }
+
+    /** Parse the bracket expression following an opening bracket */
+    bool parseBracket(Ast& ast) {
+        ByteSet set;
+        bool negated = false;
+        if (!atEnd() && peek() == '^') {
+            negated = true;
+            ++pos;
+        }
+        if (!atEnd() && peek() == ']') {
+            // empty classes are treated differently across implementations
+            return false;
+        }
+        while (true) {
+            if (atEnd()) {
+                return false;
+            }
+            char c = pattern[pos++];
+            if (c == ']') {
+                break;
+            }
+            if (c == '[' || c == '-') {
+                return false;
+            }
+            unsigned char lower = static_cast<unsigned char>(c);
+            if (c == '\\') {
+                if (atEnd()) {
+                    return false;
+                }
+                const char e = pattern[pos++];
+                if (auto cls = classEscape(e)) {
+                    if (!atEnd() && peek() == '-') {
+                        return false;
+                    }
+                    set |= *cls;
+                    continue;
+                }
+                auto ch = charEscape(e, true);
+                if (!ch) {
+                    return false;
+                }
+                lower = *ch;
+            }
+            unsigned char upper = lower;
+            if (!atEnd() && peek() == '-') {
+                ++pos;
+                if (atEnd() || peek() == ']' || peek() == '[') {
+                    return false;
+                }
+                c = pattern[pos++];
+                upper = static_cast<unsigned char>(c);
+                if (c == '\\') {
+                    auto ch = atEnd() ? std::nullopt : charEscape(pattern[pos++], true);
+                    if (!ch) {
+                        return false;
+                    }
+                    upper = *ch;
+                }
+                // the order of non-ASCII bytes depends on the signedness of char
+                if (upper < lower || upper >= 0x80) {
+                    return false;
+                }
+            }
+            for (std::size_t b = lower; b <= upper; ++b) {
+                set.set(b);
+            }
+        }
+        if (negated) {
+            set.flip();
+        }
+        ast.kind = Kind::Set;
+        ast.value = addSet(set);
+        return true;
+    }
+
+    bool parseNumber(std::size_t& value) {
+        const std::size_t start = pos;
+        value = 0;
+        while (!atEnd() && peek() >= '0' && peek() <= '9') {
+            value = value * 10 + static_cast<std::size_t>(peek() - '0');
+            if (value > maxRepetition) {
+                return false;
+            }
+            ++pos;
+        }
+        return pos > start;
+    }
+
+    bool parseQuantifier(Ast& atom) {
+        if (atEnd()) {
+            return true;
+        }
+        std::size_t min = 0;
+        std::size_t max = 0;
+        switch (peek()) {
+            case '*': max = unbounded; break;
+            case '+':
+                min = 1;
+                max = unbounded;
+                break;
+            case '?': max = 1; break;
+            case '{': {
+                ++pos;
+                if (!parseNumber(min)) {
+                    return false;
+                }
+                max = min;
+                if (!atEnd() && peek() == ',') {
+                    ++pos;
+                    max = unbounded;
+                    if (!atEnd() && peek() != '}' && !parseNumber(max)) {
+                        return false;
+                    }
+                }
+                if (atEnd() || peek() != '}' || max < min) {
+                    return false;
+                }
+                break;
+            }
+            default: return true;
+        }
+        ++pos;
+        if (atom.kind == Kind::Assert) {
+            return false;
+        }
+        // laziness does not matter for a full match
+        if (!atEnd() && peek() == '?') {
+            ++pos;
+        }
+        if (!atEnd() && (peek() == '*' || peek() == '+' || peek() == '?' || peek() == '{')) {
+            return false;
+        }
+        Ast repeat;
+        repeat.kind = Kind::Repeat;
+        repeat.min = min;
+        repeat.max = max;
+        repeat.children.push_back(std::move(atom));
+        atom = std::move(repeat);
+        return true;
+    }
+
+    std::size_t push(std::vector<Instruction>& program, Opcode op, std::size_t x = 0, std::size_t y = 0) {
+        program.push_back({op, x, y});
+        return program.size() - 1;
+    }
+
+    bool emit(const Ast& ast, std::vector<Instruction>& program) {
+        if (program.size() > maxProgramSize) {
+            return false;
+        }
+        switch (ast.kind) {
+            case Kind::Empty: return true;
+            case Kind::Set: push(program, Opcode::Set, ast.value); return true;
+            case Kind::Assert: push(program, Opcode::Assert, ast.value); return true;
+            case Kind::Concat:
+                for (const auto& child : ast.children) {
+                    if (!emit(child, program)) {
+                        return false;
+                    }
+                }
+                return true;
+            case Kind::Alternation: {
+                std::vector<std::size_t> exits;
+                for (std::size_t i = 0; i + 1 < ast.children.size(); ++i) {
+                    const std::size_t split = push(program, Opcode::Split, program.size() + 1);
+                    if (!emit(ast.children[i], program)) {
+                        return false;
+                    }
+                    exits.push_back(push(program, Opcode::Jump));
+                    program[split].y = program.size();
+                }
+                if (!emit(ast.children.back(), program)) {
+                    return false;
+                }
+                for (std::size_t exit : exits) {
+                    program[exit].x = program.size();
+                }
+                return true;
+            }
+            case Kind::Repeat: {
+                const Ast& child = ast.children.front();
+                for (std::size_t i = 0; i < ast.min; ++i) {
+                    if (!emit(child, program)) {
+                        return false;
+                    }
+                }
+                if (ast.max == unbounded) {
+                    const std::size_t loop = push(program, Opcode::Split, program.size() + 1);
+                    if (!emit(child, program)) {
+                        return false;
+                    }
+                    push(program, Opcode::Jump, loop);
+                    program[loop].y = program.size();
+                    return true;
+                }
+                std::vector<std::size_t> splits;
+                for (std::size_t i = ast.min; i < ast.max; ++i) {
+                    splits.push_back(push(program, Opcode::Split, program.size() + 1));
+                    if (!emit(child, program)) {
+                        return false;
+                    }
+                }
+                for (std::size_t split : splits) {
+                    program[split].y = program.size();
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const std::string& pattern;
+    std::size_t pos = 0;
+    std::vector<ByteSet> byteSets;
+};
+
+/**
+ * Fixed-size memo of match results indexed by symbol.
+ *
+ * Each slot packs a symbol and its result into a single atomic word, hence
+ * concurrent readers and writers never observe torn entries. Colliding symbols
+ * simply evict each other.
+ */
+class RegexMemo {
+public:
+    explicit RegexMemo(std::size_t size = 1024)
+            : mask(size - 1), slots(new std::atomic<std::uint64_t>[size]) {
+        for (std::size_t i = 0; i < size; ++i) {
+            slots[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    /** Copies share the pattern, but not the memoised results */
+    RegexMemo(const RegexMemo& other) : RegexMemo(other.mask + 1) {}
+    RegexMemo(RegexMemo&& other) = default;
+
+    RegexMemo& operator=(const RegexMemo&) = delete;
+    RegexMemo& operator=(RegexMemo&&) = default;
+
+    /** Lookup a result; returns 0 or 1 if memoised, and -1 otherwise */
+    int lookup(RamDomain symbol) const {
+        if (!representable(symbol)) {
+            return -1;
+        }
+        const std::uint64_t slot = slots[index(symbol)].load(std::memory_order_relaxed);
+        if ((slot >> 2) != static_cast<std::uint64_t>(symbol) || (slot & 2) == 0) {
+            return -1;
+        }
+        return static_cast<int>(slot & 1);
+    }
+
+    void store(RamDomain symbol, bool result) const {
+        if (representable(symbol)) {
+            const std::uint64_t slot = (static_cast<std::uint64_t>(symbol) << 2) | 2 | (result ? 1 : 0);
+            slots[index(symbol)].store(slot, std::memory_order_relaxed);
+        }
+    }
+
+private:
+    static bool representable(RamDomain symbol) {
+        return symbol >= 0 && static_cast<std::uint64_t>(symbol) < (std::uint64_t(1) << 62);
+    }
+
+    std::size_t index(RamDomain symbol) const {
+        const std::uint64_t hash = static_cast<std::uint64_t>(symbol) * 0x9E3779B97F4A7C15ULL;
+        return static_cast<std::size_t>(hash >> 32) & mask;
+    }
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<std::uint64_t>[]> slots;
+};
+
+}  // namespace details
+
+/**
+ * A regular expression that performs a full match of a text.
+ *
+ * The matcher is immutable after construction and may be shared between threads.
+ */
+class Regex {
+public:
+    /**
+     * Compile a pattern.
+     *
+     * @throws std::regex_error if the pattern is malformed
+     */
+    explicit Regex(const std::string& pattern) {
+        if (!details::RegexCompiler(pattern).compile(program, sets)) {
+            program.clear();
+            sets.clear();
+            fallback.emplace(pattern);
+        }
+    }
+
+    /** Whether the pattern is matched by the linear-time automaton */
+    bool isAutomaton() const {
+        return !fallback.has_value();
+    }
+
+    /** Check whether the entire text is matched by the pattern */
+    bool match(const std::string& text) const {
+        if (fallback) {
+            return std::regex_match(text, *fallback);
+        }
+
+        using Compiler = details::RegexCompiler;
+        const std::size_t n = text.size();
+        ThreadList current(program.size());
+        ThreadList next(program.size());
+        std::vector<std::size_t> stack;
+
+        addThread(current, 0, text, 0, stack);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (current.empty()) {
+                return false;
+            }
+            const auto c = static_cast<unsigned char>(text[i]);
+            next.clear();
+            for (std::size_t k = 0; k < current.count(); ++k) {
+                const std::size_t pc = current[k];
+                const auto& instr = program[pc];
+                if (instr.op == Compiler::Opcode::Set && sets[instr.x][c]) {
+                    addThread(next, pc + 1, text, i + 1, stack);
+                }
+            }
+            std::swap(current, next);
+        }
+        for (std::size_t k = 0; k < current.count(); ++k) {
+            if (program[current[k]].op == Compiler::Opcode::Match) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    /** Sparse set of active states of the automaton */
+    class ThreadList {
+    public:
+        explicit ThreadList(std::size_t capacity) : sparse(capacity, 0), dense(capacity, 0) {}
+
+        bool insert(std::size_t pc) {
+            if (sparse[pc] < size && dense[sparse[pc]] == pc) {
+                return false;
+            }
+            sparse[pc] = size;
+            dense[size++] = pc;
+            return true;
+        }
+
+        bool empty() const {
+            return size == 0;
+        }
+
+        void clear() {
+            size = 0;
+        }
+
+        std::size_t count() const {
+            return size;
+        }
+
+        std::size_t operator[](std::size_t i) const {
+            return dense[i];
+        }
+
+    private:
+        std::vector<std::size_t> sparse;
+        std::vector<std::size_t> dense;
+        std::size_t size = 0;
+    };
+
+    /** Check a zero-width assertion between text[pos-1] and text[pos] */
+    static bool holds(details::RegexCompiler::Assertion assertion, const std::string& text, std::size_t pos) {
+        using Assertion = details::RegexCompiler::Assertion;
+        switch (assertion) {
+            case Assertion::Begin: return pos == 0;
+            case Assertion::End: return pos == text.size();
+            case Assertion::WordBoundary:
+            case Assertion::NotWordBoundary: {
+                const bool before = pos > 0 && details::RegexCompiler::isWord(text[pos - 1]);
+                const bool after = pos < text.size() && details::RegexCompiler::isWord(text[pos]);
+                return (before != after) == (assertion == Assertion::WordBoundary);
+            }
+        }
+        return false;
+    }
+
+    /** Add a state and its epsilon closure at the given text position */
+    void addThread(ThreadList& list, std::size_t start, const std::string& text, std::size_t pos,
+            std::vector<std::size_t>& stack) const {
+        using Opcode = details::RegexCompiler::Opcode;
+        stack.push_back(start);
+        while (!stack.empty()) {
+            const std::size_t pc = stack.back();
+            stack.pop_back();
+            if (!list.insert(pc)) {
+                continue;
+            }
+            const auto& instr = program[pc];
+            switch (instr.op) {
+                case Opcode::Jump: stack.push_back(instr.x); break;
+                case Opcode::Split:
+                    stack.push_back(instr.y);
+                    stack.push_back(instr.x);
+                    break;
+                case Opcode::Assert:
+                    if (holds(static_cast<details::RegexCompiler::Assertion>(instr.x), text, pos)) {
+                        stack.push_back(pc + 1);
+                    }
+                    break;
+                case Opcode::Set:
+                case Opcode::Match: break;
+            }
+        }
+    }
+
+    std::vector<details::RegexCompiler::Instruction> program;
+    std::vector<details::RegexCompiler::ByteSet> sets;
+    std::optional<std::regex> fallback;
+};
+
+/**
+ * A regular expression together with a memo of the results for symbols.
+ *
+ * Rules frequently match the same symbol against the same pattern; the memo
+ * avoids both decoding the symbol and running the matcher again.
+ */
+class RegexMatcher {
+public:
+    /**
+     * @param pattern the regular expression
+     * @param memoSize the number of memoised symbols, must be a power of two
+     * @throws std::regex_error if the pattern is malformed
+     */
+    explicit RegexMatcher(const std::string& pattern, std::size_t memoSize = 1024)
+            : regex(pattern), memo(memoSize) {}
+
+    /** Check whether the entire text is matched by the pattern */
+    bool match(const std::string& text) const {
+        return regex.match(text);
+    }
+
+    /** Check whether the entire symbol is matched by the pattern */
+    bool match(RamDomain symbol, const SymbolTable& symbolTable) const {
+        const int memoised = memo.lookup(symbol);
+        if (memoised >= 0) {
+            return memoised == 1;
+        }
+        const bool result = regex.match(symbolTable.decode(symbol));
+        memo.store(symbol, result);
+        return result;
+    }
+
+    const Regex& getRegex() const {
+        return regex;
+    }
+
+private:
+    Regex regex;
+    details::RegexMemo memo;
+};
+
+}  // namespace souffle
@@ -27,11 +27,11 @@ namespace souffle::interpreter {
     }
 
 Own<RelationWrapper> createBrieRelation(
-        const ram::Relation& id, const ram::analysis::IndexCluster& /* orderSet */) {
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection) {
     switch (id.getArity()) {
         FOR_EACH_BRIE(CREATE_BRIE_REL);
 
-        default: fatal("Brie is not supported in the interpreter mode.");
+        default: fatal("Requested arity not yet supported. Feel free to add it.");
     }
 }
 
@@ -0,0 +1,449 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Bytecode.cpp
+ *
+ * Compilation of RAM expressions and conditions to bytecode, and the
+ * dispatch loop running it.
+ *
+ ***********************************************************************/
+
+#include "interpreter/Bytecode.h"
+#include "FunctorOps.h"
+#include "interpreter/Context.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/False.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/Negation.h"
+#include "ram/Node.h"
+#include "ram/NumericConstant.h"
+#include "ram/StringConstant.h"
+#include "ram/SubroutineArgument.h"
+#include "ram/True.h"
+#include "ram/TupleElement.h"
+#include "ram/Variable.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/utility/DynamicCasting.h"
+#include <optional>
+#include <utility>
+
+namespace souffle::interpreter {
+
+namespace {
+
+using Opcode = BytecodeProgram::Opcode;
+using Instruction = BytecodeProgram::Instruction;
+
+/**
+ * Emits the instructions of an expression tree. The value of a node is
+ * computed into a given register, using only registers above it as
+ * temporaries.
+ */
+class Compiler {
+public:
+    Compiler(std::vector<Instruction>& code, const BytecodeProgram::Environment& env)
+            : code(code), env(env) {}
+
+    /** Emit the instructions computing the node into register dst, false if unsupported */
+    bool compile(const ram::Node& node, std::uint32_t dst) {
+        if (dst >= BytecodeProgram::MaxRegisters) {
+            // the node may still fit into the registers when compiled on its own
+            exhausted = true;
+            return false;
+        }
+        if (compileNode(node, dst)) {
+            return true;
+        }
+        if (!exhausted) {
+            failurePath.push_back(&node);
+        }
+        return false;
+    }
+
+    void emitReturn(std::uint32_t reg) {
+        emit(Opcode::Return, 0, {reg});
+    }
+
+    /** The nodes enclosing an operation without an instruction, innermost first */
+    const std::vector<const ram::Node*>& getFailurePath() const {
+        return failurePath;
+    }
+
+private:
+    bool compileNode(const ram::Node& node, std::uint32_t dst) {
+        if (auto value = constant(node)) {
+            return emit(Opcode::LoadConstant, dst, {}, *value);
+        }
+        if (const auto* access = as<ram::TupleElement>(node)) {
+            return emit(Opcode::LoadElement, dst, {index(access->getTupleId()), element(*access)});
+        }
+        if (const auto* var = as<ram::Variable>(node)) {
+            return emit(Opcode::LoadVariable, dst, {index(env.encodeVariable(var->getName()))});
+        }
+        if (const auto* arg = as<ram::SubroutineArgument>(node)) {
+            return emit(Opcode::LoadArgument, dst, {index(arg->getArgument())});
+        }
+        if (isA<ram::True>(node)) {
+            return emit(Opcode::LoadConstant, dst, {}, 1);
+        }
+        if (isA<ram::False>(node)) {
+            return emit(Opcode::LoadConstant, dst, {}, 0);
+        }
+        if (const auto* conj = as<ram::Conjunction>(node)) {
+            if (!compile(conj->getLHS(), dst)) {
+                return false;
+            }
+            // skip the right-hand side if the left-hand side does not hold
+            const std::size_t jump = code.size();
+            emit(Opcode::JumpIfZero, 0, {dst});
+            if (!compile(conj->getRHS(), dst)) {
+                return false;
+            }
+            code[jump].dst = index(code.size());
+            return true;
+        }
+        if (const auto* neg = as<ram::Negation>(node)) {
+            return unary(Opcode::LNot, neg->getOperand(), dst);
+        }
+        if (const auto* constraint = as<ram::Constraint>(node)) {
+            return compileConstraint(*constraint, dst);
+        }
+        if (const auto* op = as<ram::IntrinsicOperator>(node)) {
+            return compileIntrinsic(*op, dst);
+        }
+        return false;
+    }
+
+    static std::uint32_t index(std::size_t value) {
+        return static_cast<std::uint32_t>(value);
+    }
+
+    std::uint32_t element(const ram::TupleElement& access) const {
+        return index(env.mapElement(access.getTupleId(), access.getElement()));
+    }
+
+    /** Return the value of a constant, or nothing if the node is not a constant */
+    std::optional<RamDomain> constant(const ram::Node& node) const {
+        if (const auto* num = as<ram::NumericConstant>(node)) {
+            return num->getConstant();
+        }
+        if (const auto* str = as<ram::StringConstant>(node)) {
+            return env.encodeSymbol(str->getConstant());
+        }
+        return std::nullopt;
+    }
+
+    bool emit(Opcode op, std::uint32_t dst, std::array<std::uint32_t, 4> arg, RamDomain value = 0) {
+        code.push_back({op, dst, arg, value});
+        return true;
+    }
+
+    bool unary(Opcode op, const ram::Node& operand, std::uint32_t dst) {
+        return compile(operand, dst) && emit(op, dst, {dst});
+    }
+
+    bool binary(Opcode op, const ram::Node& lhs, const ram::Node& rhs, std::uint32_t dst) {
+        return compile(lhs, dst) && compile(rhs, dst + 1) && emit(op, dst, {dst, dst + 1});
+    }
+
+    /**
+     * Emit a logical connective evaluating its right-hand side only if the
+     * jump on the value of the left-hand side is not taken. Both paths end in
+     * the connective applied to the value itself, which normalises it to 0/1.
+     */
+    bool shortCircuit(Opcode op, Opcode jump, const ram::Node& lhs, const ram::Node& rhs, std::uint32_t dst) {
+        if (!compile(lhs, dst)) {
+            return false;
+        }
+        const std::size_t skip = code.size();
+        emit(jump, 0, {dst});
+        if (!compile(rhs, dst)) {
+            return false;
+        }
+        code[skip].dst = index(code.size());
+        return emit(op, dst, {dst, dst});
+    }
+
+    /** Fold the arguments of a variadic operator from the left */
+    bool fold(Opcode op, const std::vector<ram::Expression*>& args, std::uint32_t dst) {
+        if (!compile(*args[0], dst)) {
+            return false;
+        }
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            if (!compile(*args[i], dst + 1)) {
+                return false;
+            }
+            emit(op, dst, {dst, dst + 1});
+        }
+        return true;
+    }
+
+    /** Emit an (in)equality, fusing the loads of tuple elements and constants */
+    bool equality(bool eq, const ram::Node& lhs, const ram::Node& rhs, std::uint32_t dst) {
+        const auto* left = as<ram::TupleElement>(lhs);
+        const auto* right = as<ram::TupleElement>(rhs);
+        if (left != nullptr && right != nullptr) {
+            return emit(eq ? Opcode::EqElementElement : Opcode::NeElementElement, dst,
+                    {index(left->getTupleId()), element(*left), index(right->getTupleId()),
+                            element(*right)});
+        }
+        const ram::TupleElement* access = left != nullptr ? left : right;
+        if (access != nullptr) {
+            if (auto value = constant(left != nullptr ? rhs : lhs)) {
+                return emit(eq ? Opcode::EqElementConstant : Opcode::NeElementConstant, dst,
+                        {index(access->getTupleId()), element(*access)}, *value);
+            }
+        }
+        return binary(eq ? Opcode::Eq : Opcode::Ne, lhs, rhs, dst);
+    }
+
+    bool compileConstraint(const ram::Constraint& constraint, std::uint32_t dst) {
+        const ram::Node& lhs = constraint.getLHS();
+        const ram::Node& rhs = constraint.getRHS();
+        // greater-than tests are less-than tests with swapped operands
+        switch (constraint.getOperator()) {
+            case BinaryConstraintOp::EQ: return equality(true, lhs, rhs, dst);
+            case BinaryConstraintOp::NE: return equality(false, lhs, rhs, dst);
+            case BinaryConstraintOp::FEQ: return binary(Opcode::FEq, lhs, rhs, dst);
+            case BinaryConstraintOp::FNE: return binary(Opcode::FNe, lhs, rhs, dst);
+            case BinaryConstraintOp::LT: return binary(Opcode::Lt, lhs, rhs, dst);
+            case BinaryConstraintOp::ULT: return binary(Opcode::ULt, lhs, rhs, dst);
+            case BinaryConstraintOp::FLT: return binary(Opcode::FLt, lhs, rhs, dst);
+            case BinaryConstraintOp::LE: return binary(Opcode::Le, lhs, rhs, dst);
+            case BinaryConstraintOp::ULE: return binary(Opcode::ULe, lhs, rhs, dst);
+            case BinaryConstraintOp::FLE: return binary(Opcode::FLe, lhs, rhs, dst);
+            case BinaryConstraintOp::GT: return binary(Opcode::Lt, rhs, lhs, dst);
+            case BinaryConstraintOp::UGT: return binary(Opcode::ULt, rhs, lhs, dst);
+            case BinaryConstraintOp::FGT: return binary(Opcode::FLt, rhs, lhs, dst);
+            case BinaryConstraintOp::GE: return binary(Opcode::Le, rhs, lhs, dst);
+            case BinaryConstraintOp::UGE: return binary(Opcode::ULe, rhs, lhs, dst);
+            case BinaryConstraintOp::FGE: return binary(Opcode::FLe, rhs, lhs, dst);
+            default: return false;
+        }
+    }
+
+    bool compileIntrinsic(const ram::IntrinsicOperator& op, std::uint32_t dst) {
+        const auto args = op.getArguments();
+        switch (op.getOperator()) {
+            // conversions between signed and unsigned numbers preserve the bits
+            case FunctorOp::ORD:
+            case FunctorOp::F2F:
+            case FunctorOp::I2I:
+            case FunctorOp::U2U:
+            case FunctorOp::S2S:
+            case FunctorOp::I2U:
+            case FunctorOp::U2I: return compile(*args[0], dst);
+
+            case FunctorOp::NEG: return unary(Opcode::Neg, *args[0], dst);
+            case FunctorOp::FNEG: return unary(Opcode::FNeg, *args[0], dst);
+            case FunctorOp::BNOT:
+            case FunctorOp::UBNOT: return unary(Opcode::BNot, *args[0], dst);
+            case FunctorOp::LNOT:
+            case FunctorOp::ULNOT: return unary(Opcode::LNot, *args[0], dst);
+            case FunctorOp::I2F: return unary(Opcode::I2F, *args[0], dst);
+            case FunctorOp::U2F: return unary(Opcode::U2F, *args[0], dst);
+            case FunctorOp::F2I: return unary(Opcode::F2I, *args[0], dst);
+            case FunctorOp::F2U: return unary(Opcode::F2U, *args[0], dst);
+
+            case FunctorOp::ADD:
+            case FunctorOp::UADD: return binary(Opcode::Add, *args[0], *args[1], dst);
+            case FunctorOp::SUB:
+            case FunctorOp::USUB: return binary(Opcode::Sub, *args[0], *args[1], dst);
+            case FunctorOp::MUL:
+            case FunctorOp::UMUL: return binary(Opcode::Mul, *args[0], *args[1], dst);
+            case FunctorOp::DIV: return binary(Opcode::Div, *args[0], *args[1], dst);
+            case FunctorOp::UDIV: return binary(Opcode::UDiv, *args[0], *args[1], dst);
+            case FunctorOp::MOD: return binary(Opcode::Mod, *args[0], *args[1], dst);
+            case FunctorOp::UMOD: return binary(Opcode::UMod, *args[0], *args[1], dst);
+            case FunctorOp::FADD: return binary(Opcode::FAdd, *args[0], *args[1], dst);
+            case FunctorOp::FSUB: return binary(Opcode::FSub, *args[0], *args[1], dst);
+            case FunctorOp::FMUL: return binary(Opcode::FMul, *args[0], *args[1], dst);
+            case FunctorOp::FDIV: return binary(Opcode::FDiv, *args[0], *args[1], dst);
+
+            case FunctorOp::BAND:
+            case FunctorOp::UBAND: return binary(Opcode::BAnd, *args[0], *args[1], dst);
+            case FunctorOp::BOR:
+            case FunctorOp::UBOR: return binary(Opcode::BOr, *args[0], *args[1], dst);
+            case FunctorOp::BXOR:
+            case FunctorOp::UBXOR: return binary(Opcode::BXor, *args[0], *args[1], dst);
+            case FunctorOp::BSHIFT_L:
+            case FunctorOp::UBSHIFT_L: return binary(Opcode::BShiftL, *args[0], *args[1], dst);
+            case FunctorOp::BSHIFT_R: return binary(Opcode::BShiftR, *args[0], *args[1], dst);
+            case FunctorOp::UBSHIFT_R:
+            case FunctorOp::BSHIFT_R_UNSIGNED:
+            case FunctorOp::UBSHIFT_R_UNSIGNED: return binary(Opcode::UBShiftR, *args[0], *args[1], dst);
+            case FunctorOp::LAND:
+            case FunctorOp::ULAND:
+                return shortCircuit(Opcode::LAnd, Opcode::JumpIfZero, *args[0], *args[1], dst);
+            case FunctorOp::LOR:
+            case FunctorOp::ULOR:
+                return shortCircuit(Opcode::LOr, Opcode::JumpIfNonZero, *args[0], *args[1], dst);
+            case FunctorOp::LXOR:
+            case FunctorOp::ULXOR: return binary(Opcode::LXor, *args[0], *args[1], dst);
+
+            case FunctorOp::MAX: return fold(Opcode::Max, args, dst);
+            case FunctorOp::UMAX: return fold(Opcode::UMax, args, dst);
+            case FunctorOp::FMAX: return fold(Opcode::FMax, args, dst);
+            case FunctorOp::MIN: return fold(Opcode::Min, args, dst);
+            case FunctorOp::UMIN: return fold(Opcode::UMin, args, dst);
+            case FunctorOp::FMIN: return fold(Opcode::FMin, args, dst);
+
+            default: return false;
+        }
+    }
+
+    std::vector<Instruction>& code;
+    const BytecodeProgram::Environment& env;
+    /** Whether the registers were exhausted */
+    bool exhausted = false;
+    std::vector<const ram::Node*> failurePath;
+};
+
+}  // namespace
+
+Own<BytecodeProgram> BytecodeProgram::compile(
+        const ram::Node& node, const Environment& env, std::vector<const ram::Node*>* unsupported) {
+    auto program = mk<BytecodeProgram>();
+    Compiler compiler(program->code, env);
+    if (!compiler.compile(node, 0)) {
+        if (unsupported != nullptr) {
+            const auto& path = compiler.getFailurePath();
+            unsupported->insert(unsupported->end(), path.begin(), path.end());
+        }
+        return nullptr;
+    }
+    compiler.emitReturn(0);
+    return program;
+}
+
+RamDomain BytecodeProgram::execute(Context& ctxt) const {
+    std::array<RamDomain, MaxRegisters> reg;
+    const Instruction* ip = code.data();
+
+// clang-format off
+#define REG(i) reg[ip->arg[i]]
+#define ARG(ty, i) ramBitCast<ty>(REG(i))
+#define ELEMENT(i) ctxt[ip->arg[i]][ip->arg[i + 1]]
+#define UNARY_OP(ty, op) reg[ip->dst] = ramBitCast(static_cast<ty>(op ARG(ty, 0))); NEXT()
+#define BINARY_OP(ty, op) reg[ip->dst] = ramBitCast(static_cast<ty>(ARG(ty, 0) op ARG(ty, 1))); NEXT()
+#define CONVERT(from, to) reg[ip->dst] = ramBitCast(static_cast<to>(ARG(from, 0))); NEXT()
+#define SHIFT(ty, op) \
+    reg[ip->dst] = ramBitCast(static_cast<ty>(ARG(ty, 0) op (ARG(ty, 1) & RAM_BIT_SHIFT_MASK))); NEXT()
+#define COMPARE(ty, op) reg[ip->dst] = ARG(ty, 0) op ARG(ty, 1); NEXT()
+#define MAX_OP(ty) reg[ip->dst] = ARG(ty, 0) < ARG(ty, 1) ? REG(1) : REG(0); NEXT()
+#define MIN_OP(ty) reg[ip->dst] = ARG(ty, 1) < ARG(ty, 0) ? REG(1) : REG(0); NEXT()
+
+// Threaded dispatch where labels are values, a switch in a loop otherwise
+#if defined(__GNUC__)
+#define LABEL_ADDRESS(op) &&L_##op,
+#define OPCODE(op) L_##op:
+#define NEXT() ++ip; goto* labels[static_cast<std::size_t>(ip->op)]
+    static const void* const labels[] = {FOR_EACH_BYTECODE_OPCODE(LABEL_ADDRESS)};
+    goto* labels[static_cast<std::size_t>(ip->op)];
+#undef LABEL_ADDRESS
+#else
+#define OPCODE(op) case Opcode::op:
+#define NEXT() ++ip; continue
+    while (true) switch (ip->op) {
+#endif
+
+    OPCODE(LoadConstant) reg[ip->dst] = ip->value; NEXT();
+    OPCODE(LoadElement) reg[ip->dst] = ELEMENT(0); NEXT();
+    OPCODE(LoadVariable) reg[ip->dst] = ctxt.getVariable(ip->arg[0]); NEXT();
+    OPCODE(LoadArgument) reg[ip->dst] = ctxt.getArgument(ip->arg[0]); NEXT();
+
+    // signed arithmetic is carried out unsigned, where overflows wrap around
+    OPCODE(Neg) UNARY_OP(RamUnsigned, -);
+    OPCODE(FNeg) UNARY_OP(RamFloat, -);
+    OPCODE(BNot) UNARY_OP(RamUnsigned, ~);
+    OPCODE(LNot) reg[ip->dst] = !REG(0); NEXT();
+    OPCODE(I2F) CONVERT(RamSigned, RamFloat);
+    OPCODE(U2F) CONVERT(RamUnsigned, RamFloat);
+    OPCODE(F2I) CONVERT(RamFloat, RamSigned);
+    OPCODE(F2U) CONVERT(RamFloat, RamUnsigned);
+
+    OPCODE(Add) BINARY_OP(RamUnsigned, +);
+    OPCODE(Sub) BINARY_OP(RamUnsigned, -);
+    OPCODE(Mul) BINARY_OP(RamUnsigned, *);
+    OPCODE(Div) BINARY_OP(RamSigned, /);
+    OPCODE(UDiv) BINARY_OP(RamUnsigned, /);
+    OPCODE(Mod) BINARY_OP(RamSigned, %);
+    OPCODE(UMod) BINARY_OP(RamUnsigned, %);
+    OPCODE(FAdd) BINARY_OP(RamFloat, +);
+    OPCODE(FSub) BINARY_OP(RamFloat, -);
+    OPCODE(FMul) BINARY_OP(RamFloat, *);
+    OPCODE(FDiv) BINARY_OP(RamFloat, /);
+
+    OPCODE(BAnd) BINARY_OP(RamUnsigned, &);
+    OPCODE(BOr) BINARY_OP(RamUnsigned, |);
+    OPCODE(BXor) BINARY_OP(RamUnsigned, ^);
+    OPCODE(BShiftL) SHIFT(RamUnsigned, <<);
+    OPCODE(BShiftR) SHIFT(RamSigned, >>);
+    OPCODE(UBShiftR) SHIFT(RamUnsigned, >>);
+    OPCODE(LAnd) reg[ip->dst] = REG(0) && REG(1); NEXT();
+    OPCODE(LOr) reg[ip->dst] = REG(0) || REG(1); NEXT();
+    OPCODE(LXor) reg[ip->dst] = !REG(0) != !REG(1); NEXT();
+
+    OPCODE(Max) MAX_OP(RamSigned);
+    OPCODE(UMax) MAX_OP(RamUnsigned);
+    OPCODE(FMax) MAX_OP(RamFloat);
+    OPCODE(Min) MIN_OP(RamSigned);
+    OPCODE(UMin) MIN_OP(RamUnsigned);
+    OPCODE(FMin) MIN_OP(RamFloat);
+
+    OPCODE(Eq) COMPARE(RamDomain, ==);
+    OPCODE(Ne) COMPARE(RamDomain, !=);
+    OPCODE(FEq) COMPARE(RamFloat, ==);
+    OPCODE(FNe) COMPARE(RamFloat, !=);
+    OPCODE(Lt) COMPARE(RamSigned, <);
+    OPCODE(ULt) COMPARE(RamUnsigned, <);
+    OPCODE(FLt) COMPARE(RamFloat, <);
+    OPCODE(Le) COMPARE(RamSigned, <=);
+    OPCODE(ULe) COMPARE(RamUnsigned, <=);
+    OPCODE(FLe) COMPARE(RamFloat, <=);
+
+    OPCODE(EqElementConstant) reg[ip->dst] = ELEMENT(0) == ip->value; NEXT();
+    OPCODE(NeElementConstant) reg[ip->dst] = ELEMENT(0) != ip->value; NEXT();
+    OPCODE(EqElementElement) reg[ip->dst] = ELEMENT(0) == ELEMENT(2); NEXT();
+    OPCODE(NeElementElement) reg[ip->dst] = ELEMENT(0) != ELEMENT(2); NEXT();
+
+    OPCODE(JumpIfZero)
+        if (REG(0) == 0) {
+            ip = code.data() + ip->dst - 1;
+        }
+        NEXT();
+    OPCODE(JumpIfNonZero)
+        if (REG(0) != 0) {
+            ip = code.data() + ip->dst - 1;
+        }
+        NEXT();
+    OPCODE(Return) return REG(0);
+
+#if !defined(__GNUC__)
+    }
+#endif
+    // clang-format on
+
+#undef REG
+#undef ARG
+#undef ELEMENT
+#undef UNARY_OP
+#undef BINARY_OP
+#undef CONVERT
+#undef SHIFT
+#undef COMPARE
+#undef MAX_OP
+#undef MIN_OP
+#undef OPCODE
+#undef NEXT
+}
+
+}  // namespace souffle::interpreter
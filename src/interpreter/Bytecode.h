@@ -0,0 +1,159 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file Bytecode.h
+ *
+ * Declares a register-based bytecode for the expressions and conditions
+ * of the interpreter. Evaluating an expression node by node costs a
+ * recursive call of the engine and a dispatch for every node; a compiled
+ * program is a flat sequence of instructions run by a threaded loop.
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace souffle {
+namespace ram {
+class Node;
+}
+
+namespace interpreter {
+class Context;
+
+// clang-format off
+
+/* This macro defines all the opcodes of the bytecode. */
+#define FOR_EACH_BYTECODE_OPCODE(Op)\
+    Op(LoadConstant)\
+    Op(LoadElement)\
+    Op(LoadVariable)\
+    Op(LoadArgument)\
+    Op(Neg)\
+    Op(FNeg)\
+    Op(BNot)\
+    Op(LNot)\
+    Op(I2F)\
+    Op(U2F)\
+    Op(F2I)\
+    Op(F2U)\
+    Op(Add)\
+    Op(Sub)\
+    Op(Mul)\
+    Op(Div)\
+    Op(UDiv)\
+    Op(Mod)\
+    Op(UMod)\
+    Op(FAdd)\
+    Op(FSub)\
+    Op(FMul)\
+    Op(FDiv)\
+    Op(BAnd)\
+    Op(BOr)\
+    Op(BXor)\
+    Op(BShiftL)\
+    Op(BShiftR)\
+    Op(UBShiftR)\
+    Op(LAnd)\
+    Op(LOr)\
+    Op(LXor)\
+    Op(Max)\
+    Op(UMax)\
+    Op(FMax)\
+    Op(Min)\
+    Op(UMin)\
+    Op(FMin)\
+    Op(Eq)\
+    Op(Ne)\
+    Op(FEq)\
+    Op(FNe)\
+    Op(Lt)\
+    Op(ULt)\
+    Op(FLt)\
+    Op(Le)\
+    Op(ULe)\
+    Op(FLe)\
+    Op(EqElementConstant)\
+    Op(NeElementConstant)\
+    Op(EqElementElement)\
+    Op(NeElementElement)\
+    Op(JumpIfZero)\
+    Op(JumpIfNonZero)\
+    Op(Return)
+
+// clang-format on
+
+/**
+ * @class BytecodeProgram
+ * @brief A compiled expression or condition
+ *
+ * Instructions read and write a small file of registers; the value of the
+ * program is the register named by its final Return. Loads of tuple
+ * elements and constants are fused into the equality tests that dominate
+ * the filters of rules, so that such a filter is a single instruction.
+ */
+class BytecodeProgram {
+public:
+#define BYTECODE_OPCODE(op) op,
+    enum class Opcode : std::uint8_t { FOR_EACH_BYTECODE_OPCODE(BYTECODE_OPCODE) };
+#undef BYTECODE_OPCODE
+
+    struct Instruction {
+        Opcode op;
+        /** Register receiving the result, or the target of a jump */
+        std::uint32_t dst = 0;
+        /** Operand registers, or the tuple ids and elements of fused loads */
+        std::array<std::uint32_t, 4> arg{};
+        /** Immediate operand */
+        RamDomain value = 0;
+    };
+
+    /** Resolves the leaves of RAM expressions the way the node generator encodes them */
+    struct Environment {
+        /** Maps a tuple element to its position in the stored tuple */
+        std::function<std::size_t(std::size_t, std::size_t)> mapElement;
+        /** Returns the slot of a variable */
+        std::function<std::size_t(const std::string&)> encodeVariable;
+        /** Returns the encoding of a symbol */
+        std::function<RamDomain(const std::string&)> encodeSymbol;
+    };
+
+    /** Number of registers available to a program */
+    static constexpr std::size_t MaxRegisters = 32;
+
+    /**
+     * Compile a RAM expression or condition. Returns nullptr if it contains
+     * operations without an instruction, which are left to the tree. If given,
+     * the nodes of the failing path are then added to unsupported: each of
+     * them fails to compile in every context.
+     */
+    static Own<BytecodeProgram> compile(const ram::Node& node, const Environment& env,
+            std::vector<const ram::Node*>* unsupported = nullptr);
+
+    /** Run the program */
+    RamDomain execute(Context& ctxt) const;
+
+    const std::vector<Instruction>& getInstructions() const {
+        return code;
+    }
+
+private:
+    std::vector<Instruction> code;
+};
+
+}  // namespace interpreter
+}  // namespace souffle
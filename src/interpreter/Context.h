@@ -19,14 +19,37 @@
 #include "interpreter/Index.h"
 #include "interpreter/Relation.h"
 #include "souffle/RamTypes.h"
+#include <array>
+#include <atomic>
 #include <cassert>
 #include <cstddef>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
 
 namespace souffle::interpreter {
 
+/**
+ * Stop flag of a range split into tasks. The loop of a task that breaks sets
+ * it, which stops the other tasks of the range and the tasks of the ranges
+ * nested in them.
+ */
+struct SplitStop {
+    std::atomic<bool> flag{false};
+    /** @brief Stop flag of the split range enclosing this one, if any */
+    const SplitStop* outer = nullptr;
+
+    bool stopped() const {
+        for (const SplitStop* stop = this; stop != nullptr; stop = stop->outer) {
+            if (stop->flag.load(std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
 /**
  * Evaluation context for Interpreter operations
  */
@@ -37,8 +60,8 @@ public:
     Context(std::size_t size = 0) : data(size) {}
 
     /** This constructor is used when program enter a new scope.
-     * Only Subroutine value needs to be copied */
-    Context(Context& ctxt) : returnValues(ctxt.returnValues), args(ctxt.args) {}
+     * Subroutine values and variables are copied, tuples and views are private to the scope */
+    Context(Context& ctxt) : returnValues(ctxt.returnValues), args(ctxt.args), variables(ctxt.variables) {}
     virtual ~Context() = default;
 
     const RamDomain*& operator[](std::size_t index) {
@@ -52,14 +75,9 @@ public:
         return data[index];
     }
 
-    /** @brief Allocate a tuple.
-     *  allocatedDataContainer has the ownership of those tuples. */
-    RamDomain* allocateNewTuple(std::size_t size) {
-        Own<RamDomain[]> newTuple(new RamDomain[size]);
-        allocatedDataContainer.push_back(std::move(newTuple));
-
-        // Return the reference as raw pointer.
-        return allocatedDataContainer.back().get();
+    /** @brief Return the tuples of the environment, indexed by their ids */
+    const RamDomain* const* getTuples() const {
+        return data.data();
     }
 
     /** @brief Get subroutine return value */
@@ -109,12 +127,56 @@ public:
         return views[id].get();
     }
 
-    RamDomain getVariable(const std::string& name) {
-        return variables[name];
+    /** @brief Copy the tuples of another context, for a task continuing its evaluation */
+    void copyTuples(const Context& ctxt) {
+        data = ctxt.data;
+    }
+
+    /**
+     * @brief Set the views of the enclosing parallel operation, which its tasks create again,
+     * and the number of tuples after which its nested ranges are split into tasks
+     */
+    void setParallelViews(const std::vector<std::array<std::size_t, 3>>* viewInfo, std::size_t threshold) {
+        parallelViews = viewInfo;
+        splitThreshold = threshold;
+    }
+
+    /** @brief Return the views of the enclosing parallel operation, or nullptr outside of one */
+    const std::vector<std::array<std::size_t, 3>>* getParallelViews() const {
+        return parallelViews;
     }
 
-    void setVariable(const std::string& name, RamDomain value) {
-        variables[name] = value;
+    /** @brief Return the number of tuples after which a nested range is split into tasks */
+    std::size_t getSplitThreshold() const {
+        return splitThreshold;
+    }
+
+    /** @brief Set the stop flag of the split range whose task evaluates in this context */
+    void setSplitStop(const SplitStop* stop) {
+        splitStop = stop;
+    }
+
+    /** @brief Return the stop flag of the split range of this context, or nullptr outside of a task */
+    const SplitStop* getSplitStop() const {
+        return splitStop;
+    }
+
+    /** @brief Get the value of a variable, variables are zero until assigned */
+    RamDomain getVariable(std::size_t slot) const {
+        return slot < variables.size() ? variables[slot] : 0;
+    }
+
+    /** @brief Return the values of the variables assigned so far, indexed by their slots */
+    const std::vector<RamDomain>& getVariables() const {
+        return variables;
+    }
+
+    /** @brief Set the value of a variable */
+    void setVariable(std::size_t slot, RamDomain value) {
+        if (slot >= variables.size()) {
+            variables.resize(slot + 1);
+        }
+        variables[slot] = value;
     }
 
 private:
@@ -124,11 +186,16 @@ private:
     std::vector<RamDomain>* returnValues = nullptr;
     /** @brief Subroutine arguments */
     const std::vector<RamDomain>* args = nullptr;
-    /** @bref Allocated data */
-    VecOwn<RamDomain[]> allocatedDataContainer;
+    /** @brief Variables, indexed by the slots assigned by the generator */
+    std::vector<RamDomain> variables;
     /** @brief Views */
     VecOwn<ViewWrapper> views;
-    std::map<std::string, RamDomain> variables;
+    /** @brief Views of the enclosing parallel operation */
+    const std::vector<std::array<std::size_t, 3>>* parallelViews = nullptr;
+    /** @brief Number of tuples after which nested ranges are split, ranges are not split by default */
+    std::size_t splitThreshold = std::numeric_limits<std::size_t>::max();
+    /** @brief Stop flag of the split range of a task */
+    const SplitStop* splitStop = nullptr;
 };
 
 }  // namespace souffle::interpreter
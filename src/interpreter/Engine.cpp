@@ -19,9 +19,12 @@
 #include "Global.h"
 #include "interpreter/Context.h"
 #include "interpreter/Index.h"
+#include "interpreter/JoinPlanner.h"
+#include "interpreter/NativeCode.h"
 #include "interpreter/Node.h"
 #include "interpreter/Relation.h"
 #include "interpreter/ViewContext.h"
+#include "ram/AbstractExistenceCheck.h"
 #include "ram/Aggregate.h"
 #include "ram/Aggregator.h"
 #include "ram/Assign.h"
@@ -67,6 +70,7 @@
 #include "ram/ProvenanceExistenceCheck.h"
 #include "ram/Query.h"
 #include "ram/Relation.h"
+#include "ram/RelationOperation.h"
 #include "ram/RelationSize.h"
 #include "ram/Scan.h"
 #include "ram/Sequence.h"
@@ -83,6 +87,7 @@
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
 #include "ram/Variable.h"
+#include "ram/analysis/StratumDependency.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/BinaryConstraintOps.h"
 #include "souffle/RamTypes.h"
@@ -94,10 +99,12 @@
 #include "souffle/datastructure/SymbolTableImpl.h"
 #include "souffle/io/IOSystem.h"
 #include "souffle/io/ReadStream.h"
+#include "souffle/io/SymbolSnapshot.h"
 #include "souffle/io/WriteStream.h"
 #include "souffle/profile/Logger.h"
 #include "souffle/profile/ProfileEvent.h"
 #include "souffle/utility/EvaluatorUtil.h"
+#include "souffle/utility/FileUtil.h"
 #include "souffle/utility/MiscUtil.h"
 #include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StringUtil.h"
@@ -114,9 +121,10 @@
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <numeric>
-#include <regex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
 #include <utility>
 #include <vector>
@@ -163,6 +171,16 @@ std::size_t number_of_threads(const std::size_t) {
 }
 #endif
 
+/** Creates a tuple for querying or updating relations of the given type and arity. */
+template <typename Rel>
+typename Rel::Tuple createTuple([[maybe_unused]] std::size_t arity) {
+    if constexpr (Rel::Arity == Dynamic) {
+        return typename Rel::Tuple(arity);
+    } else {
+        return {};
+    }
+}
+
 /** Construct an arguments tuple for a stateful functor call. */
 template <std::size_t Arity, std::size_t... Is>
 constexpr auto statefulCallTuple(souffle::SymbolTable* symbolTable, souffle::RecordTable* recordTable,
@@ -307,7 +325,45 @@ Engine::Engine(ram::TranslationUnit& tUnit, const std::size_t numberOfThreadsOrZ
           frequencyCounterEnabled(global.config().has("profile-frequency")),
           numOfThreads(number_of_threads(numberOfThreadsOrZero)),
           isa(tUnit.getAnalysis<ram::analysis::IndexAnalysis>()), recordTable(numOfThreads),
-          symbolTable(numOfThreads), regexCache(numOfThreads) {}
+          symbolTable(numOfThreads), regexCache(numOfThreads) {
+    // secondary indexes are updated lazily, unless a query reads the relation it inserts into
+    visit(tUnit.getProgram(), [&](const ram::Query& query) {
+        std::set<std::string> read;
+        visit(query, [&](const ram::RelationOperation& op) { read.insert(op.getRelation()); });
+        visit(query, [&](const ram::AbstractExistenceCheck& check) { read.insert(check.getRelation()); });
+        visit(query, [&](const ram::Insert& insert) {
+            if (contains(read, insert.getRelation())) {
+                eagerIndexRelations.insert(insert.getRelation());
+            }
+        });
+    });
+    // a swap exchanges the relation objects with their settings, so both operands must agree
+    for (bool changed = true; changed;) {
+        changed = false;
+        visit(tUnit.getProgram(), [&](const ram::Swap& swap) {
+            const bool first = contains(eagerIndexRelations, swap.getFirstRelation());
+            const bool second = contains(eagerIndexRelations, swap.getSecondRelation());
+            if (first != second) {
+                eagerIndexRelations.insert(first ? swap.getSecondRelation() : swap.getFirstRelation());
+                changed = true;
+            }
+        });
+    }
+
+    // the memory budget is shared evenly by the relations spilling to disk
+    if (global.config().has("memory-budget")) {
+        std::size_t diskRelations = 0;
+        for (const ram::Relation* rel : tUnit.getProgram().getRelations()) {
+            if (rel->getRepresentation() == RelationRepresentation::DISK && !rel->isNullary() &&
+                    rel->getArity() <= MaxSpecializedArity) {
+                ++diskRelations;
+            }
+        }
+        if (diskRelations > 0) {
+            diskMemoryBudget = (std::stoull(global.config().get("memory-budget")) << 20) / diskRelations;
+        }
+    }
+}
 
 Engine::RelationHandle& Engine::getRelationHandle(const std::size_t idx) {
     return *relations[idx];
@@ -363,11 +419,33 @@ void Engine::createRelation(const ram::Relation& id, const std::size_t idx) {
     if (id.getRepresentation() == RelationRepresentation::EQREL) {
         res = createEqrelRelation(id, isa.getIndexSelection(id.getName()));
     } else if (id.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
+        // the generic relations of wider arities do not support the erasure of tuples
+        if (id.getArity() > MaxSpecializedArity) {
+            throw std::invalid_argument("Error: relation " + id.getName() + " of arity " +
+                                        std::to_string(id.getArity()) +
+                                        " is too wide for the deletions of the interpreter (at most " +
+                                        std::to_string(MaxSpecializedArity) + "); compile it with -c.");
+        }
         res = createBTreeDeleteRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getRepresentation() != RelationRepresentation::PROVENANCE &&
+               id.getArity() > MaxSpecializedArity) {
+        res = createGenericRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getRepresentation() == RelationRepresentation::BRIE && !id.isNullary()) {
+        res = createBrieRelation(id, isa.getIndexSelection(id.getName()));
+    } else if (id.getRepresentation() == RelationRepresentation::COMPRESSED && !id.isNullary()) {
+        res = createCompressedRelation(id, isa.getIndexSelection(id.getName()));
+        res->setLazyIndexes(!contains(eagerIndexRelations, id.getName()));
+    } else if (id.getRepresentation() == RelationRepresentation::DISK && !id.isNullary()) {
+        res = createDiskRelation(id, isa.getIndexSelection(id.getName()));
+        res->setLazyIndexes(!contains(eagerIndexRelations, id.getName()));
+        if (diskMemoryBudget > 0) {
+            res->setMemoryBudget(diskMemoryBudget);
+        }
     } else if (id.getRepresentation() == RelationRepresentation::PROVENANCE) {
         res = createProvenanceRelation(id, isa.getIndexSelection(id.getName()));
     } else {
         res = createBTreeRelation(id, isa.getIndexSelection(id.getName()));
+        res->setLazyIndexes(!contains(eagerIndexRelations, id.getName()));
     }
     relations[idx] = mk<RelationHandle>(std::move(res));
 }
@@ -441,12 +519,24 @@ void Engine::executeMain() {
      * must be able to find actual functions for each user-defined functor. */
     loadDLL();
 
+    /* The snapshot must be loaded before the generator encodes the symbols of
+     * the program, so that the numbers of the symbols are those of the snapshot. */
+    const bool symbolSnapshot = global.config().has("symbol-snapshot");
+    if (symbolSnapshot && existFile(global.config().get("symbol-snapshot"))) {
+        loadSymbolSnapshot(symbolTable, global.config().get("symbol-snapshot"));
+    }
+
     generateIR();
     assert(main != nullptr && "Executing an empty program");
 
     if (!profileEnabled) {
-        Context ctxt;
-        execute(main.get(), ctxt);
+        const auto& strata = tUnit.getAnalysis<ram::analysis::StratumDependencyAnalysis>();
+        if (global.config().has("parallel-strata") && numOfThreads > 1 && strata.isSchedulable()) {
+            executeStrata(strata);
+        } else {
+            Context ctxt;
+            execute(main.get(), ctxt);
+        }
     } else {
         ProfileEventSingleton::instance().setOutputFile(global.config().get("profile"));
         // Prepare the frequency table for threaded use
@@ -494,19 +584,33 @@ void Engine::executeMain() {
                     "@relation-reads;" + cur.first, cur.second, 0);
         }
     }
+    if (symbolSnapshot) {
+        saveSymbolSnapshot(symbolTable, global.config().get("symbol-snapshot"));
+    }
     SignalHandler::instance()->reset();
 }
 
+void Engine::executeStrata(const ram::analysis::StratumDependencyAnalysis& strata) {
+    const auto& calls = strata.getCalls();
+    runTaskGraph(strata.getPredecessors(), [&](std::size_t i) {
+        Context ctxt;
+        execute(subroutine.at(calls[i]).get(), ctxt);
+    });
+}
+
 void Engine::generateIR() {
     const ram::Program& program = tUnit.getProgram();
-    NodeGenerator generator(*this);
+    // the generator is kept alive for re-planned queries
+    if (generator == nullptr) {
+        generator = mk<NodeGenerator>(*this);
+    }
     if (subroutine.empty()) {
         for (const auto& sub : program.getSubroutines()) {
-            subroutine.emplace(std::make_pair("stratum_" + sub.first, generator.generateTree(*sub.second)));
+            subroutine.emplace(std::make_pair("stratum_" + sub.first, generator->generateTree(*sub.second)));
         }
     }
     if (main == nullptr) {
-        main = generator.generateTree(program.getMain());
+        main = generator->generateTree(program.getMain());
     }
 }
 
@@ -577,7 +681,7 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(NumericConstant)
 
         CASE(Variable)
-            return ctxt.getVariable(cur.getName());
+            return ctxt.getVariable(shadow.getSlot());
         ESAC(Variable)
 
         CASE(StringConstant)
@@ -1040,24 +1144,25 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 case BinaryConstraintOp::MATCH: {
                     bool result = false;
                     RamDomain right = execute(shadow.getRhs(), ctxt);
-                    const std::string& text = getSymbolTable().decode(right);
 
                     const Node* patternNode = shadow.getLhs();
                     if (const RegexConstant* regexNode = dynamic_cast<const RegexConstant*>(patternNode);
                             regexNode) {
                         const auto& regex = regexNode->getRegex();
                         if (regex) {
-                            result = std::regex_match(text, *regex);
+                            result = regex->match(right, getSymbolTable());
                         }
                     } else {
                         RamDomain left = execute(patternNode, ctxt);
-                        const std::string& pattern = getSymbolTable().decode(left);
                         try {
-                            const std::regex& regex = regexCache.getOrCreate(pattern);
-                            result = std::regex_match(text, regex);
+                            auto create = [&](RamDomain pattern) {
+                                return RegexMatcher(getSymbolTable().decode(pattern));
+                            };
+                            result = regexCache.getOrCreate(left, create).match(right, getSymbolTable());
                         } catch (...) {
-                            std::cerr << "warning: wrong pattern provided for match(\"" << pattern << "\",\""
-                                      << text << "\").\n";
+                            std::cerr << "warning: wrong pattern provided for match(\""
+                                      << getSymbolTable().decode(left) << "\",\""
+                                      << getSymbolTable().decode(right) << "\").\n";
                         }
                     }
 
@@ -1066,24 +1171,25 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                 case BinaryConstraintOp::NOT_MATCH: {
                     bool result = false;
                     RamDomain right = execute(shadow.getRhs(), ctxt);
-                    const std::string& text = getSymbolTable().decode(right);
 
                     const Node* patternNode = shadow.getLhs();
                     if (const RegexConstant* regexNode = dynamic_cast<const RegexConstant*>(patternNode);
                             regexNode) {
                         const auto& regex = regexNode->getRegex();
                         if (regex) {
-                            result = !std::regex_match(text, *regex);
+                            result = !regex->match(right, getSymbolTable());
                         }
                     } else {
                         RamDomain left = execute(patternNode, ctxt);
-                        const std::string& pattern = getSymbolTable().decode(left);
                         try {
-                            const std::regex& regex = regexCache.getOrCreate(pattern);
-                            result = !std::regex_match(text, regex);
+                            auto create = [&](RamDomain pattern) {
+                                return RegexMatcher(getSymbolTable().decode(pattern));
+                            };
+                            result = !regexCache.getOrCreate(left, create).match(right, getSymbolTable());
                         } catch (...) {
-                            std::cerr << "warning: wrong pattern provided for !match(\"" << pattern << "\",\""
-                                      << text << "\").\n";
+                            std::cerr << "warning: wrong pattern provided for !match(\""
+                                      << getSymbolTable().decode(left) << "\",\""
+                                      << getSymbolTable().decode(right) << "\").\n";
                         }
                     }
                     return result;
@@ -1426,6 +1532,12 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         CASE(Query)
             ViewContext* viewContext = shadow.getViewContext();
 
+            // Update lazily maintained indexes before any view is created, such that each index is
+            // updated by a task of its own and the tasks of the query only read them.
+            for (std::size_t relId : viewContext->getReadRelations()) {
+                getRelationHandle(relId)->updateIndexes();
+            }
+
             // Execute view-free operations in outer filter if any.
             auto& viewFreeOps = viewContext->getOuterFilterViewFreeOps();
             for (auto& op : viewFreeOps) {
@@ -1457,10 +1569,55 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
                     ctxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
                 }
             }
+
+            // Threads buffer their insertions, which are merged once the query is done.
+            const auto& bufferedInserts = viewContext->getBufferedInserts();
+            for (std::size_t relId : bufferedInserts) {
+                getRelationHandle(relId)->setInsertBuffer(viewContext->insertBufferSize);
+            }
             execute(shadow.getChild(), ctxt);
+            for (std::size_t relId : bufferedInserts) {
+                getRelationHandle(relId)->setInsertBuffer(0);
+            }
             return true;
         ESAC(Query)
 
+        // bytecode has no RAM counterpart of its own; its shadow is the compiled node
+        case I_Bytecode: {
+            const auto& shadow = *static_cast<const interpreter::Bytecode*>(node);
+            if (const NativeProgram* native = shadow.getNative()) {
+                return native->execute(ctxt);
+            }
+            return shadow.getProgram().execute(ctxt);
+        }
+
+        // an adaptive query has no RAM counterpart of its own; its shadow is the original query
+        case I_AdaptiveQuery: {
+            const auto& shadow = *static_cast<const interpreter::AdaptiveQuery*>(node);
+            JoinPlanner& planner = shadow.getPlanner();
+            if (planner.isSampling()) {
+                // the generator is shared by concurrently evaluated strata
+                std::lock_guard<std::mutex> guard(planMutex);
+                auto query = planner.execute([&](const std::string& name) -> const RelationWrapper& {
+                    return generator->getRelation(name);
+                });
+                if (query != nullptr) {
+                    auto plan = generator->generateTree(*query);
+                    shadow.setPlan(std::move(plan), std::move(query));
+                }
+            }
+            return execute(shadow.getPlan(), ctxt);
+        }
+
+        // a tiered query has no RAM counterpart of its own; its shadow is the original query
+        case I_TieredQuery: {
+            const auto& shadow = *static_cast<const interpreter::TieredQuery*>(node);
+            if (shadow.countExecution()) {
+                shadow.compileNative();
+            }
+            return execute(shadow.getChild(), ctxt);
+        }
+
         CASE(MergeExtend)
             auto& src = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getSourceId()).get());
             auto& trg = *static_cast<EqrelRelation*>(getRelationHandle(shadow.getTargetId()).get());
@@ -1474,9 +1631,9 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
         ESAC(Swap)
 
         CASE(Assign)
-            const std::string& name = cur.getVariable().getName();
+            const auto& variable = *static_cast<const interpreter::Variable*>(shadow.getLhs());
             const RamDomain val = execute(shadow.getRhs(), ctxt);
-            ctxt.setVariable(name, val);
+            ctxt.setVariable(variable.getSlot(), val);
             return true;
         ESAC(Assign)
     }
@@ -1489,7 +1646,6 @@ RamDomain Engine::execute(const Node* node, Context& ctxt) {
 
 template <typename Rel>
 RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     std::size_t viewPos = shadow.getViewId();
 
     if (profileEnabled && !shadow.isTemp()) {
@@ -1499,7 +1655,7 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
     const auto& superInfo = shadow.getSuperInst();
     // for total we use the exists test
     if (shadow.isTotalSearch()) {
-        souffle::Tuple<RamDomain, Arity> tuple;
+        auto tuple = createTuple<Rel>(superInfo.first.size());
         TUPLE_COPY_FROM(tuple, superInfo.first);
         /* TupleElement */
         for (const auto& tupleElement : superInfo.tupleFirst) {
@@ -1513,8 +1669,8 @@ RamDomain Engine::evalExistenceCheck(const ExistenceCheck& shadow, Context& ctxt
     }
 
     // for partial we search for lower and upper boundaries
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     TUPLE_COPY_FROM(low, superInfo.first);
     TUPLE_COPY_FROM(high, superInfo.second);
 
@@ -1577,14 +1733,95 @@ RamDomain Engine::evalProvenanceExistenceCheck(const ProvenanceExistenceCheck& s
     return (*equalRange.begin())[Arity - 1] <= execute(shadow.getChild(), ctxt);
 }
 
-template <typename Rel>
-RamDomain Engine::evalScan(const Rel& rel, const ram::Scan& cur, const Scan& shadow, Context& ctxt) {
-    for (const auto& tuple : rel.scan()) {
-        ctxt[cur.getTupleId()] = tuple.data();
-        if (!execute(shadow.getNestedOperation(), ctxt)) {
-            break;
+/** Number of tuples of a task of a split range */
+constexpr std::size_t splitGrain = 256;
+
+/**
+ * A thread's share of an outer parallel loop is the size of the loop divided by
+ * the number of threads, and each outer tuple costs at least one evaluation of
+ * the nested operation. Only a nested range longer than that share makes its
+ * thread's work longer than the others', so shorter ranges are not split.
+ */
+std::size_t Engine::getSplitThreshold(std::size_t outerSize) const {
+    return std::max(4 * splitGrain, outerSize / std::max<std::size_t>(numOfThreads, 1));
+}
+
+/**
+ * Evaluate the nested operation for each tuple of a range. Inside a parallel
+ * operation, a range that turns out to be longer than the split threshold of the
+ * operation is split: after the first tuples, the rest is handed out in tasks
+ * that idle threads of the team take over, so that a single heavy key does not
+ * keep one thread busy while the others wait at the end of the loop.
+ *
+ * When the loop of a task breaks, a flag shared by all tasks of the range stops
+ * the others, and the tasks of the ranges nested in them.
+ *
+ * Tasks run on any thread of the team. A task may evaluate an operation that
+ * opens a parallel region of its own with PARALLEL_START; nested parallelism is
+ * disabled, so that region runs on the thread of the task alone.
+ */
+template <typename Range>
+void Engine::evalSplitting(const Range& range, std::size_t tupleId, const Node* nested, Context& ctxt) {
+    const SplitStop* outer = ctxt.getSplitStop();
+    const std::size_t threshold = ctxt.getSplitThreshold();
+
+    auto it = range.begin();
+    const auto end = range.end();
+    for (std::size_t n = 0; it != end && n < threshold; ++it, ++n) {
+        if (outer != nullptr && outer->stopped()) {
+            return;
+        }
+        ctxt[tupleId] = (*it).data();
+        if (!execute(nested, ctxt)) {
+            return;
+        }
+    }
+
+#ifdef _OPENMP
+    const auto* views = ctxt.getParallelViews();
+    if (it != end && views != nullptr) {
+        SplitStop stop;
+        stop.outer = outer;
+        while (it != end && !stop.stopped()) {
+            auto first = it;
+            for (std::size_t n = 0; it != end && n < splitGrain; ++it, ++n) {
+            }
+            auto last = it;
+#pragma omp task default(shared) firstprivate(first, last)
+            if (!stop.stopped()) {
+                Context taskCtxt(ctxt);
+                taskCtxt.copyTuples(ctxt);
+                taskCtxt.setParallelViews(views, threshold);
+                taskCtxt.setSplitStop(&stop);
+                for (const auto& info : *views) {
+                    taskCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
+                }
+                for (; first != last && !stop.stopped(); ++first) {
+                    taskCtxt[tupleId] = (*first).data();
+                    if (!execute(nested, taskCtxt)) {
+                        stop.flag = true;
+                    }
+                }
+            }
         }
+#pragma omp taskwait
+        return;
     }
+#endif
+    for (; it != end; ++it) {
+        if (outer != nullptr && outer->stopped()) {
+            return;
+        }
+        ctxt[tupleId] = (*it).data();
+        if (!execute(nested, ctxt)) {
+            return;
+        }
+    }
+}
+
+template <typename Rel>
+RamDomain Engine::evalScan(const Rel& rel, const ram::Scan& cur, const Scan& shadow, Context& ctxt) {
+    evalSplitting(rel.scan(), cur.getTupleId(), shadow.getNestedOperation(), ctxt);
     return true;
 }
 
@@ -1597,6 +1834,7 @@ RamDomain Engine::evalParallelScan(
 
     PARALLEL_START
         Context newCtxt(ctxt);
+        newCtxt.setParallelViews(&viewContext->getViewInfoForNested(), getSplitThreshold(rel.size()));
         auto viewInfo = viewContext->getViewInfoForNested();
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
@@ -1624,7 +1862,6 @@ template <typename Rel>
 RamDomain Engine::evalEstimateJoinSize(
         const Rel& rel, const ram::EstimateJoinSize& cur, const EstimateJoinSize& shadow, Context& ctxt) {
     (void)ctxt;
-    constexpr std::size_t Arity = Rel::Arity;
     bool onlyConstants = true;
 
     for (auto col : cur.getKeyColumns()) {
@@ -1678,7 +1915,7 @@ RamDomain Engine::evalEstimateJoinSize(
     if (!index->scan().empty()) {
         // assign first tuple as prev as a dummy
         bool first = true;
-        Tuple<RamDomain, Arity> prev = *index->scan().begin();
+        auto prev = *index->scan().begin();
 
         for (const auto& tuple : index->scan()) {
             // only if every constant matches do we consider the tuple
@@ -1736,22 +1973,16 @@ RamDomain Engine::evalEstimateJoinSize(
 
 template <typename Rel>
 RamDomain Engine::evalIndexScan(const ram::IndexScan& cur, const IndexScan& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     // create pattern tuple for range query
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
     auto view = Rel::castView(ctxt.getView(viewId));
     // conduct range query
-    for (const auto& tuple : view->range(low, high)) {
-        ctxt[cur.getTupleId()] = tuple.data();
-        if (!execute(shadow.getNestedOperation(), ctxt)) {
-            break;
-        }
-    }
+    evalSplitting(view->range(low, high), cur.getTupleId(), shadow.getNestedOperation(), ctxt);
     return true;
 }
 
@@ -1761,16 +1992,16 @@ RamDomain Engine::evalParallelIndexScan(
     auto viewContext = shadow.getViewContext();
 
     // create pattern tuple for range query
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t indexPos = shadow.getViewId();
     auto pStream = rel.partitionRange(indexPos, low, high, numOfThreads * 20);
     PARALLEL_START
         Context newCtxt(ctxt);
+        newCtxt.setParallelViews(&viewContext->getViewInfoForNested(), getSplitThreshold(rel.size()));
         auto viewInfo = viewContext->getViewInfoForNested();
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
@@ -1817,6 +2048,7 @@ RamDomain Engine::evalParallelIfExists(
     auto viewInfo = viewContext->getViewInfoForNested();
     PARALLEL_START
         Context newCtxt(ctxt);
+        newCtxt.setParallelViews(&viewContext->getViewInfoForNested(), getSplitThreshold(rel.size()));
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
@@ -1843,10 +2075,9 @@ RamDomain Engine::evalParallelIfExists(
 template <typename Rel>
 RamDomain Engine::evalIndexIfExists(
         const ram::IndexIfExists& cur, const IndexIfExists& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -1870,10 +2101,9 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
     auto viewInfo = viewContext->getViewInfoForNested();
 
     // create pattern tuple for range query
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t indexPos = shadow.getViewId();
@@ -1881,6 +2111,7 @@ RamDomain Engine::evalParallelIndexIfExists(const Rel& rel, const ram::ParallelI
 
     PARALLEL_START
         Context newCtxt(ctxt);
+        newCtxt.setParallelViews(&viewContext->getViewInfoForNested(), getSplitThreshold(rel.size()));
         for (const auto& info : viewInfo) {
             newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
         }
@@ -2078,11 +2309,10 @@ RamDomain Engine::evalParallelIndexAggregate(
         newCtxt.createView(*getRelationHandle(info[0]), info[1], info[2]);
     }
     // init temporary tuple for this level
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
     // get lower and upper boundaries for iteration
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -2095,10 +2325,9 @@ template <typename Rel>
 RamDomain Engine::evalIndexAggregate(
         const ram::IndexAggregate& cur, const IndexAggregate& shadow, Context& ctxt) {
     // init temporary tuple for this level
-    const std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> low;
-    souffle::Tuple<RamDomain, Arity> high;
+    auto low = createTuple<Rel>(superInfo.first.size());
+    auto high = createTuple<Rel>(superInfo.first.size());
     CAL_SEARCH_BOUND(superInfo, low, high);
 
     std::size_t viewId = shadow.getViewId();
@@ -2109,9 +2338,8 @@ RamDomain Engine::evalIndexAggregate(
 
 template <typename Rel>
 RamDomain Engine::evalInsert(Rel& rel, const Insert& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> tuple;
+    auto tuple = createTuple<Rel>(superInfo.first.size());
     TUPLE_COPY_FROM(tuple, superInfo.first);
 
     /* TupleElement */
@@ -2130,9 +2358,8 @@ RamDomain Engine::evalInsert(Rel& rel, const Insert& shadow, Context& ctxt) {
 
 template <typename Rel>
 RamDomain Engine::evalErase(Rel& rel, const Erase& shadow, Context& ctxt) {
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> tuple;
+    auto tuple = createTuple<Rel>(superInfo.first.size());
     TUPLE_COPY_FROM(tuple, superInfo.first);
 
     /* TupleElement */
@@ -2155,9 +2382,8 @@ RamDomain Engine::evalGuardedInsert(Rel& rel, const GuardedInsert& shadow, Conte
         return true;
     }
 
-    constexpr std::size_t Arity = Rel::Arity;
     const auto& superInfo = shadow.getSuperInst();
-    souffle::Tuple<RamDomain, Arity> tuple;
+    auto tuple = createTuple<Rel>(superInfo.first.size());
     TUPLE_COPY_FROM(tuple, superInfo.first);
 
     /* TupleElement */
@@ -24,6 +24,7 @@
 #include "interpreter/Relation.h"
 #include "ram/TranslationUnit.h"
 #include "ram/analysis/Index.h"
+#include "ram/analysis/StratumDependency.h"
 #include "souffle/RamTypes.h"
 #include "souffle/RecordTable.h"
 #include "souffle/SymbolTable.h"
@@ -31,12 +32,14 @@
 #include "souffle/datastructure/RecordTableImpl.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
 #include "souffle/utility/ContainerUtil.h"
+#include "souffle/utility/RegexUtil.h"
 #include <atomic>
 #include <cstddef>
 #include <deque>
 #include <map>
 #include <memory>
-#include <regex>
+#include <mutex>
+#include <set>
 #include <string>
 #include <vector>
 #ifdef _OPENMP
@@ -78,6 +81,8 @@ public:
 private:
     /** @brief Generate intermediate representation from RAM */
     void generateIR();
+    /** @brief Execute the strata of the main program concurrently along their dependencies */
+    void executeStrata(const ram::analysis::StratumDependencyAnalysis& strata);
     /** @brief Remove a relation from the environment */
     void dropRelation(const std::size_t relId);
     /** @brief Swap the content of two relations */
@@ -112,6 +117,12 @@ private:
     template <typename Rel>
     RamDomain evalProvenanceExistenceCheck(const ProvenanceExistenceCheck& shadow, Context& ctxt);
 
+    /** @brief Return the number of tuples of a nested range evaluated before it is split */
+    std::size_t getSplitThreshold(std::size_t outerSize) const;
+
+    template <typename Range>
+    void evalSplitting(const Range& range, std::size_t tupleId, const Node* nested, Context& ctxt);
+
     template <typename Rel>
     RamDomain evalScan(const Rel& rel, const ram::Scan& cur, const Scan& shadow, Context& ctxt);
 
@@ -182,12 +193,20 @@ private:
     std::map<std::string /*name*/, Own<Node>> subroutine;
     /** main program */
     Own<Node> main;
+    /** Generator of the node trees, kept for re-planned queries */
+    Own<NodeGenerator> generator;
+    /** Serialises the re-planning of adaptive queries */
+    std::mutex planMutex;
+    /** Relations read by a query inserting into them, and those swapped with them, kept up to date */
+    std::set<std::string> eagerIndexRelations;
+    /** The bytes of tuples each relation spilling to disk keeps in memory, or zero for the default */
+    std::size_t diskMemoryBudget = 0;
     /** Number of threads enabled for this program */
     std::size_t numOfThreads;
     /** Profile counter */
     std::atomic<RamDomain> counter{0};
     /** Loop iteration counter */
-    std::size_t iteration = 0;
+    std::atomic<std::size_t> iteration{0};
     /** Profile for rule frequencies */
     std::map<std::string, std::deque<std::atomic<std::size_t>>> frequencies;
     /** Profile for relation reads */
@@ -203,7 +222,7 @@ private:
     /** Symbol table */
     SymbolTableImpl symbolTable;
     /** A cache for regexes */
-    ConcurrentCache<std::string, std::regex> regexCache;
+    ConcurrentCache<RamDomain, RegexMatcher> regexCache;
 };
 
 }  // namespace souffle::interpreter
@@ -15,7 +15,11 @@
 
 #include "interpreter/Generator.h"
 #include "interpreter/Engine.h"
+#include "interpreter/NativeCode.h"
+#include "ram/Erase.h"
+#include "ram/RelationOperation.h"
 #include "ram/UserDefinedAggregator.h"
+#include <set>
 
 namespace souffle::interpreter {
 
@@ -28,6 +32,18 @@ NodeGenerator::NodeGenerator(Engine& engine) : engine(engine), global(engine.get
         assert(relationMap.find(relation.getName()) == relationMap.end() && "double-naming of relations");
         relationMap[relation.getName()] = &relation;
     });
+    const auto& config = global.config();
+    if (config.has("adaptive-join-order") && isNumber(config.get("adaptive-join-order").c_str()) &&
+            !config.has("profile") && !config.has("provenance")) {
+        adaptiveWarmup = std::stoul(config.get("adaptive-join-order"));
+    }
+    if (config.has("insert-buffer") && isNumber(config.get("insert-buffer").c_str())) {
+        insertBufferSize = std::stoul(config.get("insert-buffer"));
+    }
+    if (config.has("tiered-compilation") && isNumber(config.get("tiered-compilation").c_str()) &&
+            NativeProgram::isSupported()) {
+        tieredThreshold = std::stoul(config.get("tiered-compilation"));
+    }
 }
 
 NodePtr NodeGenerator::generateTree(const ram::Node& root) {
@@ -64,7 +80,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::NumericConstant>, const ram::Nu
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Variable>, const ram::Variable& var) {
-    return mk<Variable>(I_Variable, &var);
+    return mk<Variable>(I_Variable, &var, encodeVariable(var.getName()));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::TupleElement>, const ram::TupleElement& access) {
@@ -79,6 +95,9 @@ NodePtr NodeGenerator::visit_(type_identity<ram::AutoIncrement>, const ram::Auto
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::IntrinsicOperator>, const ram::IntrinsicOperator& op) {
+    if (auto code = compileBytecode(op)) {
+        return code;
+    }
     NodePtrVec children;
     for (const auto& arg : op.getArguments()) {
         children.push_back(dispatch(*arg));
@@ -200,10 +219,16 @@ NodePtr NodeGenerator::visit_(type_identity<ram::False>, const ram::False& lfals
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Conjunction>, const ram::Conjunction& conj) {
+    if (auto code = compileBytecode(conj)) {
+        return code;
+    }
     return mk<Conjunction>(I_Conjunction, &conj, dispatch(conj.getLHS()), dispatch(conj.getRHS()));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Negation>, const ram::Negation& neg) {
+    if (auto code = compileBytecode(neg)) {
+        return code;
+    }
     return mk<Negation>(I_Negation, &neg, dispatch(neg.getOperand()));
 }
 
@@ -245,6 +270,9 @@ NodePtr NodeGenerator::visit_(
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Constraint>, const ram::Constraint& relOp) {
+    if (auto code = compileBytecode(relOp)) {
+        return code;
+    }
     auto left = dispatch(relOp.getLHS());
     auto right = dispatch(relOp.getRHS());
     switch (relOp.getOperator()) {
@@ -253,7 +281,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Constraint>, const ram::Constra
             if (const StringConstant* str = dynamic_cast<const StringConstant*>(left.get()); str) {
                 const std::string& pattern = engine.getSymbolTable().unsafeDecode(str->getConstant());
                 try {
-                    std::regex regex(pattern);
+                    RegexMatcher regex(pattern);
                     // treat the string constant as a regex
                     left = mk<RegexConstant>(*str, std::move(regex));
                 } catch (const std::exception&) {
@@ -529,7 +557,10 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Parallel>, const ram::Parallel&
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Loop>, const ram::Loop& loop) {
-    return mk<Loop>(I_Loop, &loop, dispatch(loop.getBody()));
+    loopDepth++;
+    auto body = dispatch(loop.getBody());
+    loopDepth--;
+    return mk<Loop>(I_Loop, &loop, std::move(body));
 }
 
 NodePtr NodeGenerator::visit_(type_identity<ram::Exit>, const ram::Exit& exit) {
@@ -589,6 +620,7 @@ NodePtr NodeGenerator::visit_(type_identity<ram::IO>, const ram::IO& io) {
 NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query) {
     std::shared_ptr<ViewContext> viewContext = std::make_shared<ViewContext>();
     parentQueryViewContext = viewContext;
+    queryBytecode.clear();
     // split terms of conditions of outer-most filter operation
     // into terms that require a context and terms that
     // do not require a view
@@ -628,8 +660,46 @@ NodePtr NodeGenerator::visit_(type_identity<ram::Query>, const ram::Query& query
     viewContext->isParallel =
             visitExists(*next, [&](const Node& n) { return as<ram::AbstractParallel, AllowCrossCast>(n); });
 
+    // the lazily maintained indexes of the relations read by the query are updated before it starts
+    std::set<std::string> read;
+    visit(query, [&](const ram::RelationOperation& op) { read.insert(op.getRelation()); });
+    visit(query, [&](const ram::AbstractExistenceCheck& check) { read.insert(check.getRelation()); });
+    visit(query, [&](const ram::EmptinessCheck& check) { read.insert(check.getRelation()); });
+    visit(query, [&](const ram::RelationSize& size) { read.insert(size.getRelation()); });
+    visit(query, [&](const ram::Erase& erase) { read.insert(erase.getRelation()); });
+    for (const auto& name : read) {
+        viewContext->addReadRelation(encodeRelation(name));
+    }
+
+    // the insertions of parallel queries into relations they do not read are buffered per thread
+    if (insertBufferSize > 0 && viewContext->isParallel) {
+        std::set<std::string> buffered;
+        visit(query, [&](const ram::Insert& insert) {
+            if (!contains(read, insert.getRelation())) {
+                buffered.insert(insert.getRelation());
+            }
+        });
+        for (const auto& name : buffered) {
+            viewContext->addBufferedInsert(encodeRelation(name));
+        }
+        viewContext->insertBufferSize = insertBufferSize;
+    }
+
     auto res = mk<Query>(I_Query, &query, dispatch(*next));
     res->setViewContext(parentQueryViewContext);
+
+    // queries of recursive strata may be re-planned once their relations are populated
+    if (adaptiveWarmup > 0 && loopDepth > 0) {
+        if (auto planner = JoinPlanner::create(query, engine.tUnit, adaptiveWarmup)) {
+            return mk<AdaptiveQuery>(I_AdaptiveQuery, &query, std::move(res), std::move(planner));
+        }
+    }
+
+    // the bytecode of queries of loops is translated to native code once they are hot
+    if (tieredThreshold > 0 && loopDepth > 0 && !queryBytecode.empty()) {
+        return mk<TieredQuery>(
+                I_TieredQuery, &query, std::move(res), std::move(queryBytecode), tieredThreshold);
+    }
     return res;
 }
 
@@ -683,6 +753,32 @@ std::size_t NodeGenerator::encodeIndexPos(RamNode& node) {
     return i;
 };
 
+NodePtr NodeGenerator::compileBytecode(const ram::Node& node) {
+    if (contains(unsupportedBytecode, &node)) {
+        return nullptr;
+    }
+    BytecodeProgram::Environment env;
+    env.mapElement = [&](std::size_t tupleId, std::size_t element) {
+        return orderingContext.mapOrder(tupleId, element);
+    };
+    env.encodeVariable = [&](const std::string& name) { return encodeVariable(name); };
+    env.encodeSymbol = [&](const std::string& symbol) { return engine.getSymbolTable().encode(symbol); };
+    // the sub-trees enclosing an unsupported operation are not compiled again when they are visited
+    std::vector<const ram::Node*> unsupported;
+    auto program = BytecodeProgram::compile(node, env, &unsupported);
+    if (program == nullptr) {
+        unsupportedBytecode.insert(unsupported.begin(), unsupported.end());
+        return nullptr;
+    }
+    auto res = mk<Bytecode>(I_Bytecode, &node, std::move(program));
+    queryBytecode.push_back(res.get());
+    return res;
+}
+
+std::size_t NodeGenerator::encodeVariable(const std::string& name) {
+    return variableTable.emplace(name, variableTable.size()).first->second;
+}
+
 std::size_t NodeGenerator::encodeView(const ram::Node* node) {
     auto pos = viewTable.find(node);
     if (pos != viewTable.end()) {
@@ -719,6 +815,10 @@ RelationHandle* NodeGenerator::getRelationHandle(const std::size_t idx) {
     return engine.relations[idx].get();
 }
 
+const RelationWrapper& NodeGenerator::getRelation(const std::string& relName) {
+    return **getRelationHandle(encodeRelation(relName));
+}
+
 bool NodeGenerator::requireView(const ram::Node* node) {
     if (isA<ram::AbstractExistenceCheck>(node)) {
         return true;
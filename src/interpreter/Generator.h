@@ -20,6 +20,7 @@
 #include "Global.h"
 #include "RelationTag.h"
 #include "interpreter/Index.h"
+#include "interpreter/JoinPlanner.h"
 #include "interpreter/Relation.h"
 #include "interpreter/ViewContext.h"
 #include "ram/AbstractExistenceCheck.h"
@@ -91,6 +92,7 @@
 #include "souffle/RamTypes.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StringUtil.h"
 #include <algorithm>
 #include <array>
 #include <cstddef>
@@ -101,6 +103,7 @@
 #include <string>
 #include <typeinfo>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -126,6 +129,9 @@ public:
      */
     NodePtr generateTree(const ram::Node& root);
 
+    /** @brief Get the current instance of a relation */
+    const RelationWrapper& getRelation(const std::string& relName);
+
     NodePtr visit_(type_identity<ram::NumericConstant>, const ram::NumericConstant& num) override;
 
     NodePtr visit_(type_identity<ram::Variable>, const ram::Variable& var) override;
@@ -305,6 +311,12 @@ private:
     /** @brief Encode and return the View id of an operation. */
     std::size_t encodeView(const ram::Node* node);
 
+    /** @brief Compile an expression or condition to bytecode, return nullptr if unsupported */
+    NodePtr compileBytecode(const ram::Node& node);
+
+    /** @brief Encode and return the slot of a variable */
+    std::size_t encodeVariable(const std::string& name);
+
     /** @brief get arity of relation */
     const ram::Relation& lookup(const std::string& relName);
 
@@ -364,10 +376,24 @@ private:
     std::unordered_map<const ram::Node*, std::size_t> viewTable;
     /** Environment encoding, store a mapping from ram::Relation to its id */
     std::unordered_map<std::string, std::size_t> relTable;
+    /** Expressions and conditions enclosing operations without a bytecode instruction */
+    std::unordered_set<const ram::Node*> unsupportedBytecode;
+    /** Bytecode programs generated for the current query */
+    std::vector<const Bytecode*> queryBytecode;
+    /** Environment encoding, store a mapping from variable names to their slots */
+    std::unordered_map<std::string, std::size_t> variableTable;
     /** name / relation mapping */
     std::unordered_map<std::string, const ram::Relation*> relationMap;
     /** ordering context */
     OrderingContext orderingContext = OrderingContext(*this);
+    /** Nesting depth of loops during the generation */
+    std::size_t loopDepth = 0;
+    /** Number of warm-up iterations of adaptive queries, zero if join orders are fixed */
+    std::size_t adaptiveWarmup = 0;
+    /** Number of tuples a thread of a parallel query buffers per relation, zero if not buffered */
+    std::size_t insertBufferSize = 0;
+    /** Number of executions after which a query of a loop runs natively, zero if it never does */
+    std::size_t tieredThreshold = 0;
     /** Reference to the engine instance */
     Engine& engine;
     /** Reference to global */
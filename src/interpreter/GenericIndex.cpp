@@ -0,0 +1,29 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file GenericIndex.cpp
+ *
+ * Interpreter index with generic interface.
+ *
+ ***********************************************************************/
+
+#include "interpreter/Relation.h"
+#include "ram/Relation.h"
+#include "ram/analysis/Index.h"
+
+namespace souffle::interpreter {
+
+Own<RelationWrapper> createGenericRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection) {
+    return mk<Relation<Dynamic, Generic>>(
+            id.getArity(), id.getAuxiliaryArity(), id.getName(), indexSelection);
+}
+
+}  // namespace souffle::interpreter
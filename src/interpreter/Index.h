@@ -21,15 +21,20 @@
 #include "souffle/datastructure/UnionFind.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
 #include "souffle/utility/StreamUtil.h"
+#include "souffle/utility/span.h"
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <iosfwd>
 #include <iterator>
 #include <memory>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -139,6 +144,17 @@ struct ViewWrapper {
     virtual ~ViewWrapper() = default;
 };
 
+/**
+ * Determines whether a data structure supports the bulk insertion of a batch of tuples.
+ */
+template <typename Data, typename Tuple, typename = void>
+struct supports_bulk_insert : std::false_type {};
+
+template <typename Data, typename Tuple>
+struct supports_bulk_insert<Data, Tuple,
+        std::void_t<decltype(std::declval<Data&>().bulkInsert(std::declval<std::vector<Tuple>&>()))>>
+        : std::true_type {};
+
 /**
  * An index is an abstraction of a data structure
  */
@@ -245,6 +261,55 @@ public:
         }
     }
 
+    /**
+     * Inserts a batch of tuples, building the data structure bulk-wise if supported.
+     */
+    void insertBatch(const std::vector<Tuple>& tuples) {
+        if constexpr (supports_bulk_insert<Data, Tuple>::value) {
+            std::vector<Tuple> encoded;
+            encoded.reserve(tuples.size());
+            for (const auto& tuple : tuples) {
+                encoded.push_back(order.encode(tuple));
+            }
+            data.bulkInsert(encoded);
+        } else {
+            for (const auto& tuple : tuples) {
+                this->insert(tuple);
+            }
+        }
+    }
+
+    /**
+     * Inserts a batch of tuples one by one in the order of this index, such that
+     * consecutive insertions share their hints. Unlike a bulk insertion, several
+     * threads may merge their batches at the same time.
+     */
+    void mergeBatch(const std::vector<Tuple>& tuples) {
+        std::vector<Tuple> encoded;
+        encoded.reserve(tuples.size());
+        for (const auto& tuple : tuples) {
+            encoded.push_back(order.encode(tuple));
+        }
+        std::sort(encoded.begin(), encoded.end());
+        data.insert(encoded.begin(), encoded.end());
+    }
+
+    /**
+     * Enables or disables the reorganisation of the data structure during insertions.
+     * Only supported by data structures reorganising themselves, e.g. compressed or disk sets.
+     */
+    void setCompaction(bool enable) {
+        data.setCompaction(enable);
+    }
+
+    /**
+     * Sets the number of bytes of tuples kept in memory.
+     * Only supported by data structures spilling to disk.
+     */
+    void setMemoryBudget(std::size_t bytes) {
+        data.setMemoryBudget(bytes);
+    }
+
     /**
      * Tests whether the given tuple is present in this index or not.
      */
@@ -417,6 +482,12 @@ public:
         data = src.data;
     }
 
+    void insertBatch(const std::vector<Tuple>& tuples) {
+        if (!tuples.empty()) {
+            data = true;
+        }
+    }
+
     bool contains(const Tuple& /* t */) const {
         return data;
     }
@@ -449,6 +520,395 @@ public:
     }
 };
 
+/**
+ * A partial specialization for Brie indexes.
+ *
+ * Tries are ordered by the unsigned representation of their elements, so a
+ * range query can not be answered by a lower and an upper bound. Since only
+ * equality constraints are indexed for Brie relations, a range query binds a
+ * prefix of the order to single values, and is answered by the boundaries of
+ * the trie for that prefix.
+ */
+template <std::size_t _Arity>
+class Index<_Arity, Brie> {
+public:
+    static constexpr std::size_t Arity = _Arity;
+    using Data = Brie<Arity>;
+    using Tuple = typename souffle::Tuple<RamDomain, Arity>;
+    using iterator = typename Data::iterator;
+    using Hints = typename Data::operation_hints;
+
+    Index(Order order) : order(std::move(order)) {}
+
+protected:
+    Order order;
+    Data data;
+
+    /**
+     * Obtains the tuples sharing the prefix of the given bounds on which both
+     * bounds agree.
+     */
+    static souffle::range<iterator> boundaries(
+            const Data& data, const Tuple& low, const Tuple& high, Hints& hints) {
+        std::size_t levels = 0;
+        while (levels < Arity && low[levels] == high[levels]) {
+            levels++;
+        }
+        return boundaries(data, levels, low, hints, std::make_index_sequence<Arity + 1>());
+    }
+
+    template <std::size_t... Levels>
+    static souffle::range<iterator> boundaries(const Data& data, std::size_t levels, const Tuple& entry,
+            Hints& hints, std::index_sequence<Levels...>) {
+        souffle::range<iterator> res(data.end(), data.end());
+        ((levels == Levels && (res = data.template getBoundaries<Levels>(entry, hints), true)) || ...);
+        return res;
+    }
+
+public:
+    /**
+     * A view on a relation caching the last boundaries looked up (not thread safe!).
+     */
+    class View : public ViewWrapper {
+        mutable Hints hints;
+        const Data& data;
+
+    public:
+        View(const Data& data) : data(data) {}
+
+        bool contains(const Tuple& entry) {
+            return data.contains(entry, hints);
+        }
+
+        bool contains(const Tuple& low, const Tuple& high) {
+            return !range(low, high).empty();
+        }
+
+        souffle::range<iterator> range(const Tuple& low, const Tuple& high) {
+            return boundaries(data, low, high, hints);
+        }
+    };
+
+public:
+    View createView() {
+        return View(this->data);
+    }
+
+    iterator begin() const {
+        return data.begin();
+    }
+
+    iterator end() const {
+        return data.end();
+    }
+
+    Order getOrder() const {
+        return order;
+    }
+
+    bool empty() const {
+        return data.empty();
+    }
+
+    std::size_t size() const {
+        return data.size();
+    }
+
+    bool insert(const Tuple& tuple) {
+        return data.insert(order.encode(tuple));
+    }
+
+    void insert(const Index<Arity, Brie>& src) {
+        data.insertAll(src.data);
+    }
+
+    void insertBatch(const std::vector<Tuple>& tuples) {
+        std::vector<Tuple> encoded;
+        encoded.reserve(tuples.size());
+        for (const auto& tuple : tuples) {
+            encoded.push_back(order.encode(tuple));
+        }
+        data.bulkInsert(encoded);
+    }
+
+    bool contains(const Tuple& tuple) const {
+        return data.contains(tuple);
+    }
+
+    bool contains(const Tuple& low, const Tuple& high) const {
+        return !range(low, high).empty();
+    }
+
+    souffle::range<iterator> scan() const {
+        return {data.begin(), data.end()};
+    }
+
+    souffle::range<iterator> range(const Tuple& low, const Tuple& high) const {
+        Hints hints;
+        return boundaries(data, low, high, hints);
+    }
+
+    std::vector<souffle::range<iterator>> partitionScan(std::size_t partitionCount) const {
+        return data.partition(static_cast<unsigned>(partitionCount));
+    }
+
+    std::vector<souffle::range<iterator>> partitionRange(
+            const Tuple& low, const Tuple& high, std::size_t partitionCount) const {
+        return this->range(low, high).partition(partitionCount);
+    }
+
+    void clear() {
+        data.clear();
+    }
+};
+
+/**
+ * A specialization for generic indexes, serving tuples of an arity only known
+ * at runtime. Tuples are encoded by the order of the index and stored as rows
+ * of a fixed stride, which are ordered by a B-tree over pointers to the rows.
+ *
+ * Rows are allocated in blocks per lane, such that threads can insert
+ * concurrently, and keep their address until the index is cleared.
+ */
+template <>
+class Index<Dynamic, Generic> {
+public:
+    static constexpr std::size_t Arity = Dynamic;
+    using Data = Generic<Dynamic>;
+    using Tuple = std::vector<RamDomain>;
+    using Hints = typename Data::operation_hints;
+
+    /**
+     * An iterator presenting the rows of the B-tree as tuples.
+     */
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = span<const RamDomain>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = value_type;
+
+        iterator() = default;
+        iterator(typename Data::iterator iter, std::size_t arity) : iter(std::move(iter)), arity(arity) {}
+
+        bool operator==(const iterator& other) const {
+            return iter == other.iter;
+        }
+
+        bool operator!=(const iterator& other) const {
+            return iter != other.iter;
+        }
+
+        value_type operator*() const {
+            return {*iter, arity};
+        }
+
+        iterator& operator++() {
+            ++iter;
+            return *this;
+        }
+
+    private:
+        typename Data::iterator iter;
+        std::size_t arity = 0;
+    };
+
+    Index(Order order)
+            : order(std::move(order)), arity(this->order.size()),
+              data(RowComparator{arity}, RowComparator{arity}), cmp{arity},
+              lanes(static_cast<std::size_t>(MAX_THREADS)),
+              storage(std::make_unique<Lane[]>(lanes.lanes())) {}
+
+protected:
+    // the number of rows allocated at once
+    static constexpr std::size_t BlockRows = 1024;
+
+    /** The rows allocated by a lane */
+    struct Lane {
+        std::vector<std::unique_ptr<RamDomain[]>> blocks;
+        // the number of rows used in the last block
+        std::size_t used = BlockRows;
+    };
+
+    Order order;
+    std::size_t arity;
+    Data data;
+    RowComparator cmp;
+    mutable ConcurrentLanes lanes;
+    std::unique_ptr<Lane[]> storage;
+
+    /**
+     * Allocates a row in the blocks of the given lane, which must be guarded.
+     */
+    RamDomain* allocate(std::size_t lane) {
+        Lane& local = storage[lane];
+        if (local.used == BlockRows) {
+            local.blocks.push_back(std::make_unique<RamDomain[]>(BlockRows * arity));
+            local.used = 0;
+        }
+        return local.blocks.back().get() + arity * local.used++;
+    }
+
+    souffle::range<iterator> wrap(typename Data::iterator begin, typename Data::iterator end) const {
+        return {iterator(std::move(begin), arity), iterator(std::move(end), arity)};
+    }
+
+public:
+    /**
+     * A view on a relation caching local access patterns (not thread safe!).
+     */
+    class View : public ViewWrapper {
+        mutable Hints hints;
+        const Index& index;
+
+    public:
+        View(const Index& index) : index(index) {}
+
+        bool contains(const Tuple& entry) {
+            return index.data.contains(entry.data(), hints);
+        }
+
+        bool contains(const Tuple& low, const Tuple& high) {
+            return !range(low, high).empty();
+        }
+
+        souffle::range<iterator> range(const Tuple& low, const Tuple& high) {
+            if (index.cmp(low.data(), high.data()) > 0) {
+                return index.wrap(index.data.end(), index.data.end());
+            }
+            return index.wrap(
+                    index.data.lower_bound(low.data(), hints), index.data.upper_bound(high.data(), hints));
+        }
+    };
+
+public:
+    View createView() {
+        return View(*this);
+    }
+
+    iterator begin() const {
+        return iterator(data.begin(), arity);
+    }
+
+    iterator end() const {
+        return iterator(data.end(), arity);
+    }
+
+    Order getOrder() const {
+        return order;
+    }
+
+    bool empty() const {
+        return data.empty();
+    }
+
+    std::size_t size() const {
+        return data.size();
+    }
+
+    /**
+     * Inserts a tuple, given in the natural order of its attributes.
+     */
+    bool insert(const RamDomain* tuple) {
+        const auto lane = lanes.threadLane();
+        auto guard = lanes.guard(lane);
+        RamDomain* row = allocate(lane);
+        for (std::size_t i = 0; i < arity; ++i) {
+            row[i] = tuple[order[i]];
+        }
+        if (data.insert(row)) {
+            return true;
+        }
+        // the row is the last one allocated by this lane, so it can be reused
+        --storage[lane].used;
+        return false;
+    }
+
+    bool insert(const Tuple& tuple) {
+        return insert(tuple.data());
+    }
+
+    /**
+     * Inserts a batch of tuples stored consecutively, building the B-tree bulk-wise.
+     * Rows are only allocated for the tuples not yet present.
+     */
+    void insertBatch(const RamDomain* tuples, std::size_t count) {
+        // encode the batch and drop the duplicates before allocating rows
+        std::vector<RamDomain> encoded(count * arity);
+        std::vector<const RamDomain*> keys;
+        keys.reserve(count);
+        for (std::size_t j = 0; j < count; ++j) {
+            RamDomain* key = encoded.data() + j * arity;
+            const RamDomain* tuple = tuples + j * arity;
+            for (std::size_t i = 0; i < arity; ++i) {
+                key[i] = tuple[order[i]];
+            }
+            keys.push_back(key);
+        }
+        auto less = [&](const RamDomain* a, const RamDomain* b) { return cmp.less(a, b); };
+        auto equal = [&](const RamDomain* a, const RamDomain* b) { return cmp.equal(a, b); };
+        std::sort(keys.begin(), keys.end(), less);
+        keys.erase(std::unique(keys.begin(), keys.end(), equal), keys.end());
+
+        const auto lane = lanes.threadLane();
+        auto guard = lanes.guard(lane);
+        std::vector<const RamDomain*> rows;
+        rows.reserve(keys.size());
+        for (const RamDomain* key : keys) {
+            if (data.contains(key)) {
+                continue;
+            }
+            RamDomain* row = allocate(lane);
+            std::copy_n(key, arity, row);
+            rows.push_back(row);
+        }
+        data.bulkInsert(rows);
+    }
+
+    /**
+     * Tests whether the given tuple, encoded by the order of this index, is present.
+     */
+    bool contains(const Tuple& tuple) const {
+        return data.contains(tuple.data());
+    }
+
+    bool contains(const Tuple& low, const Tuple& high) const {
+        return !range(low, high).empty();
+    }
+
+    souffle::range<iterator> scan() const {
+        return wrap(data.begin(), data.end());
+    }
+
+    souffle::range<iterator> range(const Tuple& low, const Tuple& high) const {
+        if (cmp(low.data(), high.data()) > 0) {
+            return wrap(data.end(), data.end());
+        }
+        return wrap(data.lower_bound(low.data()), data.upper_bound(high.data()));
+    }
+
+    std::vector<souffle::range<iterator>> partitionScan(std::size_t partitionCount) const {
+        auto chunks = data.partition(partitionCount);
+        std::vector<souffle::range<iterator>> res;
+        res.reserve(chunks.size());
+        for (const auto& cur : chunks) {
+            res.push_back(wrap(cur.begin(), cur.end()));
+        }
+        return res;
+    }
+
+    std::vector<souffle::range<iterator>> partitionRange(
+            const Tuple& low, const Tuple& high, std::size_t partitionCount) const {
+        return this->range(low, high).partition(partitionCount);
+    }
+
+    void clear() {
+        data.clear();
+        storage = std::make_unique<Lane[]>(lanes.lanes());
+    }
+};
+
 /**
  * For EqrelIndex we do inheritence since EqrelIndex only diff with one extra function.
  */
@@ -0,0 +1,382 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file JoinPlanner.cpp
+ *
+ * Implementation of the adaptive join-order planner.
+ *
+ ***********************************************************************/
+
+#include "interpreter/JoinPlanner.h"
+#include "RelationTag.h"
+#include "interpreter/Relation.h"
+#include "ram/AutoIncrement.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/Filter.h"
+#include "ram/IndexScan.h"
+#include "ram/Insert.h"
+#include "ram/ParallelIndexScan.h"
+#include "ram/ParallelScan.h"
+#include "ram/Relation.h"
+#include "ram/Scan.h"
+#include "ram/TupleElement.h"
+#include "ram/UndefValue.h"
+#include "ram/analysis/Index.h"
+#include "ram/analysis/Relation.h"
+#include "ram/utility/Utils.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <numeric>
+#include <unordered_set>
+
+namespace souffle::interpreter {
+
+namespace {
+
+/** Tuples referenced by a RAM node */
+std::set<std::size_t> referencedTuples(const ram::Node& node) {
+    std::set<std::size_t> tuples;
+    visit(node, [&](const ram::TupleElement& element) { tuples.insert(element.getTupleId()); });
+    return tuples;
+}
+
+bool isSubset(const std::set<std::size_t>& lhs, const std::set<std::size_t>& rhs) {
+    return std::includes(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+}  // namespace
+
+Own<JoinPlanner> JoinPlanner::create(
+        const ram::Query& query, const ram::TranslationUnit& tUnit, std::size_t warmup) {
+    const auto& isa = tUnit.getAnalysis<ram::analysis::IndexAnalysis>();
+    const auto& relAnalysis = tUnit.getAnalysis<ram::analysis::RelationAnalysis>();
+
+    Own<JoinPlanner> planner(new JoinPlanner());
+    planner->warmup = warmup;
+
+    // decompose the loop nest into atoms and conjunctive terms
+    const ram::Operation* op = &query.getOperation();
+    while (true) {
+        if (const auto* filter = as<ram::Filter>(op)) {
+            for (auto& term : ram::toConjunctionList(&filter->getCondition())) {
+                planner->terms.push_back({std::move(term), {}});
+            }
+            op = &filter->getOperation();
+            continue;
+        }
+        const auto* scan = as<ram::RelationOperation>(op);
+        if (scan == nullptr) {
+            break;
+        }
+        if (!isA<ram::Scan>(scan) && !isA<ram::IndexScan>(scan)) {
+            return nullptr;
+        }
+        const ram::Relation& rel = relAnalysis.lookup(scan->getRelation());
+        if (rel.getRepresentation() == RelationRepresentation::EQREL) {
+            return nullptr;
+        }
+        if (planner->atoms.empty()) {
+            planner->parallel = isA<ram::ParallelScan>(scan) || isA<ram::ParallelIndexScan>(scan);
+        }
+
+        Atom atom{scan->getRelation(), scan->getTupleId(), rel.getArity(), {}};
+        if (const auto* indexScan = as<ram::IndexScan>(scan)) {
+            const auto [lower, upper] = indexScan->getRangePattern();
+            for (std::size_t col = 0; col < atom.arity; ++col) {
+                if (isUndefValue(lower[col]) && isUndefValue(upper[col])) {
+                    continue;
+                }
+                // range searches are kept as they are
+                if (!(*lower[col] == *upper[col])) {
+                    return nullptr;
+                }
+                auto element = mk<ram::TupleElement>(atom.tupleId, col);
+                planner->terms.push_back(
+                        {mk<ram::Constraint>(BinaryConstraintOp::EQ, std::move(element), clone(lower[col])), {}});
+            }
+        }
+        for (const auto& search : isa.getIndexSelection(atom.relation).getSearches()) {
+            std::vector<std::size_t> columns;
+            bool equalities = true;
+            for (std::size_t col = 0; col < search.arity(); ++col) {
+                if (search[col] == ram::analysis::AttributeConstraint::Equal) {
+                    columns.push_back(col);
+                } else if (search[col] == ram::analysis::AttributeConstraint::Inequal) {
+                    equalities = false;
+                }
+            }
+            if (equalities && !columns.empty()) {
+                atom.searches.push_back(std::move(columns));
+            }
+        }
+        planner->atoms.push_back(std::move(atom));
+        op = &scan->getOperation();
+    }
+
+    // the order of insertions is only observable through auto-increment values
+    auto isOrderDependent = [](const ram::Node& node) {
+        return isA<ram::TupleOperation>(&node) || isA<ram::AutoIncrement>(&node);
+    };
+    if (!isA<ram::Insert>(op) || visitExists(*op, isOrderDependent)) {
+        return nullptr;
+    }
+    if (planner->atoms.size() < 2 || planner->atoms.size() > maxAtoms) {
+        return nullptr;
+    }
+    planner->terminal = clone(op);
+
+    std::set<std::size_t> tupleIds;
+    for (const auto& atom : planner->atoms) {
+        tupleIds.insert(atom.tupleId);
+    }
+    for (auto& term : planner->terms) {
+        if (visitExists(*term.condition, isOrderDependent)) {
+            return nullptr;
+        }
+        term.tuples = referencedTuples(*term.condition);
+        if (!isSubset(term.tuples, tupleIds)) {
+            return nullptr;
+        }
+    }
+
+    // equality terms binding an attribute of one atom to values of other atoms
+    for (std::size_t t = 0; t < planner->terms.size(); ++t) {
+        const auto* constraint = as<ram::Constraint>(planner->terms[t].condition);
+        if (constraint == nullptr || constraint->getOperator() != BinaryConstraintOp::EQ) {
+            continue;
+        }
+        auto addBinding = [&](const ram::Expression& side, const ram::Expression& value) {
+            const auto* element = as<ram::TupleElement>(side);
+            if (element == nullptr) {
+                return;
+            }
+            auto tuples = referencedTuples(value);
+            if (!contains(tuples, element->getTupleId())) {
+                planner->bindings.push_back(
+                        {t, element->getTupleId(), element->getElement(), &value, std::move(tuples)});
+            }
+        };
+        addBinding(constraint->getLHS(), constraint->getRHS());
+        addBinding(constraint->getRHS(), constraint->getLHS());
+    }
+
+    // enumerate all join orders; the first one is the order of the original query
+    std::vector<std::size_t> order(planner->atoms.size());
+    std::iota(order.begin(), order.end(), 0);
+    do {
+        planner->plans.push_back(planner->makePlan(order));
+    } while (std::next_permutation(order.begin(), order.end()));
+
+    return planner;
+}
+
+JoinPlanner::Plan JoinPlanner::makePlan(const std::vector<std::size_t>& order) {
+    Plan plan;
+    std::set<std::size_t> bound;
+    std::vector<bool> used(terms.size(), false);
+
+    auto placeTerms = [&](std::vector<std::size_t>& placed) {
+        for (std::size_t t = 0; t < terms.size(); ++t) {
+            if (!used[t] && isSubset(terms[t].tuples, bound)) {
+                placed.push_back(t);
+                used[t] = true;
+            }
+        }
+    };
+    placeTerms(plan.topTerms);
+
+    for (std::size_t a : order) {
+        const Atom& atom = atoms[a];
+
+        // bindings of the atom whose values are computable at this level
+        std::map<std::size_t, std::size_t> available;
+        for (std::size_t b = 0; b < bindings.size(); ++b) {
+            const Binding& binding = bindings[b];
+            if (binding.tupleId == atom.tupleId && !used[binding.term] && isSubset(binding.tuples, bound)) {
+                available.emplace(binding.column, b);
+            }
+        }
+
+        // pick the most selective search that has an index
+        const std::vector<std::size_t>* best = nullptr;
+        for (const auto& search : atom.searches) {
+            bool covered = std::all_of(
+                    search.begin(), search.end(), [&](std::size_t col) { return contains(available, col); });
+            if (covered && (best == nullptr || search.size() > best->size())) {
+                best = &search;
+            }
+        }
+
+        Level level;
+        level.atom = a;
+        std::vector<std::size_t> columns;
+        if (best != nullptr) {
+            columns = *best;
+            for (std::size_t col : columns) {
+                std::size_t b = available.at(col);
+                level.keys.push_back(b);
+                used[bindings[b].term] = true;
+            }
+        }
+        level.statistic = getStatistic(atom.relation, std::move(columns));
+
+        bound.insert(atom.tupleId);
+        placeTerms(level.terms);
+        plan.levels.push_back(std::move(level));
+    }
+    return plan;
+}
+
+std::size_t JoinPlanner::getStatistic(const std::string& relation, std::vector<std::size_t> columns) {
+    auto key = std::make_pair(relation, columns);
+    auto it = statisticIndex.find(key);
+    if (it != statisticIndex.end()) {
+        return it->second;
+    }
+    std::size_t idx = statistics.size();
+    statistics.push_back({relation, std::move(columns), 0, 0});
+    statisticIndex.emplace(std::move(key), idx);
+    return idx;
+}
+
+void JoinPlanner::sample(const RelationLookup& lookup) {
+    // group the statistics by relation so that each relation is visited once
+    std::map<std::string, std::vector<std::size_t>> byRelation;
+    for (std::size_t s = 0; s < statistics.size(); ++s) {
+        byRelation[statistics[s].relation].push_back(s);
+    }
+
+    for (const auto& [name, indices] : byRelation) {
+        const RelationWrapper& rel = lookup(name);
+        std::vector<std::unordered_set<std::size_t>> keys(indices.size());
+        std::size_t visited = 0;
+        for (auto it = rel.begin(); it != rel.end() && visited < sampleLimit; ++it, ++visited) {
+            const RamDomain* tuple = *it;
+            for (std::size_t i = 0; i < indices.size(); ++i) {
+                const auto& columns = statistics[indices[i]].columns;
+                if (columns.empty()) {
+                    continue;
+                }
+                std::size_t seed = 0;
+                for (std::size_t col : columns) {
+                    seed ^= std::hash<RamDomain>()(tuple[col]) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+                }
+                keys[i].insert(seed);
+            }
+        }
+
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            Statistic& statistic = statistics[indices[i]];
+            if (statistic.columns.empty()) {
+                statistic.sum += static_cast<double>(rel.size());
+            } else if (!keys[i].empty()) {
+                statistic.sum += static_cast<double>(visited) / static_cast<double>(keys[i].size());
+            }
+            statistic.samples++;
+        }
+    }
+}
+
+double JoinPlanner::estimateCost(const Plan& plan) const {
+    // filters are assumed to be unselective
+    double rows = 1;
+    double cost = 0;
+    for (const auto& level : plan.levels) {
+        const Statistic& statistic = statistics[level.statistic];
+        double matches = statistic.samples == 0 ? 0 : statistic.sum / static_cast<double>(statistic.samples);
+        cost += rows * (1 + matches);
+        rows *= matches;
+    }
+    return cost;
+}
+
+Own<ram::Query> JoinPlanner::execute(const RelationLookup& lookup) {
+    if (!isSampling()) {
+        return nullptr;
+    }
+    sample(lookup);
+    if (executions++ < warmup) {
+        return nullptr;
+    }
+
+    const double current = estimateCost(plans.front());
+    std::size_t best = 0;
+    double bestCost = current;
+    for (std::size_t i = 1; i < plans.size(); ++i) {
+        double cost = estimateCost(plans[i]);
+        if (cost < bestCost) {
+            best = i;
+            bestCost = cost;
+        }
+    }
+    if (best == 0 || bestCost >= current * improvement) {
+        return nullptr;
+    }
+    return translate(plans[best]);
+}
+
+Own<ram::Condition> JoinPlanner::conjunction(const std::vector<std::size_t>& indices) const {
+    Own<ram::Condition> result;
+    for (std::size_t t : indices) {
+        if (result == nullptr) {
+            result = clone(terms[t].condition);
+        } else {
+            result = mk<ram::Conjunction>(std::move(result), clone(terms[t].condition));
+        }
+    }
+    return result;
+}
+
+Own<ram::Query> JoinPlanner::translate(const Plan& plan) const {
+    // build the loop nest inside-out
+    Own<ram::Operation> op = clone(terminal);
+    for (std::size_t k = plan.levels.size(); k-- > 0;) {
+        const Level& level = plan.levels[k];
+        const Atom& atom = atoms[level.atom];
+        if (!level.terms.empty()) {
+            op = mk<ram::Filter>(conjunction(level.terms), std::move(op));
+        }
+
+        bool isParallel = parallel && k == 0;
+        if (level.keys.empty()) {
+            if (isParallel) {
+                op = mk<ram::ParallelScan>(atom.relation, atom.tupleId, std::move(op));
+            } else {
+                op = mk<ram::Scan>(atom.relation, atom.tupleId, std::move(op));
+            }
+            continue;
+        }
+
+        ram::RamPattern pattern;
+        for (std::size_t col = 0; col < atom.arity; ++col) {
+            pattern.first.push_back(mk<ram::UndefValue>());
+            pattern.second.push_back(mk<ram::UndefValue>());
+        }
+        for (std::size_t b : level.keys) {
+            const Binding& binding = bindings[b];
+            pattern.first[binding.column] = clone(binding.value);
+            pattern.second[binding.column] = clone(binding.value);
+        }
+        if (isParallel) {
+            op = mk<ram::ParallelIndexScan>(atom.relation, atom.tupleId, std::move(pattern), std::move(op));
+        } else {
+            op = mk<ram::IndexScan>(atom.relation, atom.tupleId, std::move(pattern), std::move(op));
+        }
+    }
+    if (!plan.topTerms.empty()) {
+        op = mk<ram::Filter>(conjunction(plan.topTerms), std::move(op));
+    }
+    return mk<ram::Query>(std::move(op));
+}
+
+}  // namespace souffle::interpreter
@@ -0,0 +1,175 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file JoinPlanner.h
+ *
+ * Declares the JoinPlanner class, which re-plans the join order of a
+ * query of a recursive stratum based on statistics collected while the
+ * fixpoint is computed.
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Condition.h"
+#include "ram/Expression.h"
+#include "ram/Operation.h"
+#include "ram/Query.h"
+#include "ram/TranslationUnit.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter {
+
+struct RelationWrapper;
+
+/**
+ * @class JoinPlanner
+ * @brief Adaptive join-order planner for a single query.
+ *
+ * The planner decomposes a query that is a nest of (index) scans into its
+ * atoms and the conjunctive terms of its filters and index patterns. It
+ * enumerates all join orders up-front; for each order and atom the equality
+ * terms that are bound by the preceding atoms are turned into an index search,
+ * provided that the index analysis already selected an index for that search.
+ * Hence, no new indexes are needed at runtime.
+ *
+ * While the first iterations of the enclosing loop are evaluated, the planner
+ * samples the relations accessed by the candidate plans in the spirit of
+ * EstimateJoinSize, i.e., the average number of tuples per search key. After
+ * the warm-up, the candidate with the least estimated number of enumerated
+ * tuples is translated back into a RAM query.
+ */
+class JoinPlanner {
+public:
+    /** Maximal number of atoms for which all join orders are enumerated */
+    static constexpr std::size_t maxAtoms = 6;
+
+    /** Maximal number of tuples of a relation visited per sample, bounding the cost of a warm-up iteration */
+    static constexpr std::size_t sampleLimit = 1 << 12;
+
+    /** A new plan must improve the estimated cost of the current plan by this factor */
+    static constexpr double improvement = 0.75;
+
+    /** Lookup of the current instance of a relation */
+    using RelationLookup = std::function<const RelationWrapper&(const std::string&)>;
+
+    /**
+     * @brief Create a planner for a query
+     *
+     * @param query the query to be planned
+     * @param tUnit the translation unit whose index analysis determines the available searches
+     * @param warmup the number of executions of the query before re-planning
+     * @return the planner, or nullptr if the query cannot be re-planned
+     */
+    static Own<JoinPlanner> create(
+            const ram::Query& query, const ram::TranslationUnit& tUnit, std::size_t warmup);
+
+    /** @brief Whether statistics are still being collected, may be called without holding the plan lock */
+    bool isSampling() const {
+        return executions.load(std::memory_order_acquire) <= warmup;
+    }
+
+    /**
+     * @brief Register an execution of the query
+     *
+     * Samples the relations during warm-up. At the end of the warm-up a
+     * cheaper plan is returned if there is one, and nullptr otherwise.
+     */
+    Own<ram::Query> execute(const RelationLookup& lookup);
+
+private:
+    /** A relation accessed by a scan of the query */
+    struct Atom {
+        std::string relation;
+        std::size_t tupleId;
+        std::size_t arity;
+        /** Equality columns of the searches with an index */
+        std::vector<std::vector<std::size_t>> searches;
+    };
+
+    /** An equality term that can be used as a search key for an atom */
+    struct Binding {
+        std::size_t term;
+        std::size_t tupleId;
+        std::size_t column;
+        const ram::Expression* value;
+        std::set<std::size_t> tuples;
+    };
+
+    /** A conjunctive term of the query */
+    struct Term {
+        Own<ram::Condition> condition;
+        std::set<std::size_t> tuples;
+    };
+
+    /** Sampled number of tuples per key of a search on a relation */
+    struct Statistic {
+        std::string relation;
+        std::vector<std::size_t> columns;
+        double sum = 0;
+        std::size_t samples = 0;
+    };
+
+    /** A level of a plan, i.e., an atom with its search and filters */
+    struct Level {
+        std::size_t atom;
+        std::vector<std::size_t> keys;
+        std::size_t statistic;
+        std::vector<std::size_t> terms;
+    };
+
+    /** A candidate plan */
+    struct Plan {
+        std::vector<std::size_t> topTerms;
+        std::vector<Level> levels;
+    };
+
+    JoinPlanner() = default;
+
+    /** Compute the levels of the plan for a join order */
+    Plan makePlan(const std::vector<std::size_t>& order);
+
+    /** Get the statistic of a search on a relation */
+    std::size_t getStatistic(const std::string& relation, std::vector<std::size_t> columns);
+
+    /** Sample all statistics on the current relations */
+    void sample(const RelationLookup& lookup);
+
+    /** Estimate the number of tuples enumerated by a plan */
+    double estimateCost(const Plan& plan) const;
+
+    /** Conjunction of a set of terms */
+    Own<ram::Condition> conjunction(const std::vector<std::size_t>& indices) const;
+
+    /** Translate a plan into a RAM query */
+    Own<ram::Query> translate(const Plan& plan) const;
+
+    std::vector<Atom> atoms;
+    std::vector<Term> terms;
+    std::vector<Binding> bindings;
+    Own<ram::Operation> terminal;
+    bool parallel = false;
+
+    std::vector<Plan> plans;
+    std::vector<Statistic> statistics;
+    std::map<std::pair<std::string, std::vector<std::size_t>>, std::size_t> statisticIndex;
+
+    std::size_t warmup = 0;
+    std::atomic<std::size_t> executions{0};
+};
+
+}  // namespace souffle::interpreter
@@ -0,0 +1,344 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NativeCode.cpp
+ *
+ * Translation of bytecode programs to x86-64 machine code.
+ *
+ ***********************************************************************/
+
+#include "interpreter/NativeCode.h"
+#include "interpreter/Bytecode.h"
+#include "interpreter/Context.h"
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__linux__) || defined(__APPLE__))
+#define SOUFFLE_NATIVE_X86_64
+#include <sys/mman.h>
+#endif
+
+namespace souffle::interpreter {
+
+namespace {
+
+#ifdef SOUFFLE_NATIVE_X86_64
+
+using Opcode = BytecodeProgram::Opcode;
+using Instruction = BytecodeProgram::Instruction;
+
+/**
+ * Emits the machine code of a function
+ *
+ *   RamDomain f(const RamDomain* const* tuples, const RamDomain* variables, std::size_t variableCount)
+ *
+ * following the System V calling convention. The registers of the bytecode
+ * are kept in 8-byte slots of the stack frame. An instruction loads its
+ * operands into eax and ecx, computes into eax, and stores eax into the slot
+ * of its result. The arguments stay in rdi, rsi and rdx throughout.
+ */
+class Assembler {
+public:
+    /** Translate the program, false if an instruction has no translation */
+    bool translate(const std::vector<Instruction>& code) {
+        // sub rsp, frame
+        bytes({0x48, 0x81, 0xEC});
+        imm32(Frame);
+
+        std::vector<std::size_t> offsets;
+        std::vector<std::pair<std::size_t, std::uint32_t>> jumps;
+        for (const auto& ins : code) {
+            offsets.push_back(out.size());
+            if (!translate(ins, jumps)) {
+                return false;
+            }
+        }
+
+        // jumps are relative to the end of their 32-bit displacement
+        for (const auto& [at, target] : jumps) {
+            if (target >= offsets.size()) {
+                return false;
+            }
+            const auto rel = static_cast<std::int32_t>(offsets[target] - (at + 4));
+            std::memcpy(out.data() + at, &rel, 4);
+        }
+        return true;
+    }
+
+    const std::vector<std::uint8_t>& getCode() const {
+        return out;
+    }
+
+private:
+    /** The bytes of the register file, keeping the stack pointer aligned at calls */
+    static constexpr std::uint32_t Frame = 8 * BytecodeProgram::MaxRegisters + 8;
+
+    enum Reg : std::uint8_t { EAX = 0, ECX = 1 };
+
+    bool translate(const Instruction& ins, std::vector<std::pair<std::size_t, std::uint32_t>>& jumps) {
+        const auto a = ins.arg;
+        switch (ins.op) {
+            case Opcode::LoadConstant: loadImmediate(EAX, ins.value); break;
+            case Opcode::LoadElement: loadElement(EAX, a[0], a[1]); break;
+            case Opcode::LoadVariable: loadVariable(a[0]); break;
+
+            // neg eax, not eax
+            case Opcode::Neg: unary(a[0], {0xF7, 0xD8}); break;
+            case Opcode::BNot: unary(a[0], {0xF7, 0xD0}); break;
+            case Opcode::LNot:
+                loadSlot(EAX, a[0]);
+                testEax();
+                setcc(0x94);
+                break;
+
+            // add, sub, imul, and, or, xor eax, ecx
+            case Opcode::Add: binary(a, {0x01, 0xC8}); break;
+            case Opcode::Sub: binary(a, {0x29, 0xC8}); break;
+            case Opcode::Mul: binary(a, {0x0F, 0xAF, 0xC1}); break;
+            case Opcode::BAnd: binary(a, {0x21, 0xC8}); break;
+            case Opcode::BOr: binary(a, {0x09, 0xC8}); break;
+            case Opcode::BXor: binary(a, {0x31, 0xC8}); break;
+
+            // shl, sar, shr eax, cl; the processor masks the count as RAM_BIT_SHIFT_MASK does
+            case Opcode::BShiftL: binary(a, {0xD3, 0xE0}); break;
+            case Opcode::BShiftR: binary(a, {0xD3, 0xF8}); break;
+            case Opcode::UBShiftR: binary(a, {0xD3, 0xE8}); break;
+
+            case Opcode::LAnd: logical(a, 0x20); break;
+            case Opcode::LXor: logical(a, 0x30); break;
+            case Opcode::LOr:
+                // or eax, ecx, then test whether any bit is set
+                binary(a, {0x09, 0xC8});
+                testEax();
+                setcc(0x95);
+                break;
+
+            // cmovl, cmovb, cmovg, cmova eax, ecx
+            case Opcode::Max: binary(a, {0x39, 0xC8}, {0x0F, 0x4C, 0xC1}); break;
+            case Opcode::UMax: binary(a, {0x39, 0xC8}, {0x0F, 0x42, 0xC1}); break;
+            case Opcode::Min: binary(a, {0x39, 0xC8}, {0x0F, 0x4F, 0xC1}); break;
+            case Opcode::UMin: binary(a, {0x39, 0xC8}, {0x0F, 0x47, 0xC1}); break;
+
+            // sete, setne, setl, setb, setle, setbe
+            case Opcode::Eq: compare(a, 0x94); break;
+            case Opcode::Ne: compare(a, 0x95); break;
+            case Opcode::Lt: compare(a, 0x9C); break;
+            case Opcode::ULt: compare(a, 0x92); break;
+            case Opcode::Le: compare(a, 0x9E); break;
+            case Opcode::ULe: compare(a, 0x96); break;
+
+            case Opcode::EqElementConstant:
+            case Opcode::NeElementConstant:
+                loadElement(EAX, a[0], a[1]);
+                loadImmediate(ECX, ins.value);
+                compareRegisters(ins.op == Opcode::EqElementConstant ? 0x94 : 0x95);
+                break;
+            case Opcode::EqElementElement:
+            case Opcode::NeElementElement:
+                loadElement(EAX, a[0], a[1]);
+                loadElement(ECX, a[2], a[3]);
+                compareRegisters(ins.op == Opcode::EqElementElement ? 0x94 : 0x95);
+                break;
+
+            case Opcode::JumpIfZero:
+            case Opcode::JumpIfNonZero:
+                // jz, jnz rel32
+                loadSlot(EAX, a[0]);
+                testEax();
+                bytes({0x0F, static_cast<std::uint8_t>(ins.op == Opcode::JumpIfZero ? 0x84 : 0x85)});
+                jumps.push_back({out.size(), ins.dst});
+                imm32(0);
+                return true;
+
+            case Opcode::Return:
+                // add rsp, frame; ret
+                loadSlot(EAX, a[0]);
+                bytes({0x48, 0x81, 0xC4});
+                imm32(Frame);
+                bytes({0xC3});
+                return true;
+
+            default: return false;
+        }
+        storeSlot(ins.dst);
+        return true;
+    }
+
+    void bytes(std::initializer_list<std::uint8_t> values) {
+        out.insert(out.end(), values);
+    }
+
+    void imm32(std::uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            out.push_back(static_cast<std::uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    /** Emit the prefix widening an operation to the size of RamDomain */
+    void wide() {
+        if (sizeof(RamDomain) == 8) {
+            out.push_back(0x48);
+        }
+    }
+
+    /** mov reg, [rsp + 8 * slot] */
+    void loadSlot(Reg reg, std::uint32_t slot) {
+        wide();
+        bytes({0x8B, static_cast<std::uint8_t>(0x84 | reg << 3), 0x24});
+        imm32(8 * slot);
+    }
+
+    /** mov [rsp + 8 * slot], eax */
+    void storeSlot(std::uint32_t slot) {
+        wide();
+        bytes({0x89, 0x84, 0x24});
+        imm32(8 * slot);
+    }
+
+    /** mov reg, value */
+    void loadImmediate(Reg reg, RamDomain value) {
+        wide();
+        bytes({static_cast<std::uint8_t>(0xB8 | reg)});
+        std::uint8_t raw[sizeof(RamDomain)];
+        std::memcpy(raw, &value, sizeof(RamDomain));
+        out.insert(out.end(), raw, raw + sizeof(RamDomain));
+    }
+
+    /** mov rreg, [rdi + 8 * tuple]; mov reg, [rreg + element] */
+    void loadElement(Reg reg, std::uint32_t tuple, std::uint32_t element) {
+        bytes({0x48, 0x8B, static_cast<std::uint8_t>(0x87 | reg << 3)});
+        imm32(8 * tuple);
+        wide();
+        bytes({0x8B, static_cast<std::uint8_t>(0x80 | reg << 3 | reg)});
+        imm32(static_cast<std::uint32_t>(sizeof(RamDomain) * element));
+    }
+
+    /** Load a variable into eax, zero if it was never assigned */
+    void loadVariable(std::uint32_t slot) {
+        // xor eax, eax; cmp rdx, slot; jbe over the load; mov eax, [rsi + slot]
+        bytes({0x31, 0xC0, 0x48, 0x81, 0xFA});
+        imm32(slot);
+        bytes({0x76, static_cast<std::uint8_t>(sizeof(RamDomain) == 8 ? 7 : 6)});
+        wide();
+        bytes({0x8B, 0x86});
+        imm32(static_cast<std::uint32_t>(sizeof(RamDomain) * slot));
+    }
+
+    /** test eax, eax */
+    void testEax() {
+        wide();
+        bytes({0x85, 0xC0});
+    }
+
+    /** setcc al; movzx eax, al */
+    void setcc(std::uint8_t condition) {
+        bytes({0x0F, condition, 0xC0, 0x0F, 0xB6, 0xC0});
+    }
+
+    void unary(std::uint32_t operand, std::initializer_list<std::uint8_t> op) {
+        loadSlot(EAX, operand);
+        wide();
+        bytes(op);
+    }
+
+    void binary(const std::array<std::uint32_t, 4>& a, std::initializer_list<std::uint8_t> op,
+            std::initializer_list<std::uint8_t> then = {}) {
+        loadSlot(EAX, a[0]);
+        loadSlot(ECX, a[1]);
+        wide();
+        bytes(op);
+        if (then.size() > 0) {
+            wide();
+            bytes(then);
+        }
+    }
+
+    /** cmp eax, ecx; setcc al; movzx eax, al */
+    void compareRegisters(std::uint8_t condition) {
+        wide();
+        bytes({0x39, 0xC8});
+        setcc(condition);
+    }
+
+    void compare(const std::array<std::uint32_t, 4>& a, std::uint8_t condition) {
+        loadSlot(EAX, a[0]);
+        loadSlot(ECX, a[1]);
+        compareRegisters(condition);
+    }
+
+    /** Normalise both operands to 0/1 and combine them by the given byte operation of al and cl */
+    void logical(const std::array<std::uint32_t, 4>& a, std::uint8_t op) {
+        loadSlot(EAX, a[0]);
+        loadSlot(ECX, a[1]);
+        // test eax, eax; setne al; test ecx, ecx; setne cl; op al, cl; movzx eax, al
+        testEax();
+        bytes({0x0F, 0x95, 0xC0});
+        wide();
+        bytes({0x85, 0xC9, 0x0F, 0x95, 0xC1, op, 0xC8, 0x0F, 0xB6, 0xC0});
+    }
+
+    std::vector<std::uint8_t> out;
+};
+
+#endif
+
+}  // namespace
+
+bool NativeProgram::isSupported() {
+#ifdef SOUFFLE_NATIVE_X86_64
+    return true;
+#else
+    return false;
+#endif
+}
+
+Own<NativeProgram> NativeProgram::compile([[maybe_unused]] const BytecodeProgram& program) {
+#ifdef SOUFFLE_NATIVE_X86_64
+    Assembler assembler;
+    if (!assembler.translate(program.getInstructions())) {
+        return nullptr;
+    }
+    const auto& code = assembler.getCode();
+
+    // the memory is written first, and only then made executable
+    void* memory = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (memory == MAP_FAILED) {
+        return nullptr;
+    }
+    std::memcpy(memory, code.data(), code.size());
+    if (mprotect(memory, code.size(), PROT_READ | PROT_EXEC) != 0) {
+        munmap(memory, code.size());
+        return nullptr;
+    }
+    return Own<NativeProgram>(new NativeProgram(memory, code.size()));
+#else
+    return nullptr;
+#endif
+}
+
+NativeProgram::NativeProgram(void* memory, std::size_t size)
+        : memory(memory), size(size), function(reinterpret_cast<Function>(memory)) {}
+
+NativeProgram::~NativeProgram() {
+#ifdef SOUFFLE_NATIVE_X86_64
+    munmap(memory, size);
+#endif
+}
+
+RamDomain NativeProgram::execute(const Context& ctxt) const {
+    const auto& variables = ctxt.getVariables();
+    return function(ctxt.getTuples(), variables.data(), variables.size());
+}
+
+}  // namespace souffle::interpreter
@@ -0,0 +1,69 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved.
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file NativeCode.h
+ *
+ * Declares the native code of bytecode programs, the top tier of the
+ * evaluation of expressions and conditions in the interpreter.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "souffle/RamTypes.h"
+#include "souffle/utility/ContainerUtil.h"
+#include <cstddef>
+
+namespace souffle::interpreter {
+
+class BytecodeProgram;
+class Context;
+
+/**
+ * @class NativeProgram
+ * @brief A bytecode program translated to machine code of the host
+ *
+ * Each instruction is translated into a fixed sequence of machine
+ * instructions, which keeps the registers of the bytecode in the stack frame
+ * of the native function. This removes the dispatch between instructions.
+ * Only x86-64 hosts are supported, and only the instructions on integers and
+ * the loads of tuple elements, constants and variables.
+ */
+class NativeProgram {
+public:
+    /** Whether native code is generated on this host */
+    static bool isSupported();
+
+    /**
+     * Translate a bytecode program. Returns nullptr if the host is not
+     * supported, the program contains an instruction without a translation,
+     * or no executable memory is available.
+     */
+    static Own<NativeProgram> compile(const BytecodeProgram& program);
+
+    NativeProgram(const NativeProgram&) = delete;
+    NativeProgram& operator=(const NativeProgram&) = delete;
+    ~NativeProgram();
+
+    /** Run the program */
+    RamDomain execute(const Context& ctxt) const;
+
+private:
+    using Function = RamDomain (*)(const RamDomain* const*, const RamDomain*, std::size_t);
+
+    NativeProgram(void* memory, std::size_t size);
+
+    /** The executable memory holding the function */
+    void* memory;
+    std::size_t size;
+    Function function;
+};
+
+}  // namespace souffle::interpreter
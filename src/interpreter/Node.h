@@ -23,11 +23,15 @@
 
 #pragma once
 
+#include "interpreter/Bytecode.h"
+#include "interpreter/NativeCode.h"
+#include "interpreter/JoinPlanner.h"
 #include "interpreter/Util.h"
 #include "ram/Relation.h"
 #include "souffle/RamTypes.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/RegexUtil.h"
 
 #ifdef USE_LIBFFI
 #include <ffi.h>
@@ -37,7 +41,6 @@
 #include <cassert>
 #include <cstddef>
 #include <memory>
-#include <regex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -78,6 +81,7 @@ struct RelationWrapper;
     FOR_EACH(Expand, ExistenceCheck)\
     FOR_EACH_PROVENANCE(Expand, ProvenanceExistenceCheck)\
     Forward(Constraint)\
+    Forward(Bytecode)\
     Forward(TupleOperation)\
     FOR_EACH(Expand, Scan)\
     FOR_EACH(Expand, ParallelScan)\
@@ -111,6 +115,8 @@ struct RelationWrapper;
     Forward(LogSize)\
     Forward(IO)\
     Forward(Query)\
+    Forward(AdaptiveQuery)\
+    Forward(TieredQuery)\
     Forward(MergeExtend)\
     Forward(Swap)\
     Forward(Call)
@@ -154,6 +160,14 @@ inline NodeType constructNodeType(Global& glb, std::string tokBase, const ram::R
         return map.at("I_" + tokBase + "_Eqrel_" + arity);
     } else if(rel.getRepresentation() == RelationRepresentation::BTREE_DELETE) {
         return map.at("I_" + tokBase + "_BtreeDelete_" + arity);
+    } else if (!isProvenance && rel.getArity() > MaxSpecializedArity) {
+        return map.at("I_" + tokBase + "_Generic_Dynamic");
+    } else if (rel.getRepresentation() == RelationRepresentation::BRIE && !rel.isNullary()) {
+        return map.at("I_" + tokBase + "_Brie_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::COMPRESSED && !rel.isNullary()) {
+        return map.at("I_" + tokBase + "_Compressed_" + arity);
+    } else if (rel.getRepresentation() == RelationRepresentation::DISK && !rel.isNullary()) {
+        return map.at("I_" + tokBase + "_Disk_" + arity);
     } else if (isProvenance) {
         return map.at("I_" + tokBase + "_Provenance_" + arity);
     } else  {
@@ -431,7 +445,16 @@ class NumericConstant : public Node {
  * @class Variable
  */
 class Variable : public Node {
-    using Node::Node;
+public:
+    Variable(NodeType ty, const ram::Node* sdw, std::size_t slot) : Node(ty, sdw), slot(slot) {}
+
+    /** @brief Get the slot of the variable in the context */
+    std::size_t getSlot() const {
+        return slot;
+    }
+
+private:
+    const std::size_t slot;
 };
 
 /**
@@ -454,15 +477,15 @@ private:
  */
 class RegexConstant : public StringConstant {
 public:
-    RegexConstant(const StringConstant& c, std::optional<std::regex> r)
+    RegexConstant(const StringConstant& c, std::optional<RegexMatcher> r)
             : StringConstant(c.getType(), c.getShadow(), c.getConstant()), regex(std::move(r)) {}
 
-    inline const std::optional<std::regex>& getRegex() const {
+    inline const std::optional<RegexMatcher>& getRegex() const {
         return regex;
     }
 
 private:
-    const std::optional<std::regex> regex;
+    const std::optional<RegexMatcher> regex;
 };
 
 /**
@@ -653,6 +676,36 @@ class Constraint : public BinaryNode {
     using BinaryNode::BinaryNode;
 };
 
+/**
+ * @class Bytecode
+ * @brief An expression or condition compiled to bytecode, its shadow is the compiled RAM node
+ */
+class Bytecode : public Node {
+public:
+    Bytecode(enum NodeType ty, const ram::Node* sdw, Own<BytecodeProgram> program)
+            : Node(ty, sdw), program(std::move(program)) {}
+
+    inline const BytecodeProgram& getProgram() const {
+        return *program;
+    }
+
+    /** @brief get the native code of the program, or nullptr while it runs as bytecode */
+    inline const NativeProgram* getNative() const {
+        return native.get();
+    }
+
+    /** @brief translate the program to native code, if the host supports it */
+    inline void compileNative() const {
+        if (native == nullptr) {
+            native = NativeProgram::compile(*program);
+        }
+    }
+
+private:
+    Own<BytecodeProgram> program;
+    mutable Own<NativeProgram> native;
+};
+
 /**
  * @class TupleOperation
  */
@@ -975,6 +1028,71 @@ class Query : public UnaryNode, public AbstractParallel {
     using UnaryNode::UnaryNode;
 };
 
+/**
+ * @class AdaptiveQuery
+ * @brief Query of a loop whose join order is re-planned after a warm-up
+ *
+ * The child is the query as generated from the program. Once the planner
+ * finds a cheaper join order, the generated plan and its RAM query replace it.
+ */
+class AdaptiveQuery : public UnaryNode {
+public:
+    AdaptiveQuery(enum NodeType ty, const ram::Node* sdw, Own<Node> child, Own<JoinPlanner> planner)
+            : UnaryNode(ty, sdw, std::move(child)), planner(std::move(planner)) {}
+
+    /** @brief get the plan to execute */
+    inline const Node* getPlan() const {
+        return plan != nullptr ? plan.get() : child.get();
+    }
+
+    inline JoinPlanner& getPlanner() const {
+        return *planner;
+    }
+
+    /** @brief replace the plan; the RAM query must outlive its node */
+    inline void setPlan(Own<Node> node, Own<ram::Query> query) const {
+        plan = std::move(node);
+        ramPlan = std::move(query);
+    }
+
+private:
+    Own<JoinPlanner> planner;
+    mutable Own<ram::Query> ramPlan;
+    mutable Own<Node> plan;
+};
+
+/**
+ * @class TieredQuery
+ * @brief Query of a loop whose bytecode is translated to native code once it is hot
+ *
+ * The child is the query as generated from the program. Once the query has
+ * been executed as often as the threshold, the bytecode programs of its
+ * expressions and conditions are translated to native code.
+ */
+class TieredQuery : public UnaryNode {
+public:
+    TieredQuery(enum NodeType ty, const ram::Node* sdw, Own<Node> child,
+            std::vector<const Bytecode*> programs, std::size_t threshold)
+            : UnaryNode(ty, sdw, std::move(child)), programs(std::move(programs)), threshold(threshold) {}
+
+    /** @brief count an execution, return true if the query has just become hot */
+    inline bool countExecution() const {
+        return ++executions == threshold;
+    }
+
+    /** @brief translate the bytecode programs of the query to native code */
+    inline void compileNative() const {
+        for (const Bytecode* program : programs) {
+            program->compileNative();
+        }
+    }
+
+private:
+    std::vector<const Bytecode*> programs;
+    const std::size_t threshold;
+    mutable std::size_t executions = 0;
+};
+
 /**
  * @class MergeExtend
  */
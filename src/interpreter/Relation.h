@@ -21,13 +21,18 @@
 #include "souffle/RamTypes.h"
 #include "souffle/SouffleInterface.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <deque>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -107,12 +112,55 @@ public:
 
     virtual void insert(const RamDomain*) = 0;
 
+    /**
+     * Inserts a batch of tuples, stored consecutively.
+     */
+    virtual void insertBatch(const RamDomain* data, std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i) {
+            insert(data + i * arity);
+        }
+    }
+
     virtual bool contains(const RamDomain*) const = 0;
 
     virtual std::size_t size() const = 0;
 
     virtual void purge() = 0;
 
+    /**
+     * Enables or disables the lazy maintenance of the indexes other than the
+     * main index. In lazy mode, an insertion only updates the main index, and
+     * the other indexes are updated in bulk by updateIndexes(), which must be
+     * called before they are read next.
+     *
+     * Lazy maintenance must not be enabled for a relation that is read while
+     * it is modified.
+     */
+    virtual void setLazyIndexes(bool /* enable */) {}
+
+    /**
+     * Updates the indexes other than the main index by the pending insertions.
+     * The engine calls it before each query reading the relation, hence it is
+     * never executed within the parallel tasks of a query.
+     */
+    virtual void updateIndexes() const {}
+
+    /**
+     * Sets the number of bytes of tuples the relation keeps in memory, if it
+     * spills the others to disk.
+     */
+    virtual void setMemoryBudget(std::size_t /* bytes */) {}
+
+    /**
+     * Sets the number of tuples each thread buffers before its insertions are
+     * merged into the relation, or zero to insert directly. Disabling the
+     * buffering merges the tuples buffered so far in bulk, and must not be done
+     * within the parallel tasks of a query.
+     *
+     * Buffering must not be enabled for a relation that is read while it is modified.
+     */
+    virtual void setInsertBuffer(std::size_t /* capacity */) {}
+
     const std::string& getName() const {
         return relName;
     }
@@ -213,15 +261,107 @@ public:
         __purge();
     }
 
+    void setLazyIndexes(bool enable) override {
+        updateIndexes();
+        lazyIndexes = enable && indexes.size() > 1;
+        if (lazyIndexes && !pending) {
+            pending = std::make_unique<std::vector<Tuple>[]>(getLanes().lanes());
+        }
+        if constexpr (std::is_same_v<Structure<Arity>, Compressed<Arity>> ||
+                      std::is_same_v<Structure<Arity>, Disk<Arity>>) {
+            // compactions move tuples, which readers of the same query must not observe
+            for (auto& index : indexes) {
+                index->setCompaction(enable);
+            }
+        }
+        if constexpr (std::is_same_v<Structure<Arity>, Disk<Arity>>) {
+            // the pending insertions of lazy indexes would be held in memory
+            lazyIndexes = false;
+        }
+    }
+
+    void setMemoryBudget(std::size_t bytes) override {
+        if constexpr (std::is_same_v<Structure<Arity>, Disk<Arity>>) {
+            for (auto& index : indexes) {
+                index->setMemoryBudget(bytes / indexes.size());
+            }
+        }
+    }
+
+    void setInsertBuffer(std::size_t capacity) override {
+        // only plain B-trees are merged in bulk, provenance and deletions rely on single insertions
+        if constexpr (Arity > 0 && std::is_same_v<Structure<Arity>, Btree<Arity>>) {
+            bufferCapacity = capacity;
+            if (capacity > 0 && !buffers) {
+                buffers = std::make_unique<std::vector<Tuple>[]>(getLanes().lanes());
+            }
+            if (capacity == 0 && buffers) {
+                std::vector<Tuple> tuples;
+                for (std::size_t lane = 0; lane < lanes->lanes(); ++lane) {
+                    tuples.insert(tuples.end(), buffers[lane].begin(), buffers[lane].end());
+                    std::vector<Tuple>().swap(buffers[lane]);
+                }
+                if (tuples.empty()) {
+                    return;
+                }
+
+                // one task per index, each sorting and deduplicating the tuples in its own order
+                const std::size_t count = indexes.size();
+                PARALLEL_START
+                    pfor(std::size_t i = 0; i < count; ++i) {
+                        indexes[i]->insertBatch(tuples);
+                    }
+                PARALLEL_END
+            }
+        }
+    }
+
+    void updateIndexes() const override {
+        if (!hasPending.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> guard(updateLock);
+        if (!hasPending.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        std::vector<Tuple> tuples;
+        for (std::size_t lane = 0; lane < lanes->lanes(); ++lane) {
+            tuples.insert(tuples.end(), pending[lane].begin(), pending[lane].end());
+            std::vector<Tuple>().swap(pending[lane]);
+        }
+
+        // one task per index
+        const std::size_t count = indexes.size();
+        PARALLEL_START
+            pfor(std::size_t i = 1; i < count; ++i) {
+                indexes[i]->insertBatch(tuples);
+            }
+        PARALLEL_END
+        hasPending.store(false, std::memory_order_release);
+    }
+
     void insert(const RamDomain* data) override {
         insert(constructTuple(data));
     }
 
+    void insertBatch(const RamDomain* data, std::size_t count) override {
+        std::vector<Tuple> tuples;
+        tuples.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            tuples.push_back(constructTuple(data + i * Arity));
+        }
+        for (auto& index : indexes) {
+            index->insertBatch(tuples);
+        }
+    }
+
     bool contains(const RamDomain* data) const override {
         return contains(constructTuple(data));
     }
 
     IndexViewPtr createView(const std::size_t& indexPos) const override {
+        assert((indexPos == 0 || !hasPending.load(std::memory_order_relaxed)) && "index not updated");
         return mk<View>(indexes[indexPos]->createView());
     }
 
@@ -284,12 +424,33 @@ public:
     // -----
 public:
     /**
-     * Add the given tuple to this relation.
+     * Add the given tuple to this relation, and return whether it is new. While
+     * insertions are buffered, the tuple is only added to the buffer of the
+     * thread, which is merged into the indexes later, and it is reported as new.
      */
     bool insert(const Tuple& tuple) {
+        if constexpr (Arity > 0 && std::is_same_v<Structure<Arity>, Btree<Arity>>) {
+            if (bufferCapacity > 0) {
+                auto guard = lanes->guard();
+                auto& buffer = buffers[lanes->threadLane()];
+                buffer.push_back(tuple);
+                if (buffer.size() >= bufferCapacity) {
+                    mergeBuffer(buffer);
+                }
+                return true;
+            }
+        }
         if (!(main->insert(tuple))) {
             return false;
         }
+        if (lazyIndexes) {
+            auto guard = lanes->guard();
+            pending[lanes->threadLane()].push_back(tuple);
+            if (!hasPending.load(std::memory_order_relaxed)) {
+                hasPending.store(true, std::memory_order_relaxed);
+            }
+            return true;
+        }
         for (std::size_t i = 1; i < indexes.size(); ++i) {
             indexes[i]->insert(tuple);
         }
@@ -316,6 +477,7 @@ public:
      * Tests whether this relation contains any element between the given boundaries.
      */
     bool contains(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        assert(indexPos == 0 || !hasPending.load(std::memory_order_relaxed));
         return indexes[indexPos]->contains(low, high);
     }
 
@@ -339,6 +501,7 @@ public:
      * Obtains a pair of iterators covering the interval between the two given entries.
      */
     souffle::range<iterator> range(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        assert(indexPos == 0 || !hasPending.load(std::memory_order_relaxed));
         return indexes[indexPos]->range(low, high);
     }
 
@@ -347,6 +510,7 @@ public:
      */
     std::vector<souffle::range<iterator>> partitionRange(const std::size_t& indexPos, const Tuple& low,
             const Tuple& high, std::size_t partitionCount) const {
+        assert(indexPos == 0 || !hasPending.load(std::memory_order_relaxed));
         return indexes[indexPos]->partitionRange(low, high, partitionCount);
     }
 
@@ -355,6 +519,8 @@ public:
      * installed indexes.
      */
     void swap(Relation<Arity, Structure>& other) {
+        updateIndexes();
+        other.updateIndexes();
         indexes.swap(other.indexes);
     }
 
@@ -379,6 +545,15 @@ public:
         for (auto& idx : indexes) {
             idx->clear();
         }
+        for (std::size_t lane = 0; lanes && lane < lanes->lanes(); ++lane) {
+            if (pending) {
+                std::vector<Tuple>().swap(pending[lane]);
+            }
+            if (buffers) {
+                std::vector<Tuple>().swap(buffers[lane]);
+            }
+        }
+        hasPending.store(false, std::memory_order_relaxed);
     }
 
     /**
@@ -389,10 +564,40 @@ public:
     }
 
     Index* getIndex(std::size_t idx) const {
+        if (idx != 0) {
+            updateIndexes();
+        }
         return indexes.at(idx).get();
     }
 
 protected:
+    /**
+     * Returns the lanes of the per-thread pending and buffered insertions,
+     * which are only allocated for relations maintaining lazy indexes or
+     * buffering insertions.
+     */
+    ConcurrentLanes& getLanes() {
+        if (!lanes) {
+            lanes = mk<ConcurrentLanes>(static_cast<std::size_t>(MAX_THREADS));
+        }
+        return *lanes;
+    }
+
+    /**
+     * Merges the full buffer of a thread into all indexes and empties it. The
+     * buffer is deduplicated first, and each index takes the tuples in its own
+     * order through its concurrent insertion, so threads merge their buffers
+     * at the same time as others keep inserting.
+     */
+    void mergeBuffer(std::vector<Tuple>& tuples) {
+        std::sort(tuples.begin(), tuples.end());
+        tuples.erase(std::unique(tuples.begin(), tuples.end()), tuples.end());
+        for (auto& index : indexes) {
+            index->mergeBatch(tuples);
+        }
+        tuples.clear();
+    }
+
     // Number of height parameters of relation
     std::size_t auxiliaryArity;
 
@@ -401,6 +606,223 @@ protected:
 
     // a pointer to the main index within the managed index
     Index* main;
+
+    // whether the indexes other than the main index are maintained lazily
+    bool lazyIndexes = false;
+
+    // the lanes of the pending and buffered insertions, allocated on first use
+    Own<ConcurrentLanes> lanes;
+
+    // the tuples inserted into the main index only, buffered per lane
+    mutable std::unique_ptr<std::vector<Tuple>[]> pending;
+    mutable std::atomic<bool> hasPending{false};
+
+    // the number of tuples a lane buffers before merging them, zero if insertions are not buffered
+    std::size_t bufferCapacity = 0;
+
+    // the tuples inserted but not yet merged into the indexes, per lane
+    std::unique_ptr<std::vector<Tuple>[]> buffers;
+
+    // a lock serializing the updates of the indexes
+    mutable std::mutex updateLock;
+};
+
+/**
+ * A relation of an arity only known at runtime, composed of generic indexes.
+ * It serves the relations that are too wide for the relations specialized by
+ * their arity.
+ */
+template <>
+class Relation<Dynamic, Generic> : public RelationWrapper {
+public:
+    static constexpr std::size_t Arity = Dynamic;
+    using Index = interpreter::Index<Dynamic, Generic>;
+    using Tuple = Index::Tuple;
+    using View = Index::View;
+    using iterator = Index::iterator;
+
+    /**
+     * Cast an abstract view into a view of Index::View type.
+     */
+    static View* castView(ViewWrapper* view) {
+        return static_cast<View*>(view);
+    }
+
+    /**
+     * Creates a relation of the given arity, build all necessary indexes.
+     */
+    Relation(arity_type arity, std::size_t auxiliaryArity, const std::string& name,
+            const ram::analysis::IndexCluster& indexSelection)
+            : RelationWrapper(arity, auxiliaryArity, name) {
+        for (const auto& order : indexSelection.getAllOrders()) {
+            ram::analysis::LexOrder fullOrder = order;
+            // Expand the order to a total order
+            ram::analysis::AttributeSet set{order.begin(), order.end()};
+            for (std::size_t i = 0; i < arity; ++i) {
+                if (set.find(i) == set.end()) {
+                    fullOrder.push_back(i);
+                }
+            }
+
+            indexes.push_back(mk<Index>(fullOrder));
+        }
+
+        // Use the first index as default main index
+        main = indexes[0].get();
+    }
+
+    Relation(Relation& other) = delete;
+
+    // -- Implement all virtual interface from Wrapper. --
+public:
+    void purge() override {
+        __purge();
+    }
+
+    void insert(const RamDomain* data) override {
+        if (!main->insert(data)) {
+            return;
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->insert(data);
+        }
+    }
+
+    void insertBatch(const RamDomain* data, std::size_t count) override {
+        for (auto& index : indexes) {
+            index->insertBatch(data, count);
+        }
+    }
+
+    bool contains(const RamDomain* data) const override {
+        const Order order = main->getOrder();
+        Tuple tuple(arity);
+        for (std::size_t i = 0; i < arity; ++i) {
+            tuple[i] = data[order[i]];
+        }
+        return main->contains(tuple);
+    }
+
+    IndexViewPtr createView(const std::size_t& indexPos) const override {
+        return mk<View>(indexes[indexPos]->createView());
+    }
+
+    std::size_t size() const override {
+        return __size();
+    }
+
+    Order getIndexOrder(std::size_t idx) const override {
+        return indexes[idx]->getOrder();
+    }
+
+    class iterator_base : public RelationWrapper::iterator_base {
+        iterator iter;
+        Order order;
+        std::vector<RamDomain> data;
+
+    public:
+        iterator_base(iterator iter, Order order)
+                : iter(std::move(iter)), order(std::move(order)), data(this->order.size()) {}
+
+        iterator_base& operator++() override {
+            ++iter;
+            return *this;
+        }
+
+        const RamDomain* operator*() override {
+            const auto tuple = *iter;
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                data[order[i]] = tuple[i];
+            }
+            return data.data();
+        }
+
+        iterator_base* clone() const override {
+            return new iterator_base(iter, order);
+        }
+
+        bool equal(const RelationWrapper::iterator_base& other) const override {
+            if (auto* o = as<iterator_base>(other)) {
+                return iter == o->iter;
+            }
+            return false;
+        }
+    };
+
+    Iterator begin() const override {
+        return Iterator(new iterator_base(main->begin(), main->getOrder()));
+    }
+
+    Iterator end() const override {
+        return Iterator(new iterator_base(main->end(), main->getOrder()));
+    }
+
+    // -----
+    // Following section defines the interfaces for interpreter execution, matching
+    // those of the relations specialized by their arity.
+    // -----
+public:
+    /**
+     * Add the given tuple, given in the natural order of its attributes, to this relation.
+     */
+    bool insert(const Tuple& tuple) {
+        if (!main->insert(tuple)) {
+            return false;
+        }
+        for (std::size_t i = 1; i < indexes.size(); ++i) {
+            indexes[i]->insert(tuple);
+        }
+        return true;
+    }
+
+    /**
+     * Tests whether this relation contains any element between the given boundaries.
+     */
+    bool contains(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        return indexes[indexPos]->contains(low, high);
+    }
+
+    souffle::range<iterator> scan() const {
+        return main->scan();
+    }
+
+    std::vector<souffle::range<iterator>> partitionScan(std::size_t partitionCount) const {
+        return main->partitionScan(partitionCount);
+    }
+
+    souffle::range<iterator> range(const std::size_t& indexPos, const Tuple& low, const Tuple& high) const {
+        return indexes[indexPos]->range(low, high);
+    }
+
+    std::vector<souffle::range<iterator>> partitionRange(const std::size_t& indexPos, const Tuple& low,
+            const Tuple& high, std::size_t partitionCount) const {
+        return indexes[indexPos]->partitionRange(low, high, partitionCount);
+    }
+
+    std::size_t __size() const {
+        return main->size();
+    }
+
+    bool empty() const {
+        return main->empty();
+    }
+
+    void __purge() {
+        for (auto& idx : indexes) {
+            idx->clear();
+        }
+    }
+
+    Index* getIndex(std::size_t idx) const {
+        return indexes.at(idx).get();
+    }
+
+protected:
+    // a map of managed indexes
+    VecOwn<Index> indexes;
+
+    // a pointer to the main index within the managed index
+    Index* main;
 };
 
 template <std::size_t _Arity>
@@ -459,7 +881,19 @@ Own<RelationWrapper> createProvenanceRelation(
 Own<RelationWrapper> createBrieRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 
+// A factory for relations of compressed B-tree leaves.
+Own<RelationWrapper> createCompressedRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for relations spilling to disk.
+Own<RelationWrapper> createDiskRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
 // A factory for Eqrel index.
 Own<RelationWrapper> createEqrelRelation(
         const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
+
+// A factory for generic relations of any arity.
+Own<RelationWrapper> createGenericRelation(
+        const ram::Relation& id, const ram::analysis::IndexCluster& indexSelection);
 }  // namespace souffle::interpreter
@@ -20,9 +20,14 @@
 #include "souffle/datastructure/BTree.h"
 #include "souffle/datastructure/BTreeDelete.h"
 #include "souffle/datastructure/Brie.h"
+#include "souffle/datastructure/CompressedSet.h"
+#include "souffle/datastructure/DiskSet.h"
 #include "souffle/datastructure/EquivalenceRelation.h"
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
 
 namespace souffle::interpreter {
 // clang-format off
@@ -104,42 +109,97 @@ namespace souffle::interpreter {
     func(BtreeDelete, 19, __VA_ARGS__) \
     func(BtreeDelete, 20, __VA_ARGS__)
 
-// Brie is disabled for now.
-#define FOR_EACH_BRIE(func, ...)
-    /* func(Brie, 0, __VA_ARGS__) \ */
-    /* func(Brie, 1, __VA_ARGS__) \ */
-    /* func(Brie, 2, __VA_ARGS__) \ */
-    /* func(Brie, 3, __VA_ARGS__) \ */
-    /* func(Brie, 4, __VA_ARGS__) \ */
-    /* func(Brie, 5, __VA_ARGS__) \ */
-    /* func(Brie, 6, __VA_ARGS__) \ */
-    /* func(Brie, 7, __VA_ARGS__) \ */
-    /* func(Brie, 8, __VA_ARGS__) \ */
-    /* func(Brie, 9, __VA_ARGS__) \ */
-    /* func(Brie, 10, __VA_ARGS__) \ */
-    /* func(Brie, 11, __VA_ARGS__) \ */
-    /* func(Brie, 12, __VA_ARGS__) \ */
-    /* func(Brie, 13, __VA_ARGS__) \ */
-    /* func(Brie, 14, __VA_ARGS__) \ */
-    /* func(Brie, 15, __VA_ARGS__) \ */
-    /* func(Brie, 16, __VA_ARGS__) \ */
-    /* func(Brie, 17, __VA_ARGS__) \ */
-    /* func(Brie, 18, __VA_ARGS__) \ */
-    /* func(Brie, 19, __VA_ARGS__) \ */
-    /* func(Brie, 20, __VA_ARGS__)   */
+#define FOR_EACH_BRIE(func, ...)\
+    func(Brie, 1, __VA_ARGS__) \
+    func(Brie, 2, __VA_ARGS__) \
+    func(Brie, 3, __VA_ARGS__) \
+    func(Brie, 4, __VA_ARGS__) \
+    func(Brie, 5, __VA_ARGS__) \
+    func(Brie, 6, __VA_ARGS__) \
+    func(Brie, 7, __VA_ARGS__) \
+    func(Brie, 8, __VA_ARGS__) \
+    func(Brie, 9, __VA_ARGS__) \
+    func(Brie, 10, __VA_ARGS__) \
+    func(Brie, 11, __VA_ARGS__) \
+    func(Brie, 12, __VA_ARGS__) \
+    func(Brie, 13, __VA_ARGS__) \
+    func(Brie, 14, __VA_ARGS__) \
+    func(Brie, 15, __VA_ARGS__) \
+    func(Brie, 16, __VA_ARGS__) \
+    func(Brie, 17, __VA_ARGS__) \
+    func(Brie, 18, __VA_ARGS__) \
+    func(Brie, 19, __VA_ARGS__) \
+    func(Brie, 20, __VA_ARGS__)
+
+#define FOR_EACH_COMPRESSED(func, ...)\
+    func(Compressed, 1, __VA_ARGS__) \
+    func(Compressed, 2, __VA_ARGS__) \
+    func(Compressed, 3, __VA_ARGS__) \
+    func(Compressed, 4, __VA_ARGS__) \
+    func(Compressed, 5, __VA_ARGS__) \
+    func(Compressed, 6, __VA_ARGS__) \
+    func(Compressed, 7, __VA_ARGS__) \
+    func(Compressed, 8, __VA_ARGS__) \
+    func(Compressed, 9, __VA_ARGS__) \
+    func(Compressed, 10, __VA_ARGS__) \
+    func(Compressed, 11, __VA_ARGS__) \
+    func(Compressed, 12, __VA_ARGS__) \
+    func(Compressed, 13, __VA_ARGS__) \
+    func(Compressed, 14, __VA_ARGS__) \
+    func(Compressed, 15, __VA_ARGS__) \
+    func(Compressed, 16, __VA_ARGS__) \
+    func(Compressed, 17, __VA_ARGS__) \
+    func(Compressed, 18, __VA_ARGS__) \
+    func(Compressed, 19, __VA_ARGS__) \
+    func(Compressed, 20, __VA_ARGS__)
+
+#define FOR_EACH_DISK(func, ...)\
+    func(Disk, 1, __VA_ARGS__) \
+    func(Disk, 2, __VA_ARGS__) \
+    func(Disk, 3, __VA_ARGS__) \
+    func(Disk, 4, __VA_ARGS__) \
+    func(Disk, 5, __VA_ARGS__) \
+    func(Disk, 6, __VA_ARGS__) \
+    func(Disk, 7, __VA_ARGS__) \
+    func(Disk, 8, __VA_ARGS__) \
+    func(Disk, 9, __VA_ARGS__) \
+    func(Disk, 10, __VA_ARGS__) \
+    func(Disk, 11, __VA_ARGS__) \
+    func(Disk, 12, __VA_ARGS__) \
+    func(Disk, 13, __VA_ARGS__) \
+    func(Disk, 14, __VA_ARGS__) \
+    func(Disk, 15, __VA_ARGS__) \
+    func(Disk, 16, __VA_ARGS__) \
+    func(Disk, 17, __VA_ARGS__) \
+    func(Disk, 18, __VA_ARGS__) \
+    func(Disk, 19, __VA_ARGS__) \
+    func(Disk, 20, __VA_ARGS__)
 
 #define FOR_EACH_EQREL(func, ...)\
     func(Eqrel, 2, __VA_ARGS__)
 
+#define FOR_EACH_GENERIC(func, ...)\
+    func(Generic, Dynamic, __VA_ARGS__)
+
 #define FOR_EACH(func, ...)                 \
     FOR_EACH_BTREE(func, __VA_ARGS__)       \
     FOR_EACH_BTREE_DELETE(func, __VA_ARGS__)       \
     FOR_EACH_BRIE(func, __VA_ARGS__)        \
+    FOR_EACH_COMPRESSED(func, __VA_ARGS__)  \
+    FOR_EACH_DISK(func, __VA_ARGS__)        \
     FOR_EACH_PROVENANCE(func, __VA_ARGS__)  \
-    FOR_EACH_EQREL(func, __VA_ARGS__)
+    FOR_EACH_EQREL(func, __VA_ARGS__)       \
+    FOR_EACH_GENERIC(func, __VA_ARGS__)
 
 // clang-format on
 
+// The largest arity of B-tree and Brie relations that are specialized by their arity.
+// Wider relations are stored by generic relations, serving any arity.
+constexpr std::size_t MaxSpecializedArity = 20;
+
+// The placeholder for the arity of generic relations, which is only known at runtime.
+constexpr std::size_t Dynamic = std::numeric_limits<std::size_t>::max();
+
 /**
  * A namespace enclosing utilities required by indices.
  */
@@ -184,6 +244,19 @@ struct comparator<> {
 
 }  // namespace index_utils
 
+}  // namespace souffle::interpreter
+
+namespace souffle::detail {
+
+// interpreter indexes order their tuples by the first column of their comparator
+template <unsigned First, unsigned... Rest>
+struct leading_column<interpreter::index_utils::comparator<First, Rest...>>
+        : std::integral_constant<int, First> {};
+
+}  // namespace souffle::detail
+
+namespace souffle::interpreter {
+
 /**
  * The index class is utilized as a template-meta-programming structure
  * to specify and realize indices.
@@ -256,6 +329,14 @@ using BtreeDelete = btree_delete_set<t_tuple<Arity>, comparator<Arity>>;
 template <std::size_t Arity>
 using Brie = Trie<Arity>;
 
+// Alias for CompressedSet
+template <std::size_t Arity>
+using Compressed = CompressedSet<t_tuple<Arity>>;
+
+// Alias for DiskSet
+template <std::size_t Arity>
+using Disk = DiskSet<t_tuple<Arity>>;
+
 // Updater for Provenance
 template <std::size_t Arity>
 struct ProvenanceUpdater {
@@ -276,4 +357,29 @@ using Provenance = btree_set<t_tuple<Arity>, prov_comparator<Arity>, std::alloca
 template <std::size_t Arity>
 using Eqrel = EquivalenceRelation<t_tuple<Arity>>;
 
+// The comparator for rows of a runtime arity, referenced by pointers to their first element.
+struct RowComparator {
+    std::size_t arity = 0;
+
+    int operator()(const RamDomain* a, const RamDomain* b) const {
+        for (std::size_t i = 0; i < arity; ++i) {
+            if (a[i] != b[i]) {
+                return (a[i] < b[i]) ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+    bool less(const RamDomain* a, const RamDomain* b) const {
+        return (*this)(a, b) < 0;
+    }
+    bool equal(const RamDomain* a, const RamDomain* b) const {
+        return std::equal(a, a + arity, b);
+    }
+};
+
+// Alias for generic relations
+// Note: the arity is a placeholder, rows are compared by the runtime arity of the comparator.
+template <std::size_t Arity>
+using Generic = btree_set<const RamDomain*, RowComparator>;
+
 };  // namespace souffle::interpreter
@@ -81,9 +81,32 @@ public:
         viewInfoForNested.push_back({relId, indexPos, viewPos});
     }
 
+    /** @brief Add a relation read by the query. */
+    void addReadRelation(std::size_t relId) {
+        readRelations.push_back(relId);
+    }
+
+    /** @brief Return the relations read by the query */
+    const std::vector<std::size_t>& getReadRelations() const {
+        return readRelations;
+    }
+
+    /** @brief Add a relation whose insertions are buffered per thread during the query. */
+    void addBufferedInsert(std::size_t relId) {
+        bufferedInserts.push_back(relId);
+    }
+
+    /** @brief Return the relations whose insertions are buffered */
+    const std::vector<std::size_t>& getBufferedInserts() const {
+        return bufferedInserts;
+    }
+
     /** If this context has information for parallel operation.  */
     bool isParallel = false;
 
+    /** Number of tuples a thread buffers before merging them into a relation */
+    std::size_t insertBufferSize = 0;
+
 private:
     /** Vector of filter operation, views required */
     VecOwn<Node> outerFilterViewOps;
@@ -95,6 +118,10 @@ private:
     std::vector<std::array<std::size_t, 3>> viewInfoForFilter;
     /** Vector of View information in nested operations */
     std::vector<std::array<std::size_t, 3>> viewInfoForNested;
+    /** Relations read by the query */
+    std::vector<std::size_t> readRelations;
+    /** Relations whose insertions are buffered */
+    std::vector<std::size_t> bufferedInserts;
 };
 
 }  // namespace souffle::interpreter
@@ -0,0 +1,177 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file bytecode_test.cpp
+ *
+ * Tests the compilation of expressions and conditions to bytecode.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "FunctorOps.h"
+#include "interpreter/Bytecode.h"
+#include "interpreter/Context.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/FloatConstant.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/Negation.h"
+#include "ram/SignedConstant.h"
+#include "ram/StringConstant.h"
+#include "ram/TupleElement.h"
+#include "ram/Variable.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace souffle::interpreter::test {
+
+using Opcode = BytecodeProgram::Opcode;
+
+/** Environment keeping the order of tuples, and giving each variable its own slot */
+static BytecodeProgram::Environment getEnvironment() {
+    BytecodeProgram::Environment env;
+    env.mapElement = [](std::size_t, std::size_t element) { return element; };
+    env.encodeVariable = [](const std::string& name) { return name == "x" ? 0 : 1; };
+    env.encodeSymbol = [](const std::string& symbol) { return static_cast<RamDomain>(symbol.size()); };
+    return env;
+}
+
+static Own<ram::IntrinsicOperator> mkBinary(
+        FunctorOp op, Own<ram::Expression> lhs, Own<ram::Expression> rhs) {
+    VecOwn<ram::Expression> args;
+    args.push_back(std::move(lhs));
+    args.push_back(std::move(rhs));
+    return mk<ram::IntrinsicOperator>(op, std::move(args));
+}
+
+TEST(Bytecode, FusedEquality) {
+    ram::Constraint constraint(
+            BinaryConstraintOp::EQ, mk<ram::TupleElement>(0, 1), mk<ram::SignedConstant>(5));
+    auto program = BytecodeProgram::compile(constraint, getEnvironment());
+    EXPECT_TRUE(program != nullptr);
+    EXPECT_EQ(2, program->getInstructions().size());
+    EXPECT_TRUE(program->getInstructions()[0].op == Opcode::EqElementConstant);
+
+    RamDomain tuple[2] = {5, 5};
+    Context ctxt;
+    ctxt[0] = tuple;
+    EXPECT_EQ(1, program->execute(ctxt));
+    tuple[1] = 4;
+    EXPECT_EQ(0, program->execute(ctxt));
+
+    ram::Constraint join(BinaryConstraintOp::NE, mk<ram::TupleElement>(0, 0), mk<ram::TupleElement>(1, 0));
+    program = BytecodeProgram::compile(join, getEnvironment());
+    EXPECT_TRUE(program->getInstructions()[0].op == Opcode::NeElementElement);
+    RamDomain other[1] = {5};
+    ctxt[1] = other;
+    EXPECT_EQ(0, program->execute(ctxt));
+}
+
+TEST(Bytecode, Arithmetic) {
+    // x + t0.0 * 2 > 10
+    ram::Constraint constraint(BinaryConstraintOp::GT,
+            mkBinary(FunctorOp::ADD, mk<ram::Variable>("x"),
+                    mkBinary(FunctorOp::MUL, mk<ram::TupleElement>(0, 0), mk<ram::SignedConstant>(2))),
+            mk<ram::SignedConstant>(10));
+    auto program = BytecodeProgram::compile(constraint, getEnvironment());
+    EXPECT_TRUE(program != nullptr);
+
+    RamDomain tuple[1] = {3};
+    Context ctxt;
+    ctxt[0] = tuple;
+    ctxt.setVariable(0, 4);
+    EXPECT_EQ(0, program->execute(ctxt));
+    ctxt.setVariable(0, 5);
+    EXPECT_EQ(1, program->execute(ctxt));
+
+    // max(t0.0, -7, x)
+    VecOwn<ram::Expression> args;
+    args.push_back(mk<ram::TupleElement>(0, 0));
+    args.push_back(mk<ram::SignedConstant>(-7));
+    args.push_back(mk<ram::Variable>("x"));
+    ram::IntrinsicOperator max(FunctorOp::MAX, std::move(args));
+    program = BytecodeProgram::compile(max, getEnvironment());
+    EXPECT_EQ(5, program->execute(ctxt));
+    tuple[0] = -3;
+    ctxt.setVariable(0, -8);
+    EXPECT_EQ(-3, program->execute(ctxt));
+
+    // float division
+    auto div = mkBinary(FunctorOp::FDIV, mk<ram::FloatConstant>(1.0), mk<ram::FloatConstant>(4.0));
+    program = BytecodeProgram::compile(*div, getEnvironment());
+    EXPECT_EQ(0.25, ramBitCast<RamFloat>(program->execute(ctxt)));
+}
+
+TEST(Bytecode, Conditions) {
+    // !(t0.0 = t0.1) /\ t0.0 < t0.1
+    ram::Conjunction conj(mk<ram::Negation>(mk<ram::Constraint>(BinaryConstraintOp::EQ,
+                                  mk<ram::TupleElement>(0, 0), mk<ram::TupleElement>(0, 1))),
+            mk<ram::Constraint>(BinaryConstraintOp::LT, mk<ram::TupleElement>(0, 0),
+                    mk<ram::TupleElement>(0, 1)));
+    auto program = BytecodeProgram::compile(conj, getEnvironment());
+    EXPECT_TRUE(program != nullptr);
+
+    RamDomain tuple[2] = {1, 2};
+    Context ctxt;
+    ctxt[0] = tuple;
+    EXPECT_EQ(1, program->execute(ctxt));
+    tuple[0] = 2;
+    EXPECT_EQ(0, program->execute(ctxt));
+    tuple[0] = 3;
+    EXPECT_EQ(0, program->execute(ctxt));
+}
+
+TEST(Bytecode, ShortCircuit) {
+    // (t0.0 land 10 / t0.0) lor t0.1
+    auto conj = mkBinary(FunctorOp::LAND, mk<ram::TupleElement>(0, 0),
+            mkBinary(FunctorOp::DIV, mk<ram::SignedConstant>(10), mk<ram::TupleElement>(0, 0)));
+    auto disj = mkBinary(FunctorOp::LOR, std::move(conj), mk<ram::TupleElement>(0, 1));
+    auto program = BytecodeProgram::compile(*disj, getEnvironment());
+    EXPECT_TRUE(program != nullptr);
+
+    // the division by zero is skipped
+    RamDomain tuple[2] = {0, 0};
+    Context ctxt;
+    ctxt[0] = tuple;
+    EXPECT_EQ(0, program->execute(ctxt));
+    tuple[1] = 7;
+    EXPECT_EQ(1, program->execute(ctxt));
+    tuple[0] = 5;
+    tuple[1] = 0;
+    EXPECT_EQ(1, program->execute(ctxt));
+    tuple[0] = 20;
+    EXPECT_EQ(0, program->execute(ctxt));
+}
+
+TEST(Bytecode, Unsupported) {
+    // symbols are compared by their text, which requires the symbol table
+    ram::Constraint constraint(
+            BinaryConstraintOp::SLT, mk<ram::StringConstant>("a"), mk<ram::StringConstant>("b"));
+    EXPECT_TRUE(BytecodeProgram::compile(constraint, getEnvironment()) == nullptr);
+
+    auto cat = mkBinary(FunctorOp::CAT, mk<ram::StringConstant>("a"), mk<ram::StringConstant>("b"));
+    EXPECT_TRUE(BytecodeProgram::compile(*cat, getEnvironment()) == nullptr);
+
+    // the nodes enclosing the unsupported operation are reported, its siblings are not
+    const ram::IntrinsicOperator* inner = cat.get();
+    auto len = mk<ram::IntrinsicOperator>(FunctorOp::STRLEN, VecOwn<ram::Expression>{});
+    auto sum = mkBinary(FunctorOp::ADD, mk<ram::SignedConstant>(1), std::move(cat));
+    std::vector<const ram::Node*> unsupported;
+    EXPECT_TRUE(BytecodeProgram::compile(*sum, getEnvironment(), &unsupported) == nullptr);
+    EXPECT_EQ(2, unsupported.size());
+    EXPECT_EQ(inner, unsupported[0]);
+    EXPECT_EQ(sum.get(), unsupported[1]);
+}
+
+}  // namespace souffle::interpreter::test
@@ -287,4 +287,203 @@ TEST(Reordering, Iteration) {
     }
 }
 
+TEST(Generic, Range) {
+    // create a relation wider than the relations specialized by arity
+    const std::size_t arity = 25;
+    SymbolTableImpl symbolTable;
+
+    // create an index on the last attribute next to the main index
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(arity);
+    SearchSignature lastAttribute(arity);
+    lastAttribute[arity - 1] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, lastAttribute};
+    LexOrder fullOrder;
+    for (std::size_t i = 0; i < arity; ++i) {
+        fullOrder.push_back(i);
+    }
+    LexOrder lastOrder = {arity - 1};
+    OrderCollection orders = {fullOrder, lastOrder};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({lastAttribute, lastOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<Dynamic, interpreter::Generic> rel(arity, 0, "test", indexSelection);
+    for (RamDomain i = 0; i < 100; ++i) {
+        std::vector<RamDomain> tuple(arity, i);
+        tuple[arity - 1] = i % 10;
+        EXPECT_TRUE(rel.insert(tuple));
+        EXPECT_FALSE(rel.insert(tuple));
+    }
+    EXPECT_EQ(100, rel.size());
+
+    // the second index stores tuples with the last attribute first
+    std::vector<RamDomain> low(arity, MIN_RAM_SIGNED);
+    std::vector<RamDomain> high(arity, MAX_RAM_SIGNED);
+    low[0] = high[0] = 3;
+    std::size_t count = 0;
+    for (const auto& tuple : rel.range(1, low, high)) {
+        EXPECT_EQ(3, tuple[0]);
+        EXPECT_EQ(tuple[1] % 10, 3);
+        ++count;
+    }
+    EXPECT_EQ(10, count);
+
+    count = 0;
+    for (const auto& chunk : rel.partitionScan(8)) {
+        for (const auto& tuple : chunk) {
+            (void)tuple;
+            ++count;
+        }
+    }
+    EXPECT_EQ(100, count);
+
+    // ProgInterface should give decoded tuples.
+    std::vector<std::string> attributes(arity, "i");
+    RelInterface relInt(rel, symbolTable, "test", attributes, attributes, 0);
+    count = 0;
+    for (auto it = relInt.begin(); it != relInt.end(); ++it) {
+        EXPECT_EQ((*it)[0] % 10, (*it)[arity - 1]);
+        ++count;
+    }
+    EXPECT_EQ(100, count);
+
+    // a batch of tuples present in the relation and repeated in the batch
+    std::vector<RamDomain> batch;
+    for (RamDomain i = 90; i < 110; ++i) {
+        for (int copy = 0; copy < 2; ++copy) {
+            std::vector<RamDomain> tuple(arity, i);
+            tuple[arity - 1] = i % 10;
+            batch.insert(batch.end(), tuple.begin(), tuple.end());
+        }
+    }
+    rel.insertBatch(batch.data(), batch.size() / arity);
+    EXPECT_EQ(110, rel.size());
+    count = 0;
+    for (const auto& tuple : rel.range(1, low, high)) {
+        EXPECT_EQ(3, tuple[0]);
+        ++count;
+    }
+    EXPECT_EQ(11, count);
+}
+
+TEST(Buffered, Insert) {
+    // create a relation with an index on the second attribute next to the main index
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSignature secondAttribute(2);
+    secondAttribute[1] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, secondAttribute};
+    LexOrder fullOrder = {0, 1};
+    LexOrder secondOrder = {1, 0};
+    OrderCollection orders = {fullOrder, secondOrder};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({secondAttribute, secondOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    Relation<2, interpreter::Btree> rel(0, "test", indexSelection);
+    rel.insert(souffle::Tuple<RamDomain, 2>{0, 0});
+
+    // buffered tuples reach none of the indexes until they are merged
+    rel.setInsertBuffer(1000);
+    EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 2>{1, 1}));
+    EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 2>{1, 1}));
+    EXPECT_EQ(1, rel.size());
+    EXPECT_FALSE(rel.contains(souffle::Tuple<RamDomain, 2>{1, 1}));
+    rel.setInsertBuffer(0);
+    EXPECT_EQ(2, rel.size());
+
+    // buffered tuples are merged when a buffer is full, and when buffering ends
+    rel.setInsertBuffer(16);
+#pragma omp parallel for
+    for (RamDomain i = 0; i < 1000; ++i) {
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    rel.setInsertBuffer(0);
+    EXPECT_EQ(1000, rel.size());
+
+    std::size_t count = 0;
+    for (const auto& tuple : rel.range(1, {3, MIN_RAM_SIGNED}, {3, MAX_RAM_SIGNED})) {
+        EXPECT_EQ(3, tuple[0]);
+        ++count;
+    }
+    EXPECT_EQ(143, count);
+
+    // insertions are direct again
+    EXPECT_TRUE(rel.insert(souffle::Tuple<RamDomain, 2>{1000, 0}));
+    EXPECT_FALSE(rel.insert(souffle::Tuple<RamDomain, 2>{1000, 0}));
+}
+
+TEST(Compressed, Range) {
+    // create a relation with an index on the second attribute next to the main index
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSignature secondAttribute(2);
+    secondAttribute[1] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, secondAttribute};
+    LexOrder fullOrder = {0, 1};
+    LexOrder secondOrder = {1, 0};
+    OrderCollection orders = {fullOrder, secondOrder};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({secondAttribute, secondOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    // enough tuples to merge the uncompressed ones into the leaves during the insertions
+    Relation<2, interpreter::Compressed> rel(0, "test", indexSelection);
+    rel.setLazyIndexes(true);
+#pragma omp parallel for
+    for (RamDomain i = 0; i < 100000; ++i) {
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    rel.updateIndexes();
+    EXPECT_EQ(100000, rel.size());
+    EXPECT_TRUE(rel.contains(souffle::Tuple<RamDomain, 2>{99999, 99999 % 7}));
+    EXPECT_FALSE(rel.contains(souffle::Tuple<RamDomain, 2>{99999, 0}));
+
+    std::size_t count = 0;
+    for (const auto& tuple : rel.range(1, {3, MIN_RAM_SIGNED}, {3, MAX_RAM_SIGNED})) {
+        EXPECT_EQ(3, tuple[0]);
+        ++count;
+    }
+    EXPECT_EQ(14286, count);
+}
+
+TEST(Disk, Range) {
+    // create a relation with an index on the second attribute next to the main index
+    SignatureOrderMap mapping;
+    SearchSignature existenceCheck = SearchSignature::getFullSearchSignature(2);
+    SearchSignature secondAttribute(2);
+    secondAttribute[1] = AttributeConstraint::Equal;
+    SearchSet searches = {existenceCheck, secondAttribute};
+    LexOrder fullOrder = {0, 1};
+    LexOrder secondOrder = {1, 0};
+    OrderCollection orders = {fullOrder, secondOrder};
+    mapping.insert({existenceCheck, fullOrder});
+    mapping.insert({secondAttribute, secondOrder});
+    IndexCluster indexSelection(mapping, searches, orders);
+
+    // a budget small enough to spill both indexes during the insertions
+    Relation<2, interpreter::Disk> rel(0, "test", indexSelection);
+    rel.setLazyIndexes(true);
+    rel.setMemoryBudget(2 * 4096 * sizeof(souffle::Tuple<RamDomain, 2>));
+#pragma omp parallel for
+    for (RamDomain i = 0; i < 50000; ++i) {
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+        rel.insert(souffle::Tuple<RamDomain, 2>{i, i % 7});
+    }
+    rel.updateIndexes();
+    EXPECT_EQ(50000, rel.size());
+    EXPECT_TRUE(rel.contains(souffle::Tuple<RamDomain, 2>{49999, 49999 % 7}));
+    EXPECT_FALSE(rel.contains(souffle::Tuple<RamDomain, 2>{49999, 0}));
+
+    std::size_t count = 0;
+    for (const auto& tuple : rel.range(1, {3, MIN_RAM_SIGNED}, {3, MAX_RAM_SIGNED})) {
+        EXPECT_EQ(3, tuple[0]);
+        ++count;
+    }
+    EXPECT_EQ(7143, count);
+}
+
 }  // namespace souffle::interpreter::test
@@ -0,0 +1,163 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file native_code_test.cpp
+ *
+ * Tests the translation of bytecode programs to native code.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "FunctorOps.h"
+#include "interpreter/Bytecode.h"
+#include "interpreter/Context.h"
+#include "interpreter/NativeCode.h"
+#include "ram/Conjunction.h"
+#include "ram/Constraint.h"
+#include "ram/FloatConstant.h"
+#include "ram/IntrinsicOperator.h"
+#include "ram/Negation.h"
+#include "ram/SignedConstant.h"
+#include "ram/TupleElement.h"
+#include "ram/Variable.h"
+#include "souffle/BinaryConstraintOps.h"
+#include "souffle/RamTypes.h"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace souffle::interpreter::test {
+
+/** Environment keeping the order of tuples, and giving each variable its own slot */
+static BytecodeProgram::Environment getEnvironment() {
+    BytecodeProgram::Environment env;
+    env.mapElement = [](std::size_t, std::size_t element) { return element; };
+    env.encodeVariable = [](const std::string& name) { return name == "x" ? 0 : 1; };
+    env.encodeSymbol = [](const std::string& symbol) { return static_cast<RamDomain>(symbol.size()); };
+    return env;
+}
+
+static Own<ram::IntrinsicOperator> mkBinary(
+        FunctorOp op, Own<ram::Expression> lhs, Own<ram::Expression> rhs) {
+    VecOwn<ram::Expression> args;
+    args.push_back(std::move(lhs));
+    args.push_back(std::move(rhs));
+    return mk<ram::IntrinsicOperator>(op, std::move(args));
+}
+
+static Own<ram::IntrinsicOperator> mkUnary(FunctorOp op, Own<ram::Expression> arg) {
+    VecOwn<ram::Expression> args;
+    args.push_back(std::move(arg));
+    return mk<ram::IntrinsicOperator>(op, std::move(args));
+}
+
+/** Values exercising the signs, the extremes and the shift counts beyond the width of a number */
+static const std::vector<RamDomain> values = {0, 1, -1, 2, -3, 7, 31, 32, 33, 63, 64, 100, -100,
+        MIN_RAM_SIGNED, MAX_RAM_SIGNED};
+
+/**
+ * Returns the number of pairs of values for which the native code of a node
+ * computes something else than its bytecode, or -1 if it is not translated.
+ */
+static int countMismatches(const ram::Node& node) {
+    auto program = BytecodeProgram::compile(node, getEnvironment());
+    auto native = NativeProgram::compile(*program);
+    if (native == nullptr) {
+        return -1;
+    }
+
+    int mismatches = 0;
+    RamDomain tuple[2];
+    Context ctxt;
+    ctxt[0] = tuple;
+    for (RamDomain a : values) {
+        for (RamDomain b : values) {
+            tuple[0] = a;
+            tuple[1] = b;
+            ctxt.setVariable(0, b);
+            mismatches += program->execute(ctxt) != native->execute(ctxt);
+        }
+    }
+    return mismatches;
+}
+
+/** The result of countMismatches for a node computed alike by its native code and its bytecode */
+static const int same = NativeProgram::isSupported() ? 0 : -1;
+
+TEST(NativeCode, Arithmetic) {
+    for (FunctorOp op : {FunctorOp::ADD, FunctorOp::SUB, FunctorOp::MUL, FunctorOp::BAND, FunctorOp::BOR,
+                 FunctorOp::BXOR, FunctorOp::BSHIFT_L, FunctorOp::BSHIFT_R, FunctorOp::BSHIFT_R_UNSIGNED,
+                 FunctorOp::LAND, FunctorOp::LOR, FunctorOp::LXOR, FunctorOp::MAX, FunctorOp::UMAX,
+                 FunctorOp::MIN, FunctorOp::UMIN}) {
+        auto expr = mkBinary(op, mk<ram::TupleElement>(0, 0), mk<ram::Variable>("x"));
+        EXPECT_EQ(same, countMismatches(*expr));
+    }
+    for (FunctorOp op : {FunctorOp::NEG, FunctorOp::BNOT, FunctorOp::LNOT}) {
+        EXPECT_EQ(same, countMismatches(*mkUnary(op, mk<ram::TupleElement>(0, 0))));
+    }
+
+    // (t0.0 * 3 - x) max -7
+    auto product = mkBinary(FunctorOp::MUL, mk<ram::TupleElement>(0, 0), mk<ram::SignedConstant>(3));
+    auto difference = mkBinary(FunctorOp::SUB, std::move(product), mk<ram::Variable>("x"));
+    auto max = mkBinary(FunctorOp::MAX, std::move(difference), mk<ram::SignedConstant>(-7));
+    EXPECT_EQ(same, countMismatches(*max));
+}
+
+TEST(NativeCode, Conditions) {
+    for (BinaryConstraintOp op : {BinaryConstraintOp::EQ, BinaryConstraintOp::NE, BinaryConstraintOp::LT,
+                 BinaryConstraintOp::ULT, BinaryConstraintOp::LE, BinaryConstraintOp::ULE,
+                 BinaryConstraintOp::GT, BinaryConstraintOp::UGT, BinaryConstraintOp::GE,
+                 BinaryConstraintOp::UGE}) {
+        ram::Constraint constraint(op, mk<ram::TupleElement>(0, 0), mk<ram::Variable>("x"));
+        EXPECT_EQ(same, countMismatches(constraint));
+    }
+
+    // fused loads of elements and constants
+    ram::Constraint fused(BinaryConstraintOp::EQ, mk<ram::TupleElement>(0, 1), mk<ram::SignedConstant>(7));
+    EXPECT_EQ(same, countMismatches(fused));
+    ram::Constraint join(BinaryConstraintOp::NE, mk<ram::TupleElement>(0, 0), mk<ram::TupleElement>(0, 1));
+    EXPECT_EQ(same, countMismatches(join));
+
+    // !(t0.0 = t0.1) /\ t0.0 < t0.1, whose right-hand side is skipped by a jump
+    ram::Conjunction conj(mk<ram::Negation>(mk<ram::Constraint>(BinaryConstraintOp::EQ,
+                                  mk<ram::TupleElement>(0, 0), mk<ram::TupleElement>(0, 1))),
+            mk<ram::Constraint>(BinaryConstraintOp::LT, mk<ram::TupleElement>(0, 0),
+                    mk<ram::TupleElement>(0, 1)));
+    EXPECT_EQ(same, countMismatches(conj));
+}
+
+TEST(NativeCode, Variables) {
+    ram::Constraint constraint(BinaryConstraintOp::EQ, mk<ram::Variable>("y"), mk<ram::SignedConstant>(0));
+    auto program = BytecodeProgram::compile(constraint, getEnvironment());
+    auto native = NativeProgram::compile(*program);
+    if (native == nullptr) {
+        return;
+    }
+
+    // a variable is zero until it is assigned
+    Context ctxt;
+    EXPECT_EQ(1, native->execute(ctxt));
+    ctxt.setVariable(0, 5);
+    EXPECT_EQ(1, native->execute(ctxt));
+    ctxt.setVariable(1, 5);
+    EXPECT_EQ(0, native->execute(ctxt));
+}
+
+TEST(NativeCode, Unsupported) {
+    // floating-point operations are left to the bytecode
+    auto div = mkBinary(FunctorOp::FDIV, mk<ram::FloatConstant>(1.0), mk<ram::FloatConstant>(4.0));
+    auto program = BytecodeProgram::compile(*div, getEnvironment());
+    EXPECT_TRUE(program != nullptr);
+    EXPECT_TRUE(NativeProgram::compile(*program) == nullptr);
+}
+
+}  // namespace souffle::interpreter::test
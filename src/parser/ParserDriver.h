@@ -107,6 +107,10 @@ public:
 
     bool trace_scanning = false;
 
+    // Whether the parser is reading the qualifiers of a relation declaration,
+    // the only place where qualifiers such as `hashset`, `compressed` and `disk` are keywords.
+    bool ScanningRelationTags = false;
+
     // Canonical path and line number of location that have already been
     // visited by `.once`.
     std::set<std::pair<std::filesystem::path, int>> VisitedOnceLocations;
@@ -135,7 +135,10 @@
 %token BRIE_QUALIFIER            "BRIE datastructure qualifier"
 %token BTREE_QUALIFIER           "BTREE datastructure qualifier"
 %token BTREE_DELETE_QUALIFIER    "BTREE_DELETE datastructure qualifier"
+%token COMPRESSED_QUALIFIER      "COMPRESSED datastructure qualifier"
+%token DISK_QUALIFIER            "DISK datastructure qualifier"
 %token EQREL_QUALIFIER           "equivalence relation qualifier"
+%token HASHSET_QUALIFIER         "HASHSET datastructure qualifier"
 %token OVERRIDABLE_QUALIFIER     "relation qualifier overidable"
 %token INLINE_QUALIFIER          "relation qualifier inline"
 %token NO_INLINE_QUALIFIER       "relation qualifier no_inline"
@@ -468,7 +471,15 @@ adt_branch
  * Relation Declaration
  */
 relation_decl
-  : DECL relation_names attributes_list relation_tags dependency_list
+  : DECL relation_names attributes_list
+    {
+      driver.ScanningRelationTags = true;
+    }
+    relation_tags
+    {
+      driver.ScanningRelationTags = false;
+    }
+    dependency_list
     {
       auto tags = $relation_tags;
       auto attributes_list = $attributes_list;
@@ -489,8 +500,14 @@ relation_decl
         rel->setAttributes(clone(attributes_list));
       }
     }
-  | DECL IDENT EQUALS DEBUG_DELTA LPAREN IDENT RPAREN relation_tags
+  | DECL IDENT EQUALS DEBUG_DELTA LPAREN IDENT RPAREN
     {
+      driver.ScanningRelationTags = true;
+    }
+    relation_tags
+    {
+      driver.ScanningRelationTags = false;
+
       auto tags = $relation_tags;
       $$.push_back(mk<ast::Relation>($2, @2));
       for (auto&& rel : $$) {
@@ -593,10 +610,22 @@ relation_tags
     {
       $$ = driver.addReprTag(RelationTag::BTREE_DELETE, @2, $1);
     }
+  | relation_tags COMPRESSED_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::COMPRESSED, @2, $1);
+    }
+  | relation_tags DISK_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::DISK, @2, $1);
+    }
   | relation_tags EQREL_QUALIFIER
     {
       $$ = driver.addReprTag(RelationTag::EQREL, @2, $1);
     }
+  | relation_tags HASHSET_QUALIFIER
+    {
+      $$ = driver.addReprTag(RelationTag::HASHSET, @2, $1);
+    }
   /* Deprecated Qualifiers */
   | relation_tags OUTPUT_QUALIFIER
     {
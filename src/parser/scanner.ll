@@ -196,6 +196,30 @@ WS [ \t\r\v\f]
 "brie"                                { return yy::parser::make_BRIE_QUALIFIER(yylloc); }
 "btree_delete"                        { return yy::parser::make_BTREE_DELETE_QUALIFIER(yylloc); }
 "btree"                               { return yy::parser::make_BTREE_QUALIFIER(yylloc); }
+"hashset"/[ \t\r\n\v\f]*"("           { return yy::parser::make_IDENT(yytext, yylloc); }
+"hashset"                             {
+                                        // a keyword only among the qualifiers of a relation declaration
+                                        if (driver.ScanningRelationTags) {
+                                          return yy::parser::make_HASHSET_QUALIFIER(yylloc);
+                                        }
+                                        return yy::parser::make_IDENT(yytext, yylloc);
+                                      }
+"compressed"/[ \t\r\n\v\f]*"("        { return yy::parser::make_IDENT(yytext, yylloc); }
+"compressed"                          {
+                                        // a keyword only among the qualifiers of a relation declaration
+                                        if (driver.ScanningRelationTags) {
+                                          return yy::parser::make_COMPRESSED_QUALIFIER(yylloc);
+                                        }
+                                        return yy::parser::make_IDENT(yytext, yylloc);
+                                      }
+"disk"/[ \t\r\n\v\f]*"("              { return yy::parser::make_IDENT(yytext, yylloc); }
+"disk"                                {
+                                        // a keyword only among the qualifiers of a relation declaration
+                                        if (driver.ScanningRelationTags) {
+                                          return yy::parser::make_DISK_QUALIFIER(yylloc);
+                                        }
+                                        return yy::parser::make_IDENT(yytext, yylloc);
+                                      }
 "min"                                 { return yy::parser::make_MIN(yylloc); }
 "max"                                 { return yy::parser::make_MAX(yylloc); }
 "as"                                  { return yy::parser::make_AS(yylloc); }
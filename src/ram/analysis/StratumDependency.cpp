@@ -0,0 +1,155 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file StratumDependency.cpp
+ *
+ * Implementation of RAM Stratum Dependency Analysis
+ *
+ ***********************************************************************/
+
+#include "ram/analysis/StratumDependency.h"
+#include "ram/AbstractExistenceCheck.h"
+#include "ram/AutoIncrement.h"
+#include "ram/BinRelationStatement.h"
+#include "ram/Call.h"
+#include "ram/Clear.h"
+#include "ram/EmptinessCheck.h"
+#include "ram/Erase.h"
+#include "ram/IO.h"
+#include "ram/Insert.h"
+#include "ram/Program.h"
+#include "ram/RelationOperation.h"
+#include "ram/RelationSize.h"
+#include "ram/RelationStatement.h"
+#include "ram/Sequence.h"
+#include "ram/utility/Visitor.h"
+#include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/StreamUtil.h"
+#include <map>
+
+namespace souffle::ram::analysis {
+
+namespace {
+
+/** Pseudo relations for side effects that must retain their order */
+constexpr const char* counterResource = "@@counter";
+constexpr const char* stdoutResource = "@@stdout";
+
+/** Relations read and written by a single stratum */
+struct Accesses {
+    std::set<std::string> reads;
+    std::set<std::string> writes;
+};
+
+Accesses collectAccesses(const Statement& stmt) {
+    Accesses acc;
+
+    // reads
+    visit(stmt, [&](const RelationOperation& op) { acc.reads.insert(op.getRelation()); });
+    visit(stmt, [&](const AbstractExistenceCheck& check) { acc.reads.insert(check.getRelation()); });
+    visit(stmt, [&](const EmptinessCheck& check) { acc.reads.insert(check.getRelation()); });
+    visit(stmt, [&](const RelationSize& size) { acc.reads.insert(size.getRelation()); });
+    visit(stmt, [&](const RelationStatement& rs) { acc.reads.insert(rs.getRelation()); });
+
+    // writes
+    visit(stmt, [&](const Insert& insert) { acc.writes.insert(insert.getRelation()); });
+    visit(stmt, [&](const Erase& erase) { acc.writes.insert(erase.getRelation()); });
+    visit(stmt, [&](const Clear& clear) { acc.writes.insert(clear.getRelation()); });
+    visit(stmt, [&](const BinRelationStatement& bin) {
+        acc.writes.insert(bin.getFirstRelation());
+        acc.writes.insert(bin.getSecondRelation());
+    });
+    visit(stmt, [&](const IO& io) {
+        const auto& directives = io.getDirectives();
+        if (io.get("operation") == "input") {
+            acc.writes.insert(io.getRelation());
+        }
+        auto it = directives.find("IO");
+        if (io.get("operation") == "printsize" || (it != directives.end() && it->second == "stdout")) {
+            acc.writes.insert(stdoutResource);
+        }
+    });
+    visit(stmt, [&](const AutoIncrement&) { acc.writes.insert(counterResource); });
+
+    return acc;
+}
+
+}  // namespace
+
+void StratumDependencyAnalysis::run(const TranslationUnit& tUnit) {
+    const Program& program = tUnit.getProgram();
+    const auto* main = as<Sequence>(program.getMain());
+    if (main == nullptr) {
+        return;
+    }
+
+    // the main program must only consist of subroutine calls
+    for (const auto* stmt : main->getStatements()) {
+        const auto* call = as<Call>(stmt);
+        if (call == nullptr) {
+            calls.clear();
+            return;
+        }
+        calls.push_back(call->getName());
+    }
+
+    // last writer and readers since the last write of each relation
+    std::map<std::string, std::size_t> lastWriter;
+    std::map<std::string, std::set<std::size_t>> lastReaders;
+
+    const std::string prefix = "stratum_";
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        std::string subName = calls[i];
+        if (subName.compare(0, prefix.size(), prefix) == 0) {
+            subName = subName.substr(prefix.size());
+        }
+        Accesses acc = collectAccesses(program.getSubroutine(subName));
+
+        std::set<std::size_t> preds;
+        for (const auto& rel : acc.reads) {
+            auto it = lastWriter.find(rel);
+            if (it != lastWriter.end()) {
+                preds.insert(it->second);
+            }
+        }
+        for (const auto& rel : acc.writes) {
+            auto it = lastWriter.find(rel);
+            if (it != lastWriter.end()) {
+                preds.insert(it->second);
+            }
+            for (std::size_t reader : lastReaders[rel]) {
+                preds.insert(reader);
+            }
+            lastWriter[rel] = i;
+            lastReaders[rel].clear();
+        }
+        for (const auto& rel : acc.reads) {
+            if (!contains(acc.writes, rel)) {
+                lastReaders[rel].insert(i);
+            }
+        }
+        preds.erase(i);
+        predecessors.emplace_back(preds.begin(), preds.end());
+    }
+
+    schedulable = true;
+}
+
+void StratumDependencyAnalysis::print(std::ostream& os) const {
+    if (!schedulable) {
+        os << "main program cannot be scheduled" << std::endl;
+        return;
+    }
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        os << i << ": " << calls[i] << " <- {" << join(predecessors[i], ",") << "}" << std::endl;
+    }
+}
+
+}  // namespace souffle::ram::analysis
@@ -0,0 +1,76 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file StratumDependency.h
+ *
+ * Computes the dependencies between the strata invoked by the main
+ * program, so that independent strata can be evaluated concurrently.
+ *
+ ***********************************************************************/
+
+#pragma once
+
+#include "ram/Node.h"
+#include "ram/TranslationUnit.h"
+#include <cstddef>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace souffle::ram::analysis {
+
+/**
+ * @class StratumDependencyAnalysis
+ * @brief A RAM analysis computing a dependency DAG over the strata of the main program
+ *
+ * The analysis applies when the main program is a flat sequence of subroutine
+ * calls, which is the shape produced by the AST to RAM translation. For each call
+ * it collects the relations that are read and written by the invoked subroutine.
+ * A call depends on an earlier call if they access a common relation and at least
+ * one of the two writes to it. Clearing expired relations is a write, hence a stratum
+ * clearing a relation waits for all earlier readers of that relation.
+ *
+ * Side effects that are observable across strata (auto-increment counters and
+ * output to stdout) are modelled as writes to pseudo relations so that their
+ * original order is preserved.
+ */
+class StratumDependencyAnalysis : public Analysis {
+public:
+    StratumDependencyAnalysis() : Analysis(name) {}
+
+    static constexpr const char* name = "stratum-dependency-analysis";
+
+    void run(const TranslationUnit& tUnit) override;
+
+    void print(std::ostream& os) const override;
+
+    /** @brief Whether the main program is a sequence of calls that can be scheduled */
+    bool isSchedulable() const {
+        return schedulable;
+    }
+
+    /** @brief Get the names of the called subroutines in program order */
+    const std::vector<std::string>& getCalls() const {
+        return calls;
+    }
+
+    /** @brief Get the indices of the calls that must complete before the given call */
+    const std::vector<std::vector<std::size_t>>& getPredecessors() const {
+        return predecessors;
+    }
+
+protected:
+    bool schedulable = false;
+    std::vector<std::string> calls;
+    std::vector<std::vector<std::size_t>> predecessors;
+};
+
+}  // namespace souffle::ram::analysis
@@ -96,12 +96,17 @@ ExpressionPair MakeIndexTransformer::getLowerUpperExpression(Condition* c, std::
         bool provenance = rep == RelationRepresentation::PROVENANCE;
         bool btree = (rep == RelationRepresentation::BTREE || rep == RelationRepresentation::DEFAULT ||
                       rep == RelationRepresentation::BTREE_DELETE);
+        bool hashset = rep == RelationRepresentation::HASHSET;
         auto op = binRelOp->getOperator();
 
         // don't index FEQ in interpreter mode
         if (op == BinaryConstraintOp::FEQ && interpreter) {
             return {mk<UndefValue>(), mk<UndefValue>()};
         }
+        // don't index FEQ in a hash set, which compares the bit patterns of floats
+        if (op == BinaryConstraintOp::FEQ && hashset) {
+            return {mk<UndefValue>(), mk<UndefValue>()};
+        }
         // don't index any inequalities that aren't signed
         if (isIneqConstraint(op) && !isSignedInequalityConstraint(op) && interpreter) {
             return {mk<UndefValue>(), mk<UndefValue>()};
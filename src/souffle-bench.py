@@ -0,0 +1,405 @@
+#!/usr/bin/env python3
+# Souffle - A Datalog Compiler
+# Copyright (c) 2026 The Souffle Developers. All rights reserved
+# Licensed under the Universal Permissive License v 1.0 as shown at:
+# - https://opensource.org/licenses/UPL
+# - <souffle root>/licenses/SOUFFLE-UPL.txt
+
+# Benchmark harness for the evaluation engines.
+#
+# Runs a Datalog program on synthetic (or user provided) facts in interpreted
+# and compiled mode for a range of thread counts and reports wall-clock time,
+# peak resident set size and per-relation throughput as JSON or CSV. A previous
+# report can be given as baseline to detect performance regressions.
+
+import argparse
+import csv
+import json
+import os
+import pathlib
+import random
+import shutil
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+scriptdir = pathlib.Path(os.path.dirname(os.path.abspath(__file__)))
+
+# --------------------------------------------------
+# Built-in workloads
+# --------------------------------------------------
+
+TC_PROGRAM = """
+.decl edge(x:number, y:number)
+.input edge
+.decl path(x:number, y:number)
+.output path
+path(x, y) :- edge(x, y).
+path(x, z) :- path(x, y), edge(y, z).
+"""
+
+POINTS_TO_PROGRAM = """
+.decl alloc(var:number, heap:number)
+.input alloc
+.decl assign(to:number, from:number)
+.input assign
+.decl load(to:number, base:number, field:number)
+.input load
+.decl store(base:number, field:number, from:number)
+.input store
+.decl pointsTo(var:number, heap:number)
+.output pointsTo
+.decl heapPointsTo(base:number, field:number, heap:number)
+.output heapPointsTo
+pointsTo(v, h) :- alloc(v, h).
+pointsTo(v, h) :- assign(v, w), pointsTo(w, h).
+pointsTo(v, h) :- load(v, b, f), pointsTo(b, g), heapPointsTo(g, f, h).
+heapPointsTo(g, f, h) :- store(b, f, w), pointsTo(b, g), pointsTo(w, h).
+"""
+
+SAME_GENERATION_PROGRAM = """
+.decl parent(child:number, parent:number)
+.input parent
+.decl sameGeneration(x:number, y:number)
+.output sameGeneration
+sameGeneration(x, y) :- parent(x, p), parent(y, p), x != y.
+sameGeneration(x, y) :- parent(x, a), sameGeneration(a, b), parent(y, b).
+"""
+
+CSPA_PROGRAM = """
+.decl assign(to:number, from:number)
+.input assign
+.decl dereference(ptr:number, val:number)
+.input dereference
+.decl valueFlow(x:number, y:number)
+.output valueFlow
+.decl valueAlias(x:number, y:number)
+.output valueAlias
+.decl memoryAlias(x:number, y:number)
+.output memoryAlias
+valueFlow(y, x) :- assign(y, x).
+valueFlow(x, y) :- assign(x, z), memoryAlias(z, y).
+valueFlow(x, y) :- valueFlow(x, z), valueFlow(z, y).
+memoryAlias(x, w) :- dereference(y, x), valueAlias(y, z), dereference(z, w).
+valueAlias(x, y) :- valueFlow(z, x), valueFlow(z, y).
+valueAlias(x, y) :- valueFlow(z, x), memoryAlias(z, w), valueFlow(w, y).
+valueFlow(x, x) :- assign(x, _).
+valueFlow(x, x) :- assign(_, x).
+memoryAlias(x, x) :- assign(_, x).
+memoryAlias(x, x) :- assign(x, _).
+"""
+
+SKEWED_JOIN_PROGRAM = """
+.decl edge(x:number, y:number)
+.input edge
+.decl twoHop(x:number, z:number)
+.output twoHop
+twoHop(x, z) :- edge(x, y), edge(y, z).
+"""
+
+
+def random_pairs(rng, count, left, right):
+    return [(rng.randrange(left), rng.randrange(right)) for _ in range(count)]
+
+
+def generate_tc(rng, scale):
+    # a sparse random graph with an average out-degree of two
+    return {"edge": random_pairs(rng, 2 * scale, scale, scale)}
+
+
+def generate_points_to(rng, scale):
+    variables = scale
+    heaps = max(1, scale // 4)
+    fields = max(1, scale // 64)
+    return {
+        "alloc": random_pairs(rng, variables, variables, heaps),
+        "assign": random_pairs(rng, variables, variables, variables),
+        "load": [(rng.randrange(variables), rng.randrange(variables), rng.randrange(fields))
+                 for _ in range(variables // 4)],
+        "store": [(rng.randrange(variables), rng.randrange(fields), rng.randrange(variables))
+                  for _ in range(variables // 4)],
+    }
+
+
+def generate_same_generation(rng, scale):
+    # a random tree, each node picks a parent among the earlier nodes
+    return {"parent": [(child, rng.randrange(child)) for child in range(1, scale)]}
+
+
+def generate_cspa(rng, scale):
+    return {
+        "assign": random_pairs(rng, scale, scale, scale),
+        "dereference": random_pairs(rng, scale // 2, scale, scale),
+    }
+
+
+def generate_skewed_join(rng, scale):
+    # a hub whose out-edges dominate the nested scan of the join, reached from
+    # a few nodes only, so that the outer loop alone cannot balance the threads
+    hub = [(0, target) for target in range(1, scale + 1)]
+    into_hub = [(rng.randrange(1, scale + 1), 0) for _ in range(64)]
+    return {"edge": hub + into_hub + random_pairs(rng, 2 * scale, scale, scale)}
+
+
+WORKLOADS = {
+    "tc": (TC_PROGRAM, generate_tc),
+    "points-to": (POINTS_TO_PROGRAM, generate_points_to),
+    "same-generation": (SAME_GENERATION_PROGRAM, generate_same_generation),
+    "cspa": (CSPA_PROGRAM, generate_cspa),
+    "skewed-join": (SKEWED_JOIN_PROGRAM, generate_skewed_join),
+}
+
+
+def write_facts(facts, factdir):
+    factdir.mkdir(parents=True, exist_ok=True)
+    for relation, tuples in facts.items():
+        with open(factdir / "{}.facts".format(relation), "w") as out:
+            for tup in sorted(set(tuples)):
+                out.write("\t".join(map(str, tup)) + "\n")
+
+# --------------------------------------------------
+# Running souffle
+# --------------------------------------------------
+
+
+def run_measured(cmd, verbose=False):
+    """Run a command and return its wall-clock time in seconds and peak RSS in KiB."""
+    if verbose:
+        sys.stderr.write(" ".join(map(str, cmd)) + "\n")
+    with tempfile.TemporaryFile() as errors:
+        start = time.perf_counter()
+        proc = subprocess.Popen(list(map(str, cmd)), stdout=subprocess.DEVNULL, stderr=errors)
+        _, status, usage = os.wait4(proc.pid, 0)
+        elapsed = time.perf_counter() - start
+        proc.returncode = os.WEXITSTATUS(status) if os.WIFEXITED(status) else -1
+        if proc.returncode != 0:
+            errors.seek(0)
+            sys.stderr.write(errors.read().decode())
+            raise RuntimeError("Error: command failed: {}".format(" ".join(map(str, cmd))))
+    # ru_maxrss is reported in bytes on macOS and in KiB elsewhere
+    peak_rss = usage.ru_maxrss // 1024 if sys.platform == "darwin" else usage.ru_maxrss
+    return elapsed, peak_rss
+
+
+def relation_statistics(profile):
+    """Extract the number of tuples and the evaluation time of each relation from a profile."""
+    with open(profile) as f:
+        data = json.load(f)
+    relations = data.get("root", {}).get("program", {}).get("relation", {})
+    stats = {}
+    for name, rel in relations.items():
+        tuples = rel.get("num-tuples", 0)
+        runtime = 0.0
+        if "runtime" in rel:
+            runtime += (rel["runtime"]["end"] - rel["runtime"]["start"]) / 1e6
+        for iteration in rel.get("iteration", {}).values():
+            tuples += iteration.get("num-tuples", 0)
+            if "runtime" in iteration:
+                runtime += (iteration["runtime"]["end"] - iteration["runtime"]["start"]) / 1e6
+        stats[name] = {
+            "tuples": tuples,
+            "runtime": runtime,
+            "tuples_per_sec": tuples / runtime if runtime > 0 else None,
+        }
+    return stats
+
+
+class Engine:
+    """Runs a program in one evaluation mode."""
+
+    def __init__(self, souffle, mode, program, workdir, verbose):
+        self.souffle = souffle
+        self.mode = mode
+        self.program = program
+        self.workdir = workdir
+        self.verbose = verbose
+        self.compile_time = None
+        self.executable = None
+        self.profiled_executable = None
+
+    def prepare(self, relation_stats):
+        if self.mode != "compiled":
+            return
+        self.executable = self.workdir / "bench-{}".format(self.mode)
+        start = time.perf_counter()
+        run_measured([self.souffle, "-o", self.executable, self.program], self.verbose)
+        self.compile_time = time.perf_counter() - start
+        if relation_stats:
+            self.profiled_executable = self.workdir / "bench-{}-profiled".format(self.mode)
+            run_measured([self.souffle, "-p", self.workdir / "unused.log", "-o", self.profiled_executable,
+                          self.program], self.verbose)
+
+    def command(self, jobs, factdir, outdir, profile=None):
+        if self.mode == "compiled":
+            cmd = [self.profiled_executable if profile else self.executable]
+        else:
+            cmd = [self.souffle, self.program]
+        cmd += ["-j{}".format(jobs), "-F", factdir, "-D", outdir]
+        if profile:
+            cmd += ["-p", profile]
+        return cmd
+
+
+def benchmark(args, name, program, factdir, workdir):
+    results = []
+    for mode in args.modes:
+        engine = Engine(args.souffle, mode, program, workdir, args.verbose)
+        engine.prepare(args.relation_stats)
+        for jobs in args.jobs:
+            outdir = workdir / "out-{}-{}".format(mode, jobs)
+            outdir.mkdir(exist_ok=True)
+
+            times = []
+            peak_rss = 0
+            for _ in range(args.repeat):
+                elapsed, rss = run_measured(engine.command(jobs, factdir, outdir), args.verbose)
+                times.append(elapsed)
+                peak_rss = max(peak_rss, rss)
+
+            result = {
+                "workload": name,
+                "scale": args.scale,
+                "mode": mode,
+                "jobs": jobs,
+                "wall_time": statistics.median(times),
+                "wall_times": times,
+                "peak_rss_kb": peak_rss,
+                "compile_time": engine.compile_time,
+            }
+
+            if args.relation_stats:
+                profile = workdir / "profile-{}-{}.json".format(mode, jobs)
+                run_measured(engine.command(jobs, factdir, outdir, profile), args.verbose)
+                result["relations"] = relation_statistics(profile)
+
+            results.append(result)
+            sys.stderr.write("{} {} -j{}: {:.3f}s, {} KiB\n".format(
+                name, mode, jobs, result["wall_time"], result["peak_rss_kb"]))
+    return results
+
+# --------------------------------------------------
+# Reporting
+# --------------------------------------------------
+
+
+def result_key(result):
+    return (result["workload"], result["scale"], result["mode"], result["jobs"])
+
+
+def compare_with_baseline(results, baseline, tolerance):
+    """Return the configurations that are slower than the baseline by more than the tolerance."""
+    previous = {result_key(r): r for r in baseline}
+    regressions = []
+    for result in results:
+        old = previous.get(result_key(result))
+        if old is None:
+            continue
+        if result["wall_time"] > old["wall_time"] * (1 + tolerance):
+            regressions.append((result, old))
+    return regressions
+
+
+def write_report(results, fmt, out):
+    if fmt == "json":
+        json.dump(results, out, indent=2)
+        out.write("\n")
+        return
+    writer = csv.writer(out)
+    writer.writerow(["workload", "scale", "mode", "jobs", "wall_time", "peak_rss_kb", "compile_time",
+                     "relation", "tuples", "relation_time", "tuples_per_sec"])
+    for r in results:
+        prefix = [r["workload"], r["scale"], r["mode"], r["jobs"], r["wall_time"], r["peak_rss_kb"],
+                  r["compile_time"]]
+        relations = r.get("relations", {})
+        if not relations:
+            writer.writerow(prefix + ["", "", "", ""])
+        for name, rel in sorted(relations.items()):
+            writer.writerow(prefix + [name, rel["tuples"], rel["runtime"], rel["tuples_per_sec"]])
+
+
+def find_souffle():
+    for candidate in [scriptdir / "souffle", scriptdir / "souffle.exe"]:
+        if candidate.exists():
+            return candidate
+    found = shutil.which("souffle")
+    if found:
+        return pathlib.Path(found)
+    raise RuntimeError("Cannot find the souffle executable, use --souffle")
+
+
+def comma_list(convert):
+    return lambda text: [convert(item) for item in text.split(",") if item]
+
+
+parser = argparse.ArgumentParser(description="Benchmark the Souffle evaluation engines")
+parser.add_argument('-w', '--workload', action='append', default=[], choices=sorted(WORKLOADS.keys()),
+                    help="Built-in workload with synthetic facts (can be repeated)")
+parser.add_argument('--program', type=lambda p: pathlib.Path(p).absolute(),
+                    help="Benchmark the given Datalog program instead of a built-in workload")
+parser.add_argument('-F', '--fact-dir', type=lambda p: pathlib.Path(p).absolute(),
+                    help="Fact directory of the given program")
+parser.add_argument('-n', '--scale', type=int, default=1000, help="Size parameter of the fact generators")
+parser.add_argument('--seed', type=int, default=0, help="Seed of the fact generators")
+parser.add_argument('-m', '--modes', type=comma_list(str), default=["interpreted", "compiled"],
+                    help="Comma separated evaluation modes: interpreted, compiled")
+parser.add_argument('-j', '--jobs', type=comma_list(int), default=[1], help="Comma separated thread counts")
+parser.add_argument('-r', '--repeat', type=int, default=3, help="Number of timed runs per configuration")
+parser.add_argument('--no-relation-stats', action='store_false', dest='relation_stats',
+                    help="Skip the profiled run collecting per-relation statistics")
+parser.add_argument('--format', choices=["json", "csv"], default="json", help="Report format")
+parser.add_argument('-o', '--output', type=pathlib.Path, help="Report file (default: stdout)")
+parser.add_argument('--baseline', type=pathlib.Path, help="JSON report of a previous run to compare against")
+parser.add_argument('--tolerance', type=float, default=0.1,
+                    help="Accepted relative slowdown against the baseline")
+parser.add_argument('--souffle', type=lambda p: pathlib.Path(p).absolute(), help="Path of the souffle executable")
+parser.add_argument('--keep', type=pathlib.Path, help="Keep the generated files in the given directory")
+parser.add_argument('-v', action='store_true', dest='verbose', help="Verbose output")
+
+args = parser.parse_args()
+
+for mode in args.modes:
+    if mode not in ["interpreted", "compiled"]:
+        raise RuntimeError("Unknown evaluation mode: '{}'".format(mode))
+if args.program and args.workload:
+    raise RuntimeError("--program and --workload are mutually exclusive")
+if not args.program and not args.workload:
+    args.workload = sorted(WORKLOADS.keys())
+if not args.souffle:
+    args.souffle = find_souffle()
+
+basedir = args.keep.absolute() if args.keep else pathlib.Path(tempfile.mkdtemp(prefix="souffle-bench-"))
+results = []
+try:
+    if args.program:
+        workdir = basedir / args.program.stem
+        workdir.mkdir(parents=True, exist_ok=True)
+        factdir = args.fact_dir if args.fact_dir else args.program.parent
+        results += benchmark(args, args.program.stem, args.program, factdir, workdir)
+    for name in args.workload:
+        program_text, generator = WORKLOADS[name]
+        workdir = basedir / name
+        workdir.mkdir(parents=True, exist_ok=True)
+        program = workdir / "{}.dl".format(name.replace("-", "_"))
+        program.write_text(program_text)
+        write_facts(generator(random.Random(args.seed), args.scale), workdir / "facts")
+        results += benchmark(args, name, program, workdir / "facts", workdir)
+finally:
+    if not args.keep:
+        shutil.rmtree(basedir, ignore_errors=True)
+
+if args.output:
+    with open(args.output, "w") as out:
+        write_report(results, args.format, out)
+else:
+    write_report(results, args.format, sys.stdout)
+
+if args.baseline:
+    with open(args.baseline) as f:
+        regressions = compare_with_baseline(results, json.load(f), args.tolerance)
+    for new, old in regressions:
+        sys.stderr.write("Regression: {} {} -j{}: {:.3f}s (baseline {:.3f}s)\n".format(
+            new["workload"], new["mode"], new["jobs"], new["wall_time"], old["wall_time"]))
+    if regressions:
+        os.sys.exit(1)
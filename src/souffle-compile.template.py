@@ -29,9 +29,12 @@ if not JSON_DATA_TEXT:
     }"""
 
 import argparse
+import concurrent.futures
+import hashlib
 import json
 import os
 import pathlib
+import re
 import shutil
 import subprocess
 import sys
@@ -74,6 +77,8 @@ parser.add_argument('-L', action='append', default=[], metavar='LIBDIR', dest='l
 parser.add_argument('-g', action='store_true', dest='debug', help="Debug build type")
 parser.add_argument('-s', metavar='LANG', dest='swiglang', choices=["java", "python"], help="use SWIG interface to generate into LANG language")
 parser.add_argument('-v', action='store_true', dest='verbose', help="Verbose output")
+parser.add_argument('-j', metavar='N', dest='jobs', type=int, default=1, help="Number of source files compiled concurrently")
+parser.add_argument('--cache', metavar='DIR', dest='cache', type=lambda p: pathlib.Path(p).absolute(), help="Directory of compiled objects that are reused across builds")
 parser.add_argument('source', nargs='+', metavar='SOURCE', type=lambda p: pathlib.Path(p).absolute(), help="C++ source files")
 parser.add_argument('-o', metavar='BINARY', dest='output', type=lambda p: pathlib.Path(p).absolute(), help="Binary file name")
 
@@ -82,6 +87,9 @@ args = parser.parse_args()
 if not args.output:
     raise RuntimeError("Missing output file name in souffle-compile")
 
+if args.jobs < 1:
+    raise RuntimeError("Number of jobs must be at least 1 in souffle-compile")
+
 for f in args.source:
     if not os.path.isfile(f):
         raise RuntimeError("Cannot open source file: '{}'".format(f))
@@ -182,6 +190,7 @@ if args.swiglang:
         os.sys.exit(0)
 else:
     exepath = pathlib.Path("{}{}".format(args.output, exeext))
+    is_msvc = conf['compiler_id'] == "MSVC"
 
     cmd = []
     cmd.append('"{}"'.format(conf['compiler']))
@@ -196,9 +205,99 @@ else:
     else:
         cmd.append(conf['release_cxx_flags'])
 
+    objext = ".obj" if is_msvc else ".o"
+
+    # Each object in the cache is named by a hash of everything its compilation depends on: the
+    # compiler and its version, the flags, the Souffle headers, and the source file together with the
+    # headers it includes from its own directory, which --generate-many emits next to the sources.
+    if args.cache:
+        args.cache.mkdir(parents=True, exist_ok=True)
+        cache_key = hashlib.sha256()
+        cache_key.update(" ".join([conf['compiler_id'], conf['compiler_version'], conf['msvc_version']]).encode())
+        if not is_msvc:
+            cache_key.update(capture_command_output('"{}" --version'.format(conf['compiler']), "Compiler version").encode())
+        cache_key.update(" ".join(cmd).encode())
+        if souffle_include_dir:
+            for header in sorted(p for p in souffle_include_dir.rglob("*") if p.is_file()):
+                cache_key.update(str(header.relative_to(souffle_include_dir)).encode())
+                cache_key.update(header.read_bytes())
+
+        def local_headers(f, headers):
+            for name in re.findall(r'^\s*#\s*include\s*"([^"]+)"', f.read_text(), re.MULTILINE):
+                header = (f.parent / name).resolve()
+                if header.is_file() and header not in headers:
+                    headers.add(header)
+                    local_headers(header, headers)
+            return headers
+
+        def cached_object(f):
+            key = cache_key.copy()
+            key.update(f.read_bytes())
+            for header in sorted(local_headers(f, set())):
+                key.update(os.path.relpath(header, f.parent).encode())
+                key.update(header.read_bytes())
+            return args.cache / (key.hexdigest() + objext)
+
+    # Several source files are compiled to objects concurrently, and then linked.
+    # The largest files are started first so that the jobs finish close together.
+    # Objects that are not cached are built in a temporary directory, which is removed after linking,
+    # so that no objects are left next to the sources, e.g. in the directory of --generate-many.
+    build_dir = None
+    if len(args.source) > 1 or args.cache:
+        if not args.cache:
+            build_dir = tempfile.TemporaryDirectory()
+        objects = {}
+        for f in args.source:
+            if args.cache:
+                objects[f] = cached_object(f)
+            else:
+                objects[f] = pathlib.Path(build_dir.name) / f.with_suffix(objext).name
+
+        def compile_object(f):
+            if args.cache and objects[f].exists():
+                if args.verbose:
+                    sys.stderr.write("Reusing cached object {} for {}\n".format(objects[f], f))
+                return None
+            # objects of the cache are renamed once complete, so concurrent builds never see a partial one
+            if args.cache:
+                fd, target = tempfile.mkstemp(suffix=objext, dir=args.cache)
+                os.close(fd)
+            else:
+                target = objects[f]
+            objcmd = list(cmd)
+            objcmd.append("/c" if is_msvc else "-c")
+            objcmd.append(("/Fo:{}" if is_msvc else "-o {}").format(target))
+            objcmd.append(str(f))
+            objcmd = " ".join(objcmd)
+            if args.verbose:
+                sys.stderr.write(objcmd + "\n")
+            status = subprocess.run(objcmd, capture_output=True, text=True, shell=True)
+            if args.cache:
+                if status.returncode == 0:
+                    os.replace(target, objects[f])
+                else:
+                    os.remove(target)
+            return status
+
+        sources = sorted(args.source, key=lambda f: f.stat().st_size, reverse=True)
+        with concurrent.futures.ThreadPoolExecutor(max_workers=args.jobs) as executor:
+            statuses = list(executor.map(compile_object, sources))
+        # every translation unit that failed is reported, not only the first one
+        failures = [(f, status) for f, status in zip(sources, statuses) if status and status.returncode != 0]
+        for f, status in failures:
+            sys.stdout.write(status.stdout)
+            sys.stderr.write(status.stderr)
+            sys.stderr.write("Error: compilation of {} failed\n".format(f))
+        if failures:
+            if build_dir:
+                build_dir.cleanup()
+            os.sys.exit(failures[0][1].returncode)
+        inputs = [str(objects[f]) for f in args.source]
+    else:
+        inputs = [str(f) for f in args.source]
+
     cmd.append(OUTNAME_FMT.format(exepath))
-    for f in args.source:
-        cmd.append(str(f))
+    cmd.extend(inputs)
 
     cmd.append(conf['link_options'])
     cmd.extend(list(map(lambda rpath: RPATH_FMT.format(rpath), RPATHS)))
@@ -218,4 +317,7 @@ else:
         sys.stdout.write(status.stdout)
         sys.stderr.write(status.stderr)
 
+    if build_dir:
+        build_dir.cleanup()
+
     os.sys.exit(status.returncode)
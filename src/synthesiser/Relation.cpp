@@ -59,6 +59,9 @@ Own<Relation> Relation::getSynthesiserRelation(
         rel = new DirectRelation(ramRel, indexSelection, false, true);
     } else if (ramRel.getRepresentation() == RelationRepresentation::BRIE) {
         rel = new BrieRelation(ramRel, indexSelection);
+    } else if (ramRel.getRepresentation() == RelationRepresentation::HASHSET &&
+               HashRelation::isSupported(indexSelection)) {
+        rel = new HashRelation(ramRel, indexSelection);
     } else if (ramRel.getRepresentation() == RelationRepresentation::EQREL) {
         rel = new EqrelRelation(ramRel, indexSelection);
     } else if (ramRel.getRepresentation() == RelationRepresentation::INFO) {
@@ -1297,6 +1300,246 @@ void BrieRelation::generateTypeStruct(GenDb& db) {
     decl << "};\n";
 }
 
+// -------- Hash Relation --------
+
+/** Check whether all searches of a relation can be answered by hash indexes */
+bool HashRelation::isSupported(const ram::analysis::IndexCluster& indexSelection) {
+    for (auto& search : indexSelection.getSearches()) {
+        for (std::size_t i = 0; i < search.arity(); i++) {
+            if (search[i] == analysis::AttributeConstraint::Inequal) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/** Get the columns of a search that are bound by equality */
+LexOrder HashRelation::getKeyColumns(const SearchSignature& search) {
+    LexOrder key;
+    for (std::size_t i = 0; i < search.arity(); i++) {
+        if (search[i] == analysis::AttributeConstraint::Equal) {
+            key.push_back(i);
+        }
+    }
+    return key;
+}
+
+/** Generate index set for a hash relation */
+void HashRelation::computeIndices() {
+    // the master index is a hash set over all columns
+    LexOrder full;
+    for (std::size_t i = 0; i < getArity(); i++) {
+        full.push_back(i);
+    }
+    computedIndices = {full};
+    masterIndex = 0;
+
+    // add a hash index for the key columns of each partial search
+    for (auto& search : indexSelection.getSearches()) {
+        auto key = getKeyColumns(search);
+        if (!key.empty() &&
+                std::find(computedIndices.begin(), computedIndices.end(), key) == computedIndices.end()) {
+            computedIndices.push_back(key);
+        }
+    }
+}
+
+/** Generate type name of a hash relation */
+std::string HashRelation::getTypeNamespace() {
+    std::unordered_set<std::size_t> attributesUsed;
+    for (std::size_t i = 0; i < getArity(); i++) {
+        attributesUsed.insert(i);
+    }
+
+    std::stringstream res;
+    res << "t_hash_" << getTypeAttributeString(relation.getAttributeTypes(), attributesUsed);
+
+    for (auto& ind : getIndices()) {
+        res << "__" << join(ind, "_");
+    }
+
+    for (auto& search : indexSelection.getSearches()) {
+        res << "__" << search;
+    }
+
+    return res.str();
+}
+
+std::string HashRelation::getTypeName() {
+    return getTypeNamespace() + "::Type";
+}
+
+/** Generate type struct of a hash relation */
+void HashRelation::generateTypeStruct(GenDb& db) {
+    std::size_t arity = getArity();
+    const auto& inds = getIndices();
+    std::size_t numIndexes = inds.size();
+
+    fs::path basename(uniqueCppIdent(getTypeNamespace(), 20));
+    GenDatastructure& cl = db.getDatastructure("Type", basename, std::make_optional(getTypeNamespace()));
+    std::ostream& decl = cl.decl();
+    std::ostream& def = cl.def();
+    cl.addInclude("\"souffle/SouffleInterface.h\"");
+    cl.addInclude("\"souffle/datastructure/HashIndex.h\"");
+
+    // struct definition
+    decl << "struct Type {\n";
+    decl << "static constexpr Relation::arity_type Arity = " << arity << ";\n";
+    decl << "using t_tuple = Tuple<RamDomain, " << arity << ">;\n";
+
+    // define the hash indexes, the master index being the only set
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        decl << "using t_ind_" << i << " = HashIndex<t_tuple, " << (i == masterIndex ? "true" : "false")
+             << ", " << join(inds[i], ", ") << ">;\n";
+        decl << "t_ind_" << i << " ind_" << i << ";\n";
+        def << "using t_ind_" << i << " = Type::t_ind_" << i << ";\n";
+    }
+    decl << "using iterator = t_ind_" << masterIndex << "::iterator;\n";
+    def << "using iterator = Type::iterator;\n";
+
+    // hash indexes do not need any hints
+    decl << "struct context {};\n";
+    def << "using context = Type::context;\n";
+    decl << "context createContext() { return context(); }\n";
+
+    // insert methods
+    decl << "bool insert(const t_tuple& t);\n";
+    def << "bool Type::insert(const t_tuple& t) {\n";
+    def << "if (ind_" << masterIndex << ".insert(t)) {\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        if (i != masterIndex) {
+            def << "ind_" << i << ".insert(t);\n";
+        }
+    }
+    def << "return true;\n";
+    def << "} else return false;\n";
+    def << "}\n";
+
+    decl << "bool insert(const t_tuple& t, context& h);\n";
+    def << "bool Type::insert(const t_tuple& t, context& /* h */) {\n";
+    def << "return insert(t);\n";
+    def << "}\n";
+
+    decl << "bool insert(const RamDomain* ramDomain);\n";
+    def << "bool Type::insert(const RamDomain* ramDomain) {\n";
+    def << "RamDomain data[" << arity << "];\n";
+    def << "std::copy(ramDomain, ramDomain + " << arity << ", data);\n";
+    def << "const t_tuple& tuple = reinterpret_cast<const t_tuple&>(data);\n";
+    def << "return insert(tuple);\n";
+    def << "}\n";
+
+    std::vector<std::string> decls;
+    std::vector<std::string> params;
+    for (std::size_t i = 0; i < arity; i++) {
+        decls.push_back("RamDomain a" + std::to_string(i));
+        params.push_back("a" + std::to_string(i));
+    }
+    decl << "bool insert(" << join(decls, ",") << ");\n";
+    def << "bool Type::insert(" << join(decls, ",") << ") {\n";
+    def << "RamDomain data[" << arity << "] = {" << join(params, ",") << "};\n";
+    def << "return insert(data);\n";
+    def << "}\n";
+
+    // contains methods
+    decl << "bool contains(const t_tuple& t, context& h) const;\n";
+    def << "bool Type::contains(const t_tuple& t, context& /* h */) const {\n";
+    def << "return ind_" << masterIndex << ".contains(t);\n";
+    def << "}\n";
+
+    decl << "bool contains(const t_tuple& t) const;\n";
+    def << "bool Type::contains(const t_tuple& t) const {\n";
+    def << "return ind_" << masterIndex << ".contains(t);\n";
+    def << "}\n";
+
+    // size method
+    decl << "std::size_t size() const;\n";
+    def << "std::size_t Type::size() const {\n";
+    def << "return ind_" << masterIndex << ".size();\n";
+    def << "}\n";
+
+    // empty lowerUpperRange method
+    decl << "range<iterator> lowerUpperRange_" << SearchSignature(arity)
+         << "(const t_tuple& /* lower */, const t_tuple& /* upper */, context& /* h */) const;\n";
+    def << "range<iterator> Type::lowerUpperRange_" << SearchSignature(arity)
+        << "(const t_tuple& /* lower */, const t_tuple& /* upper */, context& /* h */) const {\n";
+    def << "return range<iterator>(ind_" << masterIndex << ".begin(),ind_" << masterIndex << ".end());\n";
+    def << "}\n";
+
+    decl << "range<iterator> lowerUpperRange_" << SearchSignature(arity)
+         << "(const t_tuple& /* lower */, const t_tuple& /* upper */) const;\n";
+    def << "range<iterator> Type::lowerUpperRange_" << SearchSignature(arity)
+        << "(const t_tuple& /* lower */, const t_tuple& /* upper */) const {\n";
+    def << "return range<iterator>(ind_" << masterIndex << ".begin(),ind_" << masterIndex << ".end());\n";
+    def << "}\n";
+
+    // lowerUpperRange methods, looking up the bound columns of lower in the index of the search
+    for (auto search : indexSelection.getSearches()) {
+        auto key = getKeyColumns(search);
+        std::size_t indNum = masterIndex;
+        if (key.size() != arity) {
+            indNum = static_cast<std::size_t>(std::find(inds.begin(), inds.end(), key) - inds.begin());
+        }
+
+        decl << "range<t_ind_" << indNum << "::chain_iterator> lowerUpperRange_" << search;
+        decl << "(const t_tuple& lower, const t_tuple& upper, context& h) const;\n";
+        def << "range<t_ind_" << indNum << "::chain_iterator> Type::lowerUpperRange_" << search;
+        def << "(const t_tuple& lower, const t_tuple& /* upper */, context& /* h */) const {\n";
+        def << "return ind_" << indNum << ".equalRange(lower);\n";
+        def << "}\n";
+
+        decl << "range<t_ind_" << indNum << "::chain_iterator> lowerUpperRange_" << search;
+        decl << "(const t_tuple& lower, const t_tuple& upper) const;\n";
+        def << "range<t_ind_" << indNum << "::chain_iterator> Type::lowerUpperRange_" << search;
+        def << "(const t_tuple& lower, const t_tuple& /* upper */) const {\n";
+        def << "return ind_" << indNum << ".equalRange(lower);\n";
+        def << "}\n";
+    }
+
+    // empty method
+    decl << "bool empty() const;\n";
+    def << "bool Type::empty() const {\n";
+    def << "return ind_" << masterIndex << ".empty();\n";
+    def << "}\n";
+
+    // partition method for parallelism
+    decl << "std::vector<range<iterator>> partition() const;\n";
+    def << "std::vector<range<iterator>> Type::partition() const {\n";
+    def << "return ind_" << masterIndex << ".partition(400);\n";
+    def << "}\n";
+
+    // purge method
+    decl << "void purge();\n";
+    def << "void Type::purge() {\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        def << "ind_" << i << ".clear();\n";
+    }
+    def << "}\n";
+
+    // begin and end iterators
+    decl << "iterator begin() const;\n";
+    def << "iterator Type::begin() const {\n";
+    def << "return ind_" << masterIndex << ".begin();\n";
+    def << "}\n";
+
+    decl << "iterator end() const;\n";
+    def << "iterator Type::end() const {\n";
+    def << "return ind_" << masterIndex << ".end();\n";
+    def << "}\n";
+
+    // printStatistics method
+    decl << "void printStatistics(std::ostream& o) const;\n";
+    def << "void Type::printStatistics(std::ostream& o) const {\n";
+    for (std::size_t i = 0; i < numIndexes; i++) {
+        def << "o << \" arity " << arity << " hash index " << i << " key " << inds[i] << "\\n\";\n";
+        def << "ind_" << i << ".printStats(o);\n";
+    }
+    def << "}\n";
+
+    // end struct
+    decl << "};\n";
+}
+
 // -------- Eqrel Relation --------
 
 /** Generate index set for a eqrel relation, which should be empty */
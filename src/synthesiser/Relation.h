@@ -150,6 +150,24 @@ public:
     void generateTypeStruct(GenDb& db) override;
 };
 
+class HashRelation : public Relation {
+public:
+    HashRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection)
+            : Relation(ramRel, indexSelection) {}
+
+    /** Check whether all searches of a relation can be answered by hash indexes */
+    static bool isSupported(const ram::analysis::IndexCluster& indexSelection);
+
+    void computeIndices() override;
+    std::string getTypeNamespace();
+    std::string getTypeName() override;
+    void generateTypeStruct(GenDb& db) override;
+
+private:
+    /** Get the columns of a search that are bound by equality */
+    static ram::analysis::LexOrder getKeyColumns(const ram::analysis::SearchSignature& search);
+};
+
 class EqrelRelation : public Relation {
 public:
     EqrelRelation(const ram::Relation& ramRel, const ram::analysis::IndexCluster& indexSelection)
@@ -88,6 +88,7 @@
 #include "ram/UserDefinedAggregator.h"
 #include "ram/UserDefinedOperator.h"
 #include "ram/analysis/Index.h"
+#include "ram/analysis/StratumDependency.h"
 #include "ram/utility/Utils.h"
 #include "ram/utility/Visitor.h"
 #include "souffle/BinaryConstraintOps.h"
@@ -96,6 +97,7 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/FileUtil.h"
 #include "souffle/utility/MiscUtil.h"
+#include "souffle/utility/RegexUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include "souffle/utility/StringUtil.h"
 #include "souffle/utility/json11.h"
@@ -122,6 +124,7 @@ namespace souffle::synthesiser {
 
 using json11::Json;
 using ram::analysis::IndexAnalysis;
+using ram::analysis::StratumDependencyAnalysis;
 using namespace ram;
 using namespace stream_write_qualified_char_as_number;
 
@@ -216,7 +219,7 @@ std::optional<std::size_t> Synthesiser::compileRegex(const std::string& pattern)
         return i->second;
     }
     try {
-        const std::regex regex(pattern);
+        const RegexMatcher regex(pattern);
         std::size_t index = regexes.size();
         return regexes.emplace(pattern, index).first->second;
     } catch (const std::exception&) {
@@ -1863,19 +1866,19 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     if (const StringConstant* str = dynamic_cast<const StringConstant*>(&rel.getLHS()); str) {
                         const auto& regex = synthesiser.compileRegex(str->getConstant());
                         if (regex) {
-                            out << "std::regex_match(symTable.decode(";
+                            out << "regexes.at(" << *regex << ").match(";
                             dispatch(rel.getRHS(), out);
-                            out << "), regexes.at(" << *regex << "))";
+                            out << ", symTable)";
                         } else {
                             out << "false";
                         }
                     } else {
                         synthesiser.SubroutineUsingStdRegex = true;
-                        out << "regex_wrapper(symTable.decode(";
+                        out << "regex_wrapper(";
                         dispatch(rel.getLHS(), out);
-                        out << "),symTable.decode(";
+                        out << ",";
                         dispatch(rel.getRHS(), out);
-                        out << "))";
+                        out << ")";
                     }
                     break;
                 }
@@ -1883,19 +1886,19 @@ void Synthesiser::emitCode(std::ostream& out, const Statement& stmt) {
                     if (const StringConstant* str = dynamic_cast<const StringConstant*>(&rel.getLHS()); str) {
                         const auto& regex = synthesiser.compileRegex(str->getConstant());
                         if (regex) {
-                            out << "!std::regex_match(symTable.decode(";
+                            out << "!regexes.at(" << *regex << ").match(";
                             dispatch(rel.getRHS(), out);
-                            out << "), regexes.at(" << *regex << "))";
+                            out << ", symTable)";
                         } else {
                             out << "false";
                         }
                     } else {
                         synthesiser.SubroutineUsingStdRegex = true;
-                        out << "!regex_wrapper(symTable.decode(";
+                        out << "!regex_wrapper(";
                         dispatch(rel.getLHS(), out);
-                        out << "),symTable.decode(";
+                        out << ",";
                         dispatch(rel.getRHS(), out);
-                        out << "))";
+                        out << ")";
                     }
                     break;
                 }
@@ -2675,7 +2678,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         std::vector<std::tuple<Mode, std::string /*name*/, std::string /*type*/>> args;
         args.push_back(std::make_tuple(Reference, "symTable", "SymbolTable"));
         args.push_back(std::make_tuple(Reference, "recordTable", "RecordTable"));
-        args.push_back(std::make_tuple(Reference, "regexCache", "ConcurrentCache<std::string,std::regex>"));
+        args.push_back(std::make_tuple(Reference, "regexCache", "ConcurrentCache<RamDomain,RegexMatcher>"));
         args.push_back(std::make_tuple(Reference, "pruneImdtRels", "bool"));
         args.push_back(std::make_tuple(Reference, "performIO", "bool"));
         args.push_back(std::make_tuple(Reference, "signalHandler", "SignalHandler*"));
@@ -2735,21 +2738,22 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
             // regex wrapper
             GenFunction& wrapper = gen.addFunction("regex_wrapper", Visibility::Private);
             wrapper.setRetType("inline bool");
-            wrapper.setNextArg("const std::string&", "pattern");
-            wrapper.setNextArg("const std::string&", "text");
+            wrapper.setNextArg("RamDomain", "pattern");
+            wrapper.setNextArg("RamDomain", "text");
             wrapper.body()
                     << "   bool result = false; \n"
-                    << "   try { result = std::regex_match(text, regexCache.getOrCreate(pattern)); } "
-                       "catch(...) { "
-                       "\n"
-                    << "     std::cerr << \"warning: wrong pattern provided for match(\\\"\" << pattern << "
-                       "\"\\\",\\\"\" "
-                       "<< text << \"\\\").\\n\";\n}\n"
+                    << "   try {\n"
+                    << "     auto create = [&](RamDomain p) { return RegexMatcher(symTable.decode(p)); };\n"
+                    << "     result = regexCache.getOrCreate(pattern, create).match(text, symTable);\n"
+                    << "   } catch(...) { \n"
+                    << "     std::cerr << \"warning: wrong pattern provided for match(\\\"\" << "
+                       "symTable.decode(pattern) << \"\\\",\\\"\" "
+                       "<< symTable.decode(text) << \"\\\").\\n\";\n}\n"
                     << "   return result;\n";
         }
 
         if (!regexes.empty()) {
-            gen.addField("std::vector<std::regex>", "regexes", Visibility::Private);
+            gen.addField("std::vector<RegexMatcher>", "regexes", Visibility::Private);
             std::stringstream rst;
             // we need to collect the patterns first and place each
             // one into the correct slot
@@ -2761,7 +2765,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
             rst << "{\n";
             for (const auto& p : patterns) {
                 const std::string escaped = escape(p);
-                rst << "\tstd::regex(\"" << escaped << "\"),\n";
+                rst << "\tRegexMatcher(\"" << escaped << "\"),\n";
             }
             rst << "}";
 
@@ -2819,7 +2823,7 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
     mainClass.addField(rt.str(), "recordTable", Visibility::Private);
     constructor.setNextInitializer("recordTable", "");
 
-    mainClass.addField("ConcurrentCache<std::string,std::regex>", "regexCache", Visibility::Private);
+    mainClass.addField("ConcurrentCache<RamDomain,RegexMatcher>", "regexCache", Visibility::Private);
     constructor.setNextInitializer("regexCache", "");
 
     if (glb.config().has("profile")) {
@@ -2855,7 +2859,13 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
         // defining table
         mainClass.addField("Own<" + type + ">", cppName, Visibility::Private);
         constructor.setNextInitializer(cppName, "mk<" + type + ">()");
-        if (!rel->isTemp()) {
+
+        // staging relations of input relations are accessible via the interface for incremental updates
+        auto isStaging = [&](const std::string& prefix) {
+            return glb.config().has("incremental") && isPrefix(prefix, datalogName) &&
+                   contains(loadRelations, datalogName.substr(prefix.size()));
+        };
+        if (!rel->isTemp() || isStaging("@insert_") || isStaging("@erase_")) {
             std::stringstream ty, init, wrapper_name;
             ty << "souffle::RelationWrapper<" << type << ">";
             wrapper_name << "wrapper_" << cppName;
@@ -2959,7 +2969,29 @@ void Synthesiser::generateCode(GenDb& db, const std::string& id, bool& withShare
 
     // emit code
     currentClass = &mainClass;
-    emitCode(runFunction.body(), prog.getMain());
+    const bool parallelStrata = glb.config().has("parallel-strata") && !glb.config().has("profile") &&
+                                translationUnit.getAnalysis<StratumDependencyAnalysis>().isSchedulable();
+    if (parallelStrata) {
+        // evaluate independent strata concurrently along the stratum dependencies
+        const auto& strata = translationUnit.getAnalysis<StratumDependencyAnalysis>();
+        const auto& calls = strata.getCalls();
+        runFunction.body() << "static const std::vector<std::vector<std::size_t>> stratumPredecessors = {";
+        runFunction.body() << join(strata.getPredecessors(), ",", [](auto& out, const auto& preds) {
+            out << "{" << join(preds, ",") << "}";
+        });
+        runFunction.body() << "};\n";
+        runFunction.body() << "runTaskGraph(stratumPredecessors, [&](std::size_t stratum) {\n"
+                           << "std::vector<RamDomain> args, ret;\n"
+                           << "switch (stratum) {\n";
+        for (std::size_t i = 0; i < calls.size(); ++i) {
+            runFunction.body() << "case " << i << ": " << convertStratumIdent(calls[i])
+                               << ".run(args, ret); break;\n";
+        }
+        runFunction.body() << "}\n"
+                           << "});\n";
+    } else {
+        emitCode(runFunction.body(), prog.getMain());
+    }
 
     if (glb.config().has("profile")) {
         runFunction.body() << "}\n"
@@ -29,7 +29,6 @@
 #include <map>
 #include <memory>
 #include <ostream>
-#include <regex>
 #include <set>
 #include <string>
 
@@ -69,10 +68,10 @@ private:
     /** Symbol map */
     mutable std::vector<std::string> symbolIndex;
 
-    /** Is set to true if there is a need to include std::regex */
+    /** Is set to true if there is a need for the regex wrapper */
     bool UsingStdRegex = false;
 
-    /** Is set to true if the current subroutine uses std::regex */
+    /** Is set to true if the current subroutine uses the regex wrapper */
     bool SubroutineUsingStdRegex = false;
     bool SubroutineUsingSubstr = false;
 
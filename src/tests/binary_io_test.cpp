@@ -0,0 +1,176 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file binary_io_test.cpp
+ *
+ * Tests the columnar binary fact format.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/ReadStreamBinary.h"
+#include "souffle/io/WriteStreamBinary.h"
+#include <cstddef>
+#include <cstdio>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+/** A relation storing its tuples in insertion order */
+struct TupleList {
+    explicit TupleList(std::size_t arity) : arity(arity) {}
+
+    void insert(const RamDomain* tuple) {
+        tuples.emplace_back(tuple, tuple + arity);
+    }
+
+    std::size_t size() const {
+        return tuples.size();
+    }
+
+    auto begin() const {
+        return tuples.begin();
+    }
+
+    auto end() const {
+        return tuples.end();
+    }
+
+    std::size_t arity;
+    std::vector<std::vector<RamDomain>> tuples;
+};
+
+static std::map<std::string, std::string> getOperation(
+        const std::string& name, const std::string& types, std::size_t arity) {
+    const std::string relation = "{\"arity\": " + std::to_string(arity) + ", \"types\": " + types + "}";
+    return {{"IO", "binary"}, {"name", name}, {"fact-dir", "."}, {"output-dir", "."},
+            {"types", "{\"relation\": " + relation + "}"}};
+}
+
+static void removeFiles(const std::string& name) {
+    std::remove(("./" + name + ".bin").c_str());
+    std::remove(("./" + name + ".bin.symbols").c_str());
+}
+
+TEST(BinaryIO, RoundTrip) {
+    const std::string name = "binary_io_test_round_trip";
+    const auto operation = getOperation(name, "[\"i:number\", \"s:symbol\", \"f:float\"]", 3);
+
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    TupleList written(3);
+    for (RamDomain i = 0; i < 10000; ++i) {
+        RamDomain tuple[3] = {i - 5000, symbols.encode("symbol " + std::to_string(i % 7)),
+                ramBitCast(static_cast<RamFloat>(i) / 4)};
+        written.insert(tuple);
+    }
+    WriteFileBinaryFactory().getWriter(operation, symbols, records)->writeAll(written);
+
+    // load into a fresh symbol table, so that symbols are re-encoded
+    SymbolTableImpl loadedSymbols;
+    loadedSymbols.encode("unrelated");
+    TupleList loaded(3);
+    ReadFileBinaryFactory().getReader(operation, loadedSymbols, records)->readAll(loaded);
+    removeFiles(name);
+
+    EXPECT_EQ(written.size(), loaded.size());
+    for (std::size_t i = 0; i < written.size() && i < loaded.size(); ++i) {
+        EXPECT_EQ(written.tuples[i][0], loaded.tuples[i][0]);
+        EXPECT_EQ(symbols.decode(written.tuples[i][1]), loadedSymbols.decode(loaded.tuples[i][1]));
+        EXPECT_EQ(written.tuples[i][2], loaded.tuples[i][2]);
+    }
+}
+
+TEST(BinaryIO, Nullary) {
+    const std::string name = "binary_io_test_nullary";
+    const auto operation = getOperation(name, "[]", 0);
+
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    TupleList written(0);
+    written.insert(nullptr);
+    WriteFileBinaryFactory().getWriter(operation, symbols, records)->writeAll(written);
+
+    TupleList loaded(0);
+    ReadFileBinaryFactory().getReader(operation, symbols, records)->readAll(loaded);
+    removeFiles(name);
+
+    EXPECT_EQ(1, loaded.size());
+}
+
+TEST(BinaryIO, Unwritable) {
+    const std::string name = "binary_io_test_unwritable";
+    auto operation = getOperation(name, "[\"i:number\"]", 1);
+    operation["output-dir"] = "./binary_io_test_missing_directory";
+
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    TupleList written(1);
+    RamDomain tuple[1] = {1};
+    written.insert(tuple);
+    bool failed = false;
+    try {
+        WriteFileBinaryFactory().getWriter(operation, symbols, records)->writeAll(written);
+    } catch (const std::runtime_error&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+TEST(BinaryIO, Mismatch) {
+    const std::string name = "binary_io_test_mismatch";
+
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    TupleList written(2);
+    RamDomain tuple[2] = {1, 2};
+    written.insert(tuple);
+    WriteFileBinaryFactory()
+            .getWriter(getOperation(name, "[\"i:number\", \"i:number\"]", 2), symbols, records)
+            ->writeAll(written);
+
+    // wrong arity
+    bool failed = false;
+    try {
+        ReadFileBinaryFactory().getReader(getOperation(name, "[\"i:number\"]", 1), symbols, records);
+    } catch (const std::invalid_argument&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // wrong column type
+    failed = false;
+    try {
+        ReadFileBinaryFactory().getReader(
+                getOperation(name, "[\"i:number\", \"u:unsigned\"]", 2), symbols, records);
+    } catch (const std::invalid_argument&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+    removeFiles(name);
+
+    // missing file
+    failed = false;
+    try {
+        ReadFileBinaryFactory().getReader(getOperation(name, "[\"i:number\"]", 1), symbols, records);
+    } catch (const std::invalid_argument&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+}
+
+}  // namespace souffle::test
@@ -26,6 +26,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <iterator>
 #include <limits>
 #include <random>
 #include <set>
@@ -1690,6 +1691,29 @@ TEST(Trie, Size) {
     EXPECT_EQ(5, t.size());
 }
 
+TEST(Trie, BulkInsert) {
+    using entry_type = Trie<3>::entry_type;
+
+    std::mt19937 rand(42);
+    std::uniform_int_distribution<RamDomain> dist(0, 20);
+
+    Trie<3> t;
+    std::set<entry_type> ref;
+    for (std::size_t batch : {0, 1000, 10, 5000}) {
+        std::vector<entry_type> entries;
+        for (std::size_t i = 0; i < batch; i++) {
+            entries.push_back({dist(rand), dist(rand), dist(rand)});
+        }
+        ref.insert(entries.begin(), entries.end());
+        t.bulkInsert(entries);
+
+        EXPECT_EQ(ref.size(), t.size());
+        for (const auto& entry : ref) {
+            EXPECT_TRUE(t.contains(entry));
+        }
+    }
+}
+
 TEST(Trie, Limits) {
     Trie<2> data;
 
@@ -1717,6 +1741,29 @@ TEST(Trie, Limits) {
     EXPECT_EQ(2, counter);
 }
 
+TEST(Trie, Negative) {
+    Trie<2> data;
+    for (RamDomain i = -3; i < 3; ++i) {
+        for (RamDomain j = 0; j < 3; ++j) {
+            data.insert({i, j});
+        }
+    }
+    EXPECT_EQ(18, data.size());
+
+    for (RamDomain i = -3; i < 3; ++i) {
+        EXPECT_TRUE(data.contains({i, 2}));
+        auto range = data.getBoundaries<1>({i, 0});
+        EXPECT_EQ(3, std::distance(range.begin(), range.end()));
+    }
+    EXPECT_FALSE(data.contains({-4, 0}));
+
+    int counter = 0;
+    for (auto it = data.begin(); it != data.end(); ++it) {
+        counter++;
+    }
+    EXPECT_EQ(18, counter);
+}
+
 TEST(Trie, Parallel) {
     const int N = 10000;
 
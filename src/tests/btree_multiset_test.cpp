@@ -365,6 +365,28 @@ TEST(BTreeMultiSet, Load) {
     }
 }
 
+TEST(BTreeMultiSet, BulkInsert) {
+    using test_set = btree_multiset<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    std::mt19937 rand(42);
+    std::uniform_int_distribution<int> dist(0, 4000);
+
+    test_set t;
+    std::multiset<int> ref;
+    for (std::size_t batch : {0, 1000, 10, 5000, 3, 20000}) {
+        std::vector<int> keys;
+        for (std::size_t i = 0; i < batch; i++) {
+            keys.push_back(dist(rand));
+        }
+        ref.insert(keys.begin(), keys.end());
+        t.bulkInsert(keys);
+
+        EXPECT_EQ(ref.size(), t.size());
+        EXPECT_TRUE(t.check());
+        EXPECT_TRUE(std::equal(ref.begin(), ref.end(), t.begin()));
+    }
+}
+
 TEST(BTreeMultiSet, Clear) {
     using test_set = btree_multiset<int, detail::comparator<int>, std::allocator<int>, 16>;
 
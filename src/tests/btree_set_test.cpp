@@ -20,7 +20,9 @@
 #include "souffle/utility/ContainerUtil.h"
 #include "souffle/utility/StreamUtil.h"
 #include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iomanip>
@@ -55,6 +57,30 @@ std::ostream& operator<<(std::ostream& out, const tuple<A, B>& t) {
 }
 }  // namespace std
 
+namespace souffle {
+namespace test {
+
+/** Orders pairs by their second column first */
+struct SecondColumnFirst {
+    using Pair = std::array<std::int32_t, 2>;
+    int operator()(const Pair& a, const Pair& b) const {
+        return less(a, b) ? -1 : (less(b, a) ? 1 : 0);
+    }
+    bool less(const Pair& a, const Pair& b) const {
+        return a[1] < b[1] || (a[1] == b[1] && a[0] < b[0]);
+    }
+    bool equal(const Pair& a, const Pair& b) const {
+        return a == b;
+    }
+};
+
+}  // namespace test
+
+template <>
+struct detail::leading_column<test::SecondColumnFirst> : std::integral_constant<int, 1> {};
+
+}  // namespace souffle
+
 namespace souffle::test {
 
 TEST(BTreeSet, Basic) {
@@ -484,6 +510,100 @@ TEST(BTreeSet, Load) {
     }
 }
 
+TEST(BTreeSet, LoadFull) {
+    using test_set = btree_set<int>;
+
+    std::vector<int> data;
+    for (int i = 0; i < 100000; i++) {
+        data.push_back(i);
+    }
+
+    auto t = test_set::load(data.begin(), data.end());
+    EXPECT_EQ(data.size(), t.size());
+    EXPECT_TRUE(t.check());
+
+    // all nodes but those on the right-most path are full
+    EXPECT_LT(t.getNumNodes() * test_set::max_keys_per_node, data.size() + 4 * test_set::max_keys_per_node);
+}
+
+TEST(BTreeSet, BulkInsert) {
+    using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
+
+    std::mt19937 rand(42);
+    std::uniform_int_distribution<int> dist(0, 4000);
+
+    test_set t;
+    std::set<int> ref;
+    for (std::size_t batch : {0, 1000, 10, 5000, 3, 20000}) {
+        std::vector<int> keys;
+        for (std::size_t i = 0; i < batch; i++) {
+            keys.push_back(dist(rand));
+        }
+        ref.insert(keys.begin(), keys.end());
+        t.bulkInsert(keys);
+
+        EXPECT_EQ(ref.size(), t.size());
+        EXPECT_TRUE(t.check());
+        EXPECT_TRUE(std::equal(ref.begin(), ref.end(), t.begin()));
+    }
+}
+
+TEST(BTreeSet, SimdSearch) {
+    using Pair = SecondColumnFirst::Pair;
+    using test_set = btree_set<Pair, SecondColumnFirst>;
+
+    std::mt19937 rand(42);
+    std::uniform_int_distribution<std::int32_t> dist(-50, 50);
+
+    SecondColumnFirst comp;
+    std::vector<Pair> keys;
+    for (std::size_t i = 0; i < 1000; i++) {
+        keys.push_back({dist(rand), dist(rand)});
+    }
+    std::sort(keys.begin(), keys.end(), [&](const Pair& a, const Pair& b) { return comp.less(a, b); });
+
+    // the leading column narrows the range, which is then searched by binary search
+    detail::simd_search simd;
+    detail::binary_search binary;
+    const Pair* a = keys.data();
+    const Pair* b = keys.data() + keys.size();
+    for (std::int32_t x = -52; x <= 52; x += 3) {
+        for (std::int32_t y = -52; y <= 52; y++) {
+            Pair key{x, y};
+            EXPECT_EQ(binary.lower_bound(key, a, b, comp), simd.lower_bound(key, a, b, comp));
+            EXPECT_EQ(binary.upper_bound(key, a, b, comp), simd.upper_bound(key, a, b, comp));
+        }
+    }
+
+    // on hosts supporting AVX2, the keys compared 8 at a time are counted as if one at a time
+    const auto* column = reinterpret_cast<const std::int32_t*>(keys.data()) + 1;
+    for (std::int32_t y = -52; y <= 52 && detail::host_avx2; y++) {
+        for (std::size_t n : {std::size_t(0), std::size_t(7), std::size_t(31), keys.size()}) {
+            std::size_t less = 0;
+            std::size_t greater = 0;
+            detail::count_column(true, column, n, 2, y, less, greater);
+            std::size_t expectedLess = 0;
+            std::size_t expectedGreater = 0;
+            detail::count_column(false, column, n, 2, y, expectedLess, expectedGreater);
+            EXPECT_EQ(expectedLess, less);
+            EXPECT_EQ(expectedGreater, greater);
+        }
+    }
+
+    test_set t;
+    std::set<Pair> ref;
+    for (const auto& key : keys) {
+        t.insert(key);
+        ref.insert(key);
+    }
+    EXPECT_EQ(ref.size(), t.size());
+    EXPECT_TRUE(t.check());
+    for (const auto& key : keys) {
+        EXPECT_TRUE(t.contains(key));
+    }
+    EXPECT_FALSE(t.contains({0, 51}));
+}
+
 TEST(BTreeSet, Clear) {
     using test_set = btree_set<int, detail::comparator<int>, std::allocator<int>, 16>;
 
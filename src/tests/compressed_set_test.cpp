@@ -0,0 +1,140 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file compressed_set_test.cpp
+ *
+ * A test case testing the set with compressed leaves.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/CompressedSet.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <array>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using t_tuple = std::array<RamDomain, 3>;
+using t_set = CompressedSet<t_tuple>;
+
+TEST(CompressedSet, Basic) {
+    t_set set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.begin(), set.end());
+
+    EXPECT_TRUE(set.insert({1, 2, 3}));
+    EXPECT_TRUE(set.insert({1, -2, 3}));
+    EXPECT_FALSE(set.insert({1, 2, 3}));
+    EXPECT_EQ(2, set.size());
+
+    set.compact();
+    EXPECT_FALSE(set.insert({1, 2, 3}));
+    EXPECT_TRUE(set.insert({0, 0, 0}));
+    EXPECT_EQ(3, set.size());
+
+    EXPECT_TRUE(set.contains({1, 2, 3}));
+    EXPECT_TRUE(set.contains({0, 0, 0}));
+    EXPECT_FALSE(set.contains({1, 2, 4}));
+
+    std::vector<t_tuple> all(set.begin(), set.end());
+    EXPECT_EQ((std::vector<t_tuple>{{0, 0, 0}, {1, -2, 3}, {1, 2, 3}}), all);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains({1, 2, 3}));
+    EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(CompressedSet, Encoding) {
+    // extreme values and large deltas of all columns
+    const RamDomain min = std::numeric_limits<RamDomain>::min();
+    const RamDomain max = std::numeric_limits<RamDomain>::max();
+    std::set<t_tuple> ref = {{min, min, min}, {min, max, 0}, {-1, -1, max}, {0, min, -1}, {0, 0, 0},
+            {0, 0, 1}, {max, min, max}, {max, max, max}};
+
+    t_set set;
+    std::vector<t_tuple> keys(ref.begin(), ref.end());
+    set.bulkInsert(keys);
+    EXPECT_EQ(ref.size(), set.size());
+    EXPECT_EQ(std::vector<t_tuple>(ref.begin(), ref.end()), std::vector<t_tuple>(set.begin(), set.end()));
+    for (const auto& key : ref) {
+        EXPECT_TRUE(set.contains(key));
+    }
+}
+
+TEST(CompressedSet, Bounds) {
+    std::mt19937 rnd(7);
+    std::uniform_int_distribution<RamDomain> dist(-50, 50);
+    std::set<t_tuple> ref;
+    t_set set;
+    for (std::size_t i = 0; i < 20000; ++i) {
+        t_tuple key{dist(rnd), dist(rnd), dist(rnd)};
+        EXPECT_EQ(ref.insert(key).second, set.insert(key));
+        if (i % 5000 == 0) {
+            set.compact();
+        }
+    }
+    EXPECT_EQ(ref.size(), set.size());
+    EXPECT_EQ(std::vector<t_tuple>(ref.begin(), ref.end()), std::vector<t_tuple>(set.begin(), set.end()));
+
+    t_set::operation_hints hints;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        t_tuple key{dist(rnd), dist(rnd), dist(rnd)};
+        auto lower = set.lower_bound(key, hints);
+        auto upper = set.upper_bound(key, hints);
+        EXPECT_EQ(ref.count(key) > 0, set.contains(key, hints));
+        EXPECT_EQ(ref.lower_bound(key) == ref.end(), lower == set.end());
+        if (lower != set.end()) {
+            EXPECT_EQ(*ref.lower_bound(key), *lower);
+        }
+        EXPECT_EQ(ref.upper_bound(key) == ref.end(), upper == set.end());
+        if (upper != set.end()) {
+            EXPECT_EQ(*ref.upper_bound(key), *upper);
+        }
+    }
+
+    // the partition covers all tuples in order
+    std::vector<t_tuple> parts;
+    for (const auto& chunk : set.partition(7)) {
+        parts.insert(parts.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(std::vector<t_tuple>(ref.begin(), ref.end()), parts);
+}
+
+TEST(CompressedSet, ParallelInsert) {
+    const RamDomain n = 200000;
+    t_set set;
+#pragma omp parallel for
+    for (RamDomain i = 0; i < n; ++i) {
+        set.insert({i % 1000, i / 1000, i % 7});
+        set.insert({i % 1000, i / 1000, i % 7});
+    }
+    EXPECT_EQ(n, set.size());
+
+    // the leaves take most tuples, and encode each of them in a few bytes
+    EXPECT_LT(set.getCompressedBytes(), n * sizeof(t_tuple) / 2);
+
+    RamDomain count = 0;
+    t_tuple last{};
+    for (const auto& key : set) {
+        EXPECT_TRUE(count == 0 || last < key);
+        last = key;
+        ++count;
+    }
+    EXPECT_EQ(n, count);
+}
+
+}  // namespace souffle::test
@@ -0,0 +1,105 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file csv_io_test.cpp
+ *
+ * Tests the parallel reading of CSV fact files in chunks.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/RecordTableImpl.h"
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/ReadStreamCSV.h"
+#include <cstddef>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace souffle::test {
+
+/** A relation of two columns storing its tuples in insertion order */
+struct PairList {
+    void insert(const RamDomain* tuple) {
+        tuples.push_back({tuple[0], tuple[1]});
+    }
+
+    std::vector<std::vector<RamDomain>> tuples;
+};
+
+static std::map<std::string, std::string> getOperation() {
+    const std::string relation = "{\"arity\": 2, \"types\": [\"i:number\", \"i:number\"]}";
+    return {{"IO", "file"}, {"name", "pairs"}, {"types", "{\"relation\": " + relation + "}"}};
+}
+
+/** Returns the text of the given number of lines, several windows of chunks long */
+static std::string getLines(std::size_t count, std::size_t brokenLine = 0) {
+    std::string text;
+    for (std::size_t line = 1; line <= count; ++line) {
+        text += (line == brokenLine ? "x" : std::to_string(line)) + "\t" + std::to_string(2 * line) + "\n";
+    }
+    return text;
+}
+
+// enough lines for two windows of chunks on two threads
+static const std::size_t numLines = 1000000;
+
+TEST(ReadStreamCSV, Chunks) {
+#ifdef _OPENMP
+    omp_set_num_threads(2);
+#endif
+    const std::string text = getLines(numLines);
+    EXPECT_LT(2 * ReadStreamCSV::chunksPerThread * ReadStreamCSV::minChunkSize, text.size());
+
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    std::istringstream input(text);
+    PairList loaded;
+    ReadStreamCSV(input, getOperation(), symbols, records).readAll(loaded);
+
+    EXPECT_EQ(numLines, loaded.tuples.size());
+    bool ordered = true;
+    for (std::size_t i = 0; i < loaded.tuples.size(); ++i) {
+        const RamDomain line = static_cast<RamDomain>(i + 1);
+        ordered = ordered && loaded.tuples[i] == std::vector<RamDomain>{line, 2 * line};
+    }
+    EXPECT_TRUE(ordered);
+}
+
+TEST(ReadStreamCSV, ChunkErrors) {
+#ifdef _OPENMP
+    omp_set_num_threads(2);
+#endif
+    // the first of several erroneous lines is reported, with its number counted across chunks
+    std::string text = getLines(numLines, 900000);
+    text.replace(text.find("\n950000\t") + 1, 6, "950x00");
+
+    SymbolTableImpl symbols;
+    SpecializedRecordTable<0> records;
+    std::istringstream input(text);
+    PairList loaded;
+    std::string error;
+    try {
+        ReadStreamCSV(input, getOperation(), symbols, records).readAll(loaded);
+    } catch (const std::invalid_argument& e) {
+        error = e.what();
+    }
+    EXPECT_EQ("Error converting <x> in column 1 in line 900000; ", error);
+}
+
+}  // namespace souffle::test
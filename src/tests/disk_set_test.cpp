@@ -0,0 +1,138 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file disk_set_test.cpp
+ *
+ * A test case testing the set spilling to disk.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/DiskSet.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <array>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using t_tuple = std::array<RamDomain, 2>;
+using t_set = DiskSet<t_tuple>;
+
+TEST(DiskSet, Basic) {
+    t_set set;
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(set.begin(), set.end());
+
+    EXPECT_TRUE(set.insert({1, 2}));
+    EXPECT_TRUE(set.insert({1, -2}));
+    EXPECT_FALSE(set.insert({1, 2}));
+    EXPECT_EQ(2, set.size());
+
+    set.spill();
+    EXPECT_EQ(1, set.getRunCount());
+    EXPECT_FALSE(set.insert({1, 2}));
+    EXPECT_TRUE(set.insert({0, 0}));
+    EXPECT_EQ(3, set.size());
+
+    EXPECT_TRUE(set.contains({1, 2}));
+    EXPECT_TRUE(set.contains({0, 0}));
+    EXPECT_FALSE(set.contains({1, 3}));
+
+    std::vector<t_tuple> all(set.begin(), set.end());
+    EXPECT_EQ((std::vector<t_tuple>{{0, 0}, {1, -2}, {1, 2}}), all);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_EQ(0, set.getRunCount());
+    EXPECT_FALSE(set.contains({1, 2}));
+    EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(DiskSet, Bounds) {
+    std::mt19937 rnd(7);
+    std::uniform_int_distribution<RamDomain> dist(-100, 100);
+    std::set<t_tuple> ref;
+    t_set set;
+    for (std::size_t i = 0; i < 20000; ++i) {
+        t_tuple key{dist(rnd), dist(rnd)};
+        EXPECT_EQ(ref.insert(key).second, set.insert(key));
+        if (i % 1000 == 0) {
+            set.spill();
+        }
+    }
+    // runs of similar sizes are merged
+    EXPECT_LT(set.getRunCount(), 10);
+    EXPECT_EQ(ref.size(), set.size());
+    EXPECT_EQ(std::vector<t_tuple>(ref.begin(), ref.end()), std::vector<t_tuple>(set.begin(), set.end()));
+
+    t_set::operation_hints hints;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        t_tuple key{dist(rnd), dist(rnd)};
+        auto lower = set.lower_bound(key, hints);
+        auto upper = set.upper_bound(key, hints);
+        EXPECT_EQ(ref.count(key) > 0, set.contains(key, hints));
+        EXPECT_EQ(ref.lower_bound(key) == ref.end(), lower == set.end());
+        if (lower != set.end()) {
+            EXPECT_EQ(*ref.lower_bound(key), *lower);
+        }
+        EXPECT_EQ(ref.upper_bound(key) == ref.end(), upper == set.end());
+        if (upper != set.end()) {
+            EXPECT_EQ(*ref.upper_bound(key), *upper);
+        }
+    }
+
+    // the partition covers all tuples in order
+    std::vector<t_tuple> parts;
+    for (const auto& chunk : set.partition(7)) {
+        parts.insert(parts.end(), chunk.begin(), chunk.end());
+    }
+    EXPECT_EQ(std::vector<t_tuple>(ref.begin(), ref.end()), parts);
+}
+
+TEST(DiskSet, BudgetOverhead) {
+    t_set set;
+    // the budget covers the nodes of the in-memory B-tree, not only the tuples
+    set.setMemoryBudget(4096 * sizeof(t_tuple));
+    for (RamDomain i = 0; i < 3072; ++i) {
+        set.insert({i, i});
+    }
+    EXPECT_EQ(3072, set.size());
+    EXPECT_LT(0, set.getRunCount());
+}
+
+TEST(DiskSet, ParallelInsert) {
+    const RamDomain n = 100000;
+    t_set set;
+    // keep at most 4096 tuples in memory
+    set.setMemoryBudget(4096 * sizeof(t_tuple));
+#pragma omp parallel for
+    for (RamDomain i = 0; i < n; ++i) {
+        set.insert({i % 1000, i / 1000});
+        set.insert({i % 1000, i / 1000});
+    }
+    EXPECT_EQ(n, set.size());
+    EXPECT_LT(0, set.getRunCount());
+
+    RamDomain count = 0;
+    t_tuple last{};
+    for (const auto& key : set) {
+        EXPECT_TRUE(count == 0 || last < key);
+        last = key;
+        ++count;
+    }
+    EXPECT_EQ(n, count);
+}
+
+}  // namespace souffle::test
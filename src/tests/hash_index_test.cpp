@@ -0,0 +1,121 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file hash_index_test.cpp
+ *
+ * A test case testing the hash index implementation.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/RamTypes.h"
+#include "souffle/datastructure/HashIndex.h"
+#include "souffle/utility/ParallelUtil.h"
+#include <array>
+#include <cstddef>
+#include <set>
+#include <vector>
+
+namespace souffle::test {
+
+using t_tuple = std::array<RamDomain, 2>;
+
+TEST(HashIndex, Set) {
+    HashIndex<t_tuple, true, 0, 1> set;
+    EXPECT_TRUE(set.empty());
+
+    EXPECT_TRUE(set.insert({1, 2}));
+    EXPECT_TRUE(set.insert({2, 1}));
+    EXPECT_FALSE(set.insert({1, 2}));
+    EXPECT_EQ(2, set.size());
+
+    EXPECT_TRUE(set.contains({1, 2}));
+    EXPECT_TRUE(set.contains({2, 1}));
+    EXPECT_FALSE(set.contains({1, 1}));
+
+    std::set<t_tuple> all(set.begin(), set.end());
+    EXPECT_EQ((std::set<t_tuple>{{1, 2}, {2, 1}}), all);
+
+    set.clear();
+    EXPECT_TRUE(set.empty());
+    EXPECT_FALSE(set.contains({1, 2}));
+    EXPECT_EQ(set.begin(), set.end());
+}
+
+TEST(HashIndex, Lookup) {
+    HashIndex<t_tuple, false, 1> index;
+    for (RamDomain i = 0; i < 1000; ++i) {
+        index.insert({i, i % 10});
+    }
+    EXPECT_EQ(1000, index.size());
+
+    for (RamDomain key = 0; key < 10; ++key) {
+        std::set<RamDomain> found;
+        for (const auto& tuple : index.equalRange({0, key})) {
+            EXPECT_EQ(key, tuple[1]);
+            found.insert(tuple[0]);
+        }
+        EXPECT_EQ(100, found.size());
+    }
+    EXPECT_TRUE(index.equalRange({0, 10}).empty());
+    EXPECT_FALSE(index.contains({0, 10}));
+}
+
+TEST(HashIndex, Partition) {
+    HashIndex<t_tuple, true, 0, 1> set;
+    for (RamDomain i = 0; i < 10000; ++i) {
+        set.insert({i, -i});
+    }
+
+    std::size_t count = 0;
+    std::set<t_tuple> all;
+    for (const auto& chunk : set.partition(100)) {
+        for (const auto& tuple : chunk) {
+            all.insert(tuple);
+            ++count;
+        }
+    }
+    EXPECT_EQ(10000, count);
+    EXPECT_EQ(10000, all.size());
+}
+
+TEST(HashIndex, ParallelInsert) {
+    HashIndex<t_tuple, true, 0, 1> set;
+    HashIndex<t_tuple, false, 0> index;
+
+    // every tuple is inserted twice into the set
+    std::vector<RamDomain> values(20000);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        values[i] = static_cast<RamDomain>(i / 2);
+    }
+
+    PARALLEL_START
+        pfor(std::size_t i = 0; i < values.size(); ++i) {
+            t_tuple tuple = {values[i] % 100, values[i]};
+            if (set.insert(tuple)) {
+                index.insert(tuple);
+            }
+        }
+    PARALLEL_END
+
+    EXPECT_EQ(10000, set.size());
+    EXPECT_EQ(10000, index.size());
+    for (RamDomain key = 0; key < 100; ++key) {
+        std::size_t count = 0;
+        for (const auto& tuple : index.equalRange({key, 0})) {
+            EXPECT_EQ(key, tuple[0]);
+            ++count;
+        }
+        EXPECT_EQ(100, count);
+    }
+}
+
+}  // namespace souffle::test
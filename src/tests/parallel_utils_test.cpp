@@ -17,7 +17,10 @@
 #include "tests/test.h"
 
 #include "souffle/utility/ParallelUtil.h"
+#include <atomic>
+#include <cstddef>
 #include <string>
+#include <vector>
 
 namespace souffle {
 
@@ -99,5 +102,35 @@ TEST(ParallelUtils, OptimisticReadWriteLock) {
 
     EXPECT_EQ(2 * (N / K), c);
 }
+
+TEST(ParallelUtils, TaskGraph) {
+    // a diamond followed by a chain and a set of independent tasks
+    std::vector<std::vector<std::size_t>> preds = {{}, {0}, {0}, {1, 2}, {3}, {}, {}, {5, 6}};
+    const std::size_t N = preds.size();
+
+    std::atomic<std::size_t> clock{0};
+    std::vector<std::size_t> started(N);
+    std::vector<std::size_t> finished(N);
+
+    runTaskGraph(preds, [&](std::size_t i) {
+        started[i] = clock++;
+        // allow a nested parallel region inside of a task
+        std::atomic<int> sum{0};
+        PARALLEL_START
+            pfor(int j = 0; j < 100; ++j) {
+                sum += j;
+            }
+        PARALLEL_END
+        EXPECT_EQ(4950, sum);
+        finished[i] = clock++;
+    });
+
+    EXPECT_EQ(2 * N, clock);
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t pred : preds[i]) {
+            EXPECT_LT(finished[pred], started[i]);
+        }
+    }
+}
 }  // namespace test
 }  // end namespace souffle
@@ -29,6 +29,10 @@
 
 #include <cstddef>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace souffle::test {
 
 #define NUMBER_OF_TESTS 100
@@ -70,6 +74,26 @@ TEST(Pack, InitListHelper) {
     EXPECT_EQ(3, ptr[2]);
 }
 
+TEST(Pack, Concurrent) {
+    SpecializedRecordTable<2> recordTable;
+    const int size = 10000;
+    std::vector<RamDomain> refs(size);
+#ifdef _OPENMP
+    recordTable.setNumLanes(omp_get_max_threads());
+#pragma omp parallel for
+#endif
+    for (int i = 0; i < size; ++i) {
+        // maps of new arities are created while others are in use
+        const std::size_t arity = 2 + i % 5;
+        std::vector<RamDomain> record(arity, i % 100);
+        refs[i] = recordTable.pack(record.data(), arity);
+        EXPECT_EQ(i % 100, recordTable.unpack(refs[i], arity)[0]);
+    }
+    for (int i = 0; i < size; ++i) {
+        EXPECT_EQ(refs[i], refs[i % 500]);
+    }
+}
+
 // Generate random tuples
 // pack them all
 // unpack and test for equality
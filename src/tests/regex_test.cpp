@@ -0,0 +1,105 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file regex_test.cpp
+ *
+ * Tests the linear-time regular expression matcher against std::regex.
+ *
+ ***********************************************************************/
+
+#include "tests/test.h"
+
+#include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/utility/RegexUtil.h"
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace souffle::test {
+
+namespace {
+const std::vector<std::string> texts = {"", "a", "b", "ab", "aa", "aaa", "abc", "abcabc", "abab", "ba",
+        "hello world", "hello_world", "x1", "1x", "123", "a.b", "a\nb", "a-b", "foo.bar", "[x]", "a|b",
+        "aaaaaaaaaaaaaaaaaaaaaaaaaaaaab", "\t ", "ABC", "a{2}", "*"};
+}
+
+TEST(Regex, Automaton) {
+    const std::vector<std::string> patterns = {"", "a", "ab", "a|b", "a*", "a+", "a?", "(ab)*", "(?:ab)+",
+            "a{2}", "a{2,}", "a{1,3}", "a{0,2}b", ".*", ".+", "a.b", "[abc]+", "[^a]*", "[a-c]*", "[0-9]+",
+            "\\d+", "\\D*", "\\w+", "\\W", "\\s+", "\\S+", "[\\w.]+", "[\\d\\s]+", "\\.", "a\\.b", "\\*",
+            "\\[x\\]", "a\\|b", "^abc$", "^a|b$", "a$|^b", "\\bhello\\b.*", ".*\\Bllo.*", "(a|ab)(c|bcd)",
+            "(a*)*b", "(a|aa)*b", "((a)|b)+", "x?1?x?", "()", "(|a)b", "[.]*", "[*+?]", "[a\\-b]+",
+            "hello world", ".*o w.*", "[A-Z]+", "a*?", "a+?b", "a{1,2}?", "a\\nb", "a.*", "(.)*c"};
+    for (const auto& pattern : patterns) {
+        Regex regex(pattern);
+        EXPECT_TRUE(regex.isAutomaton()) << pattern;
+        std::regex reference(pattern);
+        for (const auto& text : texts) {
+            EXPECT_EQ(std::regex_match(text, reference), regex.match(text)) << pattern << " " << text;
+        }
+    }
+}
+
+TEST(Regex, Fallback) {
+    // back-references and look-aheads are not regular
+    const std::vector<std::string> patterns = {"(a)\\1", "(?=a)a", "(?!b).*", "[[:alpha:]]+", "[-a]+"};
+    for (const auto& pattern : patterns) {
+        Regex regex(pattern);
+        EXPECT_FALSE(regex.isAutomaton()) << pattern;
+        std::regex reference(pattern);
+        for (const auto& text : texts) {
+            EXPECT_EQ(std::regex_match(text, reference), regex.match(text)) << pattern << " " << text;
+        }
+    }
+}
+
+TEST(Regex, Malformed) {
+    const std::vector<std::string> patterns = {"(", "a)", "*", "a{2,1}", "[a", "a\\"};
+    for (const auto& pattern : patterns) {
+        bool thrown = false;
+        try {
+            Regex regex(pattern);
+        } catch (const std::regex_error&) {
+            thrown = true;
+        }
+        EXPECT_TRUE(thrown) << pattern;
+    }
+}
+
+TEST(Regex, Linear) {
+    // exponential for backtracking matchers
+    Regex regex("(a|aa)*(a|aa)*(a|aa)*c");
+    EXPECT_TRUE(regex.isAutomaton());
+    EXPECT_FALSE(regex.match(std::string(10000, 'a')));
+    EXPECT_TRUE(regex.match(std::string(10000, 'a') + "c"));
+}
+
+TEST(Regex, Memo) {
+    SymbolTableImpl symbolTable;
+    RegexMatcher matcher("a.*", 4);
+    std::vector<RamDomain> symbols;
+    for (const auto& text : texts) {
+        symbols.push_back(symbolTable.encode(text));
+    }
+    // repeat to exercise memoised results and evictions
+    for (int round = 0; round < 3; ++round) {
+        for (std::size_t i = 0; i < texts.size(); ++i) {
+            EXPECT_EQ(matcher.match(texts[i]), matcher.match(symbols[i], symbolTable)) << texts[i];
+        }
+    }
+
+    // copies do not share memoised results
+    RegexMatcher copy(matcher);
+    for (std::size_t i = 0; i < texts.size(); ++i) {
+        EXPECT_EQ(matcher.match(texts[i]), copy.match(symbols[i], symbolTable)) << texts[i];
+    }
+}
+
+}  // namespace souffle::test
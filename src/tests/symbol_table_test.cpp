@@ -18,12 +18,17 @@
 
 #include "souffle/SymbolTable.h"
 #include "souffle/datastructure/SymbolTableImpl.h"
+#include "souffle/io/SymbolSnapshot.h"
 #include "souffle/utility/MiscUtil.h"
 #include <algorithm>
 #include <cstddef>
+#include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #ifdef _OPENMP
@@ -111,4 +116,80 @@ TEST(SymbolTable, Inserts) {
     }
 }
 
+TEST(SymbolTable, BatchEncode) {
+    SymbolTableImpl X{"b"};
+    const std::string text = "abcab";
+    std::vector<std::string_view> symbols;
+    for (std::size_t i = 0; i < text.size(); ++i) {
+        symbols.push_back(std::string_view(text).substr(i, 1));
+    }
+    std::vector<RamDomain> indices(symbols.size());
+    X.encode(symbols, indices);
+    EXPECT_EQ(indices[0], indices[3]);
+    EXPECT_EQ(indices[1], indices[4]);
+    EXPECT_EQ(X.encode("b"), indices[1]);
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        EXPECT_EQ(X.decode(indices[i]), symbols[i]);
+    }
+}
+
+TEST(SymbolTable, DecodeWhileGrowing) {
+    // decoding does not enter a lane, the symbols stay in place as the table grows
+    SymbolTableImpl X{"first"};
+    const RamDomain first = X.encode("first");
+    const int size = 10000;
+#ifdef _OPENMP
+    X.setNumLanes(omp_get_max_threads());
+#pragma omp parallel for
+#endif
+    for (int j = 0; j < size; ++j) {
+        const std::string symbol = std::to_string(j);
+        const RamDomain index = X.encode(symbol);
+        EXPECT_EQ(X.decode(index), symbol);
+        EXPECT_EQ(X.decode(first), "first");
+    }
+    EXPECT_EQ(X.decode(X.encode("9999")), "9999");
+}
+
+TEST(SymbolTable, Snapshot) {
+    const std::string fileName = "./symbol_table_test_snapshot.symbols";
+    SymbolTableImpl first;
+    for (int i = 0; i < 1000; ++i) {
+        first.encode("symbol " + std::to_string(i * 7 % 1000));
+    }
+    saveSymbolSnapshot(first, fileName);
+
+    // a later run restores the numbers and extends the table
+    SymbolTableImpl second;
+    loadSymbolSnapshot(second, fileName);
+    for (const auto& [symbol, index] : first) {
+        EXPECT_EQ(second.encode(symbol), static_cast<RamDomain>(index));
+    }
+    const RamDomain added = second.encode("added");
+    EXPECT_EQ(added, 1000);
+    saveSymbolSnapshot(second, fileName);
+
+    SymbolTableImpl third{"symbol 0", "symbol 7"};
+    loadSymbolSnapshot(third, fileName);
+    EXPECT_EQ(third.encode("added"), added);
+
+    // the table must not contain other symbols before those of the snapshot
+    SymbolTableImpl other{"other"};
+    bool failed = false;
+    try {
+        loadSymbolSnapshot(other, fileName);
+    } catch (const std::invalid_argument&) {
+        failed = true;
+    }
+    EXPECT_TRUE(failed);
+
+    // saving leaves no temporary file behind
+    std::size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(".")) {
+        files += entry.path().filename().string().rfind("symbol_table_test_snapshot", 0) == 0;
+    }
+    EXPECT_EQ(files, 1);
+    std::remove(fileName.c_str());
+}
+
 }  // namespace souffle::test
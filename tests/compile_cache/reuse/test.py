@@ -0,0 +1,83 @@
+import argparse
+import os
+import shutil
+import subprocess
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--input_dir")
+    parser.add_argument("--output_dir")
+    parser.add_argument("--souffle")
+    parser.add_argument("dl")
+
+    args = parser.parse_args()
+    souffle = args.souffle
+    output_dir = args.output_dir
+    cache_dir = os.path.join(output_dir, "cache")
+
+    os.chdir(args.input_dir)
+
+    if os.path.exists(output_dir):
+        shutil.rmtree(output_dir)
+    os.mkdir(output_dir)
+    shutil.copy(args.dl, output_dir)
+
+    os.chdir(output_dir)
+
+    def check(condition, message):
+        if not condition:
+            sys.stderr.write("Error: {}\n".format(message))
+            sys.exit(1)
+
+    # runs Souffle through the cache and returns the number of reused objects
+    def run(mode, dl):
+        status = subprocess.run(
+            [souffle, mode, "-v", "--compile-cache=" + cache_dir, "-D", ".", dl],
+            capture_output=True,
+            text=True,
+        )
+        sys.stdout.write(status.stdout)
+        sys.stderr.write(status.stderr)
+        check(status.returncode == 0, "souffle {} {} failed".format(mode, dl))
+        return status.stderr.count("Reusing cached object")
+
+    def cached_objects():
+        return set(os.listdir(cache_dir))
+
+    def paths():
+        with open("path.csv") as csv:
+            return len(csv.readlines())
+
+    # miss: the first build fills the cache
+    check(run("-c", args.dl) == 0, "an object was reused from an empty cache")
+    objects = cached_objects()
+    check(len(objects) == 1, "expected one cached object, found {}".format(len(objects)))
+    check(paths() == 6, "wrong number of paths")
+
+    # hit: an identical build reuses the object
+    check(run("-c", args.dl) == 1, "the cached object was not reused")
+    check(cached_objects() == objects, "an identical build added objects to the cache")
+    check(paths() == 6, "wrong number of paths")
+
+    # invalidation: a changed program is compiled again
+    with open(args.dl) as source:
+        program = source.read()
+    with open("changed.dl", "w") as changed:
+        changed.write(program.replace("edge(3, 4).", "edge(3, 4).\nedge(4, 5)."))
+    check(run("-c", "changed.dl") == 0, "an object of another program was reused")
+    check(len(cached_objects()) == 2, "the changed program was not added to the cache")
+    check(paths() == 10, "wrong number of paths")
+
+    # hit per translation unit: every unit of a multi-file build is reused
+    objects = cached_objects()
+    check(run("-C", args.dl) == 0, "an object of a single-file build was reused")
+    units = len(cached_objects() - objects)
+    check(units > 1, "the multi-file build did not add its translation units to the cache")
+    check(run("-C", args.dl) == units, "not every translation unit was reused")
+    check(paths() == 6, "wrong number of paths")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,83 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program for updating a Souffle program incrementally, whose
+ * relation has both input facts and rules
+ *
+ ***********************************************************************/
+
+#include "souffle/SouffleInterface.h"
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+/**
+ * Stage edges in the given staging relation
+ */
+void stage(Relation* rel, const std::vector<std::array<RamSigned, 2>>& edges) {
+    if (rel == nullptr) {
+        error("cannot find staging relation");
+    }
+    for (const auto& edge : edges) {
+        tuple t(rel);
+        t << edge[0] << edge[1];
+        rel->insert(t);
+    }
+}
+
+/**
+ * Main program
+ */
+int main(int argc, char** argv) {
+    // check number of arguments
+    if (argc != 2) {
+        error("wrong number of arguments!");
+    }
+
+    // create instance of program "incremental_input_facts"
+    if (SouffleProgram* prog = ProgramFactory::newInstance("incremental_input_facts")) {
+        // load all input relations and evaluate from scratch
+        prog->loadAll(argv[1]);
+        prog->run();
+        std::cout << "path " << prog->getRelation("path")->size() << std::endl;
+
+        // path(1,2) loses its derivation, but remains an input fact and keeps deriving path(1,3)
+        stage(prog->getErasures("edge"), {{1, 2}});
+        prog->update();
+        std::cout << "path " << prog->getRelation("path")->size() << std::endl;
+
+        // once the input fact is erased as well, nothing derives path(1,2) and path(1,3)
+        stage(prog->getErasures("path"), {{1, 2}});
+        prog->update();
+        std::cout << "path " << prog->getRelation("path")->size() << std::endl;
+
+        // print all relations to CSV files in current directory
+        prog->printAll();
+
+        // free program
+        delete prog;
+
+    } else {
+        error("cannot find program incremental_input_facts");
+    }
+}
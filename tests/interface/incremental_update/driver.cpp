@@ -0,0 +1,93 @@
+/*
+ * Souffle - A Datalog Compiler
+ * Copyright (c) 2026, The Souffle Developers. All rights reserved
+ * Licensed under the Universal Permissive License v 1.0 as shown at:
+ * - https://opensource.org/licenses/UPL
+ * - <souffle root>/licenses/SOUFFLE-UPL.txt
+ */
+
+/************************************************************************
+ *
+ * @file driver.cpp
+ *
+ * Driver program for updating a Souffle program incrementally using the
+ * OO-interface
+ *
+ ***********************************************************************/
+
+#include "souffle/SouffleInterface.h"
+#include <array>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace souffle;
+
+/**
+ * Error handler
+ */
+void error(std::string txt) {
+    std::cerr << "error: " << txt << "\n";
+    exit(1);
+}
+
+/**
+ * Stage edges in the given staging relation
+ */
+void stage(Relation* rel, const std::vector<std::array<std::string, 2>>& edges) {
+    if (rel == nullptr) {
+        error("cannot find staging relation");
+    }
+    for (const auto& edge : edges) {
+        tuple t(rel);
+        t << edge[0] << edge[1];
+        rel->insert(t);
+    }
+}
+
+/**
+ * Print the sizes of the derived relations
+ */
+void printSizes(SouffleProgram* prog) {
+    std::cout << "path " << prog->getRelation("path")->size() << " reach "
+              << prog->getRelation("reach")->size() << std::endl;
+}
+
+/**
+ * Main program
+ */
+int main(int argc, char** argv) {
+    // check number of arguments
+    if (argc != 2) {
+        error("wrong number of arguments!");
+    }
+
+    // create instance of program "incremental_update"
+    if (SouffleProgram* prog = ProgramFactory::newInstance("incremental_update")) {
+        // load all input relations and evaluate from scratch
+        prog->loadAll(argv[1]);
+        prog->run();
+        printSizes(prog);
+
+        // break the cycle and attach a new node
+        stage(prog->getErasures("edge"), {{"B", "C"}});
+        stage(prog->getInsertions("edge"), {{"D", "E"}});
+        prog->update();
+        printSizes(prog);
+
+        // restore the cycle and detach the last node
+        stage(prog->getInsertions("edge"), {{"B", "C"}});
+        stage(prog->getErasures("edge"), {{"E", "F"}});
+        prog->update();
+        printSizes(prog);
+
+        // print all relations to CSV files in current directory
+        prog->printAll();
+
+        // free program
+        delete prog;
+
+    } else {
+        error("cannot find program incremental_update");
+    }
+}